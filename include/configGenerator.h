@@ -23,7 +23,9 @@
 
 #include "helperFunctions.h"
 
+#include <cstdint>
 #include <map>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -40,28 +42,278 @@ private:
     private:
         string m_option;
         string m_prefix;
-        string m_value;
         bool m_lock;
 
-        ConfigPair(string option, string prefix, string value)
+        ConfigPair(string option, string prefix)
             : m_option(std::move(option))
             , m_prefix(std::move(prefix))
-            , m_value(std::move(value))
             , m_lock(false)
         {}
     };
 
+    class FixedPair
+    {
+        friend class ConfigGenerator;
+        friend class ProjectGenerator;
+
+    private:
+        string m_option;
+        string m_value;
+
+        FixedPair(string option, string value)
+            : m_option(std::move(option))
+            , m_value(std::move(value))
+        {}
+    };
+
+    /** A dense set of bits indexed by config option ID. */
+    class OptionBits
+    {
+    public:
+        void resize(const size_t size)
+        {
+            m_bits.resize((size + 63) / 64, 0);
+            m_size = size;
+        }
+
+        bool test(const size_t id) const
+        {
+            return ((m_bits[id / 64] >> (id % 64)) & 1) != 0;
+        }
+
+        void set(const size_t id, const bool value = true)
+        {
+            const uint64_t bit = uint64_t(1) << (id % 64);
+            m_bits[id / 64] = (value) ? (m_bits[id / 64] | bit) : (m_bits[id / 64] & ~bit);
+        }
+
+        /** Sets every bit that is set in other. */
+        void merge(const OptionBits& other)
+        {
+            for (size_t i = 0; i < other.m_bits.size(); ++i) {
+                m_bits[i] |= other.m_bits[i];
+            }
+        }
+
+        /** Clears every bit that is set in other. */
+        void remove(const OptionBits& other)
+        {
+            for (size_t i = 0; i < other.m_bits.size(); ++i) {
+                m_bits[i] &= ~other.m_bits[i];
+            }
+        }
+
+        /** Sets every bit in the set. */
+        void fill()
+        {
+            for (auto& i : m_bits) {
+                i = ~uint64_t(0);
+            }
+            // Bits past the end must stay cleared so that any later added IDs start unset
+            if ((m_size % 64) != 0) {
+                m_bits.back() = (uint64_t(1) << (m_size % 64)) - 1;
+            }
+        }
+
+        /** Gets the ID of the first bit that is set in both this and other, string::npos if there is none. */
+        size_t findCommon(const OptionBits& other) const
+        {
+            const size_t words = (m_bits.size() < other.m_bits.size()) ? m_bits.size() : other.m_bits.size();
+            for (size_t i = 0; i < words; ++i) {
+                uint64_t common = m_bits[i] & other.m_bits[i];
+                if (common != 0) {
+                    size_t bit = 0;
+                    while ((common & 1) == 0) {
+                        common >>= 1;
+                        ++bit;
+                    }
+                    return i * 64 + bit;
+                }
+            }
+            return string::npos;
+        }
+
+        /** Gets the ID of the first bit at or after start that is set, string::npos if there is none. */
+        size_t findNext(const size_t start) const
+        {
+            for (size_t i = start / 64; i < m_bits.size(); ++i) {
+                uint64_t bits = m_bits[i];
+                if (i == start / 64) {
+                    bits &= ~uint64_t(0) << (start % 64);
+                }
+                if (bits != 0) {
+                    size_t bit = 0;
+                    while ((bits & 1) == 0) {
+                        bits >>= 1;
+                        ++bit;
+                    }
+                    return i * 64 + bit;
+                }
+            }
+            return string::npos;
+        }
+
+    private:
+        vector<uint64_t> m_bits;
+        size_t m_size = 0;
+    };
+
+    struct DependencyRef
+    {
+        string name;         // The dependency name as found in configure
+        size_t id;           // The ID of the dependency option, string::npos if it is not a config option
+        bool toggle = false; // True if the dependency is negated (i.e. !name)
+
+        DependencyRef(string iname, size_t iid, bool itoggle)
+            : name(std::move(iname))
+            , id(iid)
+            , toggle(itoggle)
+        {}
+    };
+
+    struct DependencyNode
+    {
+        vector<DependencyRef> ifAny;    // _if_any and _COMPONENTS, enabled if any of these
+        vector<DependencyRef> ifAll;    // _if, enabled if all of these
+        vector<DependencyRef> deps;     // _deps, disabled if any of these are not enabled
+        vector<DependencyRef> depsAny;  // _deps_any, disabled if none of these are enabled
+        vector<DependencyRef> conflict; // _conflict, disabled if any of these are enabled
+        vector<DependencyRef> select;   // _select, disabled if any of these are disabled
+        bool hasIfAll = false;
+        bool hasDepsAny = false;
+        vector<size_t> dependencies; // IDs of options this option depends on
+        vector<size_t> dependents;   // IDs of options that depend on this option
+    };
+
+    struct AdditionalDependency
+    {
+        bool enabled = false; // The dependencies value
+        size_t id;            // If valid then the value is taken from this config option ID instead
+
+        AdditionalDependency(bool ienabled, size_t iid)
+            : enabled(ienabled)
+            , id(iid)
+        {}
+    };
+
+    struct ForcedToggle
+    {
+        string option;     // The option to toggle
+        bool fast = false; // True to toggle without processing any further dependencies
+
+        ForcedToggle(string ioption, bool ifast = false)
+            : option(std::move(ioption))
+            , fast(ifast)
+        {}
+    };
+
+    struct ToggleChild
+    {
+        string option;            // The option to toggle
+        bool enable = false;      // True to enable, false to disable
+        bool weak = false;        // True to only change the value if it is not already set
+        bool inheritWeak = false; // True to use the weak setting of the toggle that caused this one instead
+        bool fast = false;        // True to toggle without processing any further dependencies
+
+        ToggleChild(string ioption, bool ienable, bool iweak, bool iinheritWeak, bool ifast = false)
+            : option(std::move(ioption))
+            , enable(ienable)
+            , weak(iweak)
+            , inheritWeak(iinheritWeak)
+            , fast(ifast)
+        {}
+    };
+
+    struct ToggleFrame
+    {
+        string option;                                 // The option being toggled (in lower case)
+        bool enable = false;                           // True to enable, false to disable
+        bool weak = false;                             // True to only change the value if it is not already set
+        bool deep = false;                             // True to also enable _select and _suggest dependencies
+        vector<size_t> ids;                            // The IDs of the option (one for each prefix)
+        size_t currentID = 0;                          // Index into ids of the ID currently being toggled
+        const vector<ToggleChild>* children = nullptr; // The toggles for the current ID, nullptr if not yet started
+        size_t currentChild = 0;                       // Index into children of the next toggle to process
+
+        ToggleFrame(string ioption, bool ienable, bool iweak, bool ideep, vector<size_t> iids)
+            : option(std::move(ioption))
+            , enable(ienable)
+            , weak(iweak)
+            , deep(ideep)
+            , ids(std::move(iids))
+        {}
+    };
+
+    struct ToggleTrace
+    {
+        size_t expansions = 0;  // Number of option values toggled
+        size_t listLookups = 0; // Number of configure lists looked up to find dependent toggles
+        size_t maxDepth = 0;    // Maximum number of nested toggles
+    };
+
+    struct ComponentExtern
+    {
+        string type;          // The declared type (i.e. FFCodec, AVFilter etc.)
+        string name;          // The declared variable name with the 'ff_' prefix removed
+        bool isConst = false; // True if the declaration is const
+
+        ComponentExtern(string itype, string iname, bool iisConst)
+            : type(std::move(itype))
+            , name(std::move(iname))
+            , isConst(iisConst)
+        {}
+    };
+
+    struct ComponentSource
+    {
+        MappedFile mapping;              // The sources file contents
+        vector<ComponentExtern> externs; // Each 'extern ... ff_*' declaration found in the source in file order
+    };
+
+    struct FoundThings
+    {
+        vector<string> list;    // The found configure defines
+        vector<string> externs; // The found extern declarations (only if requested)
+    };
+
     using ValuesList = vector<ConfigPair>;
+    using FixedValuesList = vector<FixedPair>;
     using DefaultValuesList = map<string, string>;
     using DependencyList = map<string, bool>;
     using ConfigList = map<string, vector<string>>;
     using InterDependencies = map<string, vector<pair<vector<string>, vector<string>>>>;
-
-    ValuesList m_fixedConfigValues;
+    using OptionIndex = unordered_map<string, vector<size_t>>;
+    using AssignmentIndex = unordered_map<string, vector<size_t>>;
+    using CachedConfigLists = unordered_map<size_t, vector<string>>;
+    using DependencyGraph = vector<DependencyNode>;
+    using AdditionalDependencyList = unordered_map<string, AdditionalDependency>;
+    using ForcedList = unordered_map<string, vector<ForcedToggle>>;
+    using ChangedValues = map<size_t, string>;
+    using AutoDetectList = vector<pair<string, bool>>;
+    using ToggleExpansions = unordered_map<string, vector<ToggleChild>>;
+    using ComponentRegistry = unordered_map<string, ComponentSource>;
+    using FoundThingsCache = unordered_map<string, FoundThings>;
+    using RelativePaths = unordered_map<string, string>;
+
+    FixedValuesList m_fixedConfigValues;
     ValuesList m_configValues;
-    uint m_configComponentsStart{0};
-    uint m_configValuesEnd{0};
-    string m_configureFile;
+    OptionBits m_configSet;            // Set for each option ID that has been given a value
+    OptionBits m_configEnabled;        // Set for each option ID that is enabled (implies it is also set)
+    OptionIndex m_optionIndex;         // Maps option name to its IDs (index into m_configValues)
+    OptionIndex m_optionIndexPrefixed; // Maps prefixed option name to its IDs
+    DependencyGraph m_dependencyGraph; // Dependency information for each option ID
+    vector<size_t> m_dependencyOrder;  // Option IDs ordered so that dependencies are checked before dependents
+    vector<size_t> m_dependencyRank;   // Position of each option ID within m_dependencyOrder
+    ChangedValues m_changedValues;     // Original value of each option that has been changed since last cleared
+    AdditionalDependencyList m_additionalDependencies;
+    ForcedList m_forcedEnables;
+    ForcedList m_forcedDisables;
+    AutoDetectList m_autoDetectLibs; // Detection result for each auto detected lib in configure order
+    size_t m_configComponentsStart{0};
+    size_t m_configValuesEnd{0};
+    MappedFile m_configureMapping;
+    string_view m_configureFile; // View of the mapped configure file contents
+    AssignmentIndex m_configureAssignments; // Maps configure variable names to the sorted offsets of each assignment
     bool m_isLibav{false};
     string m_projectName;
     string m_rootDirectory;
@@ -72,7 +324,16 @@ private:
     DefaultValuesList m_replaceList;
     DefaultValuesList m_replaceListASM;
     bool m_useNASM{true};
-    ConfigList m_cachedConfigLists;
+    ToggleExpansions m_toggleExpansions; // Maps an option and toggle type to the toggles it causes
+    ToggleTrace m_toggleTrace;           // Instrumentation for the current top level toggle
+    bool m_traceConfig{false};
+    // The following caches are filled by const lookups that may be called from multiple projects at once. Access to
+    // them is guarded by a lock so that the config can be shared read-only between threads.
+    mutable CachedConfigLists m_cachedConfigLists;  // Maps a lists assignment offset to its expanded contents
+    mutable ComponentRegistry m_componentRegistry;  // Maps a component source file to its parsed contents
+    mutable FoundThingsCache m_foundThings;         // Maps find_things parameters to their results
+    mutable RelativePaths m_projectRelativePaths;   // Maps a generator relative dir to its project relative path
+    mutable RelativePaths m_generatorRelativePaths; // Maps a project relative dir to its generator relative path
 
 public:
     /** Default constructor. */
@@ -86,22 +347,63 @@ public:
      */
     bool passConfig(int argc, char** argv);
 
+    /**
+     * Pass any early configuration options and the configure file.
+     * @remark The result can be copied and then used with passConfigValues to create multiple different
+     * configurations without needing to pass the configure file each time.
+     * @param options The list of input options.
+     * @return True if it succeeds, false if it fails.
+     */
+    bool passConfigure(const vector<string>& options);
+
+    /**
+     * Pass configuration options and resolve all config values.
+     * @remark Requires passConfigure to have been called first. Early options (e.g. --loud) are only applied by
+     * passConfigure and are otherwise ignored.
+     * @param options The list of input options.
+     * @return True if it succeeds, false if it fails.
+     */
+    bool passConfigValues(const vector<string>& options);
+
     /**
      * Outputs a new configurations files based on current internal settings.
      * @return True if it succeeds, false if it fails.
      */
     bool outputConfig();
 
-    /** Deletes any files that may have been previously created by outputConfig. */
-    void deleteCreatedFiles() const;
+    /**
+     * Deletes any files that may have been previously created by outputConfig.
+     * @param staleOnly (Optional) True to only delete files that were not output during the current run.
+     */
+    void deleteCreatedFiles(bool staleOnly = false) const;
 
 private:
+    /**
+     * Pass any input options that must be set before the configure file is passed.
+     * @param options The list of input options.
+     * @return True if it succeeds, false if it fails.
+     */
+    bool passEarlyConfig(const vector<string>& options);
+
     /**
      * Passes the configure file and loads all available options.
      * @return True if it succeeds, false if it fails.
      */
     bool passConfigureFile();
 
+    /**
+     * Indexes the start position of every variable assignment found in the loaded configure file.
+     */
+    void passConfigureAssignments();
+
+    /**
+     * Finds the closest definition of a configure variable at or before a position in the configure file.
+     * @param list           The variable name.
+     * @param currentFilePos (Optional) The current position in the configure file.
+     * @return The start position of the definition, string::npos if not found.
+     */
+    size_t findConfigListDefinition(const string& list, size_t currentFilePos = string::npos) const;
+
     /**
      * Passes an existing config.h file.
      * @return True if it succeeds, false if it fails.
@@ -115,6 +417,34 @@ private:
      */
     bool changeConfig(const string& option);
 
+    /**
+     * Adds an input option to the configuration string output in config.h.
+     * @param option The option to add.
+     */
+    void addConfigurationOption(const string& option);
+
+    /**
+     * Creates a key that identifies the resolved config values produced by the current input.
+     * @remark The key covers the snapshot version, the configure file, the normalised passed options that affect
+     * config values and the auto detected libs.
+     * @param options The list of input options.
+     * @return The key value.
+     */
+    uint64_t buildSnapshotKey(const vector<string>& options) const;
+
+    /**
+     * Loads previously resolved config values from a snapshot file.
+     * @param key The key that the snapshot must have been created with.
+     * @return True if a matching snapshot was found and loaded, false if not.
+     */
+    bool loadConfigSnapshot(uint64_t key);
+
+    /**
+     * Saves the current resolved config values to a snapshot file.
+     * @param key The key identifying the current input.
+     */
+    void saveConfigSnapshot(uint64_t key) const;
+
     /**
      * Checks current config values and performs validation of requirements.
      * @return True if it succeeds, false if it fails.
@@ -155,16 +485,18 @@ private:
 
     /**
      * Creates a list of additional config option dependencies that are not available as actual config options.
-     * @param [out] additionalDependencies The additional dependencies.
+     * @param [out] additionalDependencies The additional dependencies with a fixed value.
+     * @param [out] linkedDependencies     The additional dependencies that take their value from a config option.
+     * Format is <dependency, option>.
      */
-    void buildAdditionalDependencies(DependencyList& additionalDependencies) const;
+    void buildAdditionalDependencies(DependencyList& additionalDependencies, DefaultValuesList& linkedDependencies) const;
 
     /**
      * Creates a list of additional dependencies between config options (in addition to _deps lists).
      * @param [out] interDependencies The additional dependencies. Format is <libName, <pair<{required conditions},
      * {dependencies}>>>
      */
-    void buildInterDependencies(InterDependencies& interDependencies);
+    void buildInterDependencies(InterDependencies& interDependencies) const;
 
     /**
      * Creates a list of components that can be disabled based on the current configuration as better alternatives are
@@ -175,17 +507,37 @@ private:
 
     /**
      * Creates a list of config options that must be forced to be enabled if the specified option is enabled.
-     * @param          optionLower The enabled option (in lower case).
-     * @param [in,out] forceEnable The forced enable options.
+     * @param [out] forceEnable The forced enable options. Format is <optionLower, {options}>.
      */
-    void buildForcedEnables(const string& optionLower, vector<string>& forceEnable);
+    static void buildForcedEnables(ForcedList& forceEnable);
 
     /**
      * Creates a list of config options that must be forced to be disabled if the specified option is disabled.
-     * @param          optionLower  The disabled option (in lower case).
-     * @param [in,out] forceDisable The forced disable options.
+     * @param [out] forceDisable The forced disable options. Format is <optionLower, {options}>.
+     */
+    static void buildForcedDisables(ForcedList& forceDisable);
+
+    /**
+     * Builds the lookup tables for additional dependencies and forced enables/disables.
+     * @remark Must be called once all config options have been loaded. The tables do not change after this.
+     */
+    void buildDependencyTables();
+
+    /**
+     * Gets the value of an additional dependency.
+     * @param       name    The dependency name.
+     * @param [out] enabled The dependencies value.
+     * @return True if the dependency is a known additional dependency, false if not.
+     */
+    bool getAdditionalDependency(const string& name, bool& enabled) const;
+
+    /**
+     * Gets the list of config options that must be forced to be toggled along with an option.
+     * @param optionLower The option being toggled (in lower case).
+     * @param enable      True if the option is being enabled, false if being disabled.
+     * @return The list of forced options, nullptr if there are none.
      */
-    void buildForcedDisables(const string& optionLower, vector<string>& forceDisable);
+    const vector<ForcedToggle>* getForcedToggles(const string& optionLower, bool enable) const;
 
     /**
      * Creates a list of command line arguments that must be handled before all others.
@@ -193,10 +545,10 @@ private:
      */
     static void buildEarlyConfigArgs(vector<string>& earlyArgs);
 
-    void buildObjects(const string& tag, vector<string>& objects);
+    void buildObjects(const string& tag, vector<string>& objects) const;
 
-    bool getConfigList(
-        const string& list, vector<string>& returnList, bool force = true, uint currentFilePos = string::npos);
+    bool getConfigList(const string& list, vector<string>& returnList, bool force = true,
+        size_t currentFilePos = string::npos) const;
 
     /**
      * Perform the equivalent of configures find_things function.
@@ -210,6 +562,17 @@ private:
     bool passFindThings(const string& param1, const string& param2, const string& param3, vector<string>& returnList,
         vector<string>* returnExterns = nullptr) const;
 
+    /**
+     * Perform the equivalent of configures find_things function on an already loaded file.
+     * @param          param1   The first parameter.
+     * @param          param2   The second parameter.
+     * @param          findFile The contents of the file specified by the third parameter.
+     * @param [in,out] found    Returns any detected configure defines and extern variables.
+     * @param          externs  True to also detect extern variables.
+     */
+    static void passFindThingsSource(
+        const string& param1, const string& param2, string_view findFile, FoundThings& found, bool externs);
+
     /**
      * Perform the equivalent of configures find_things_extern function.
      * @param          param1     The first parameter.
@@ -230,10 +593,11 @@ private:
      */
     bool passFindFiltersExtern(const string& param1, vector<string>& returnList) const;
 
-    bool passAddSuffix(
-        const string& param1, const string& param2, vector<string>& returnList, uint currentFilePos = string::npos);
+    bool passAddSuffix(const string& param1, const string& param2, vector<string>& returnList,
+        size_t currentFilePos = string::npos) const;
 
-    bool passFilterOut(const string& param1, const string& param2, vector<string>& returnList, uint currentFilePos);
+    bool passFilterOut(
+        const string& param1, const string& param2, vector<string>& returnList, size_t currentFilePos) const;
 
     /**
      * Perform the equivalent of configures full_filter_name function.
@@ -243,8 +607,43 @@ private:
      */
     bool passFullFilterName(const string& param1, string& returnString) const;
 
+    /**
+     * Gets a component source file (i.e. allcodecs.c, allfilters.c etc.) from the component registry.
+     * @remark The file is only loaded and passed the first time it is requested.
+     * @param file The file name relative to the root directory.
+     * @return The parsed source, nullptr if the file could not be loaded.
+     */
+    const ComponentSource* getComponentSource(const string& file) const;
+
+    /**
+     * Gets all filter extern declarations found in a component source.
+     * @remark Only declarations of the form used by the current version of the source are returned.
+     * @param       file       The file name relative to the root directory.
+     * @param [out] returnList The found declarations.
+     * @return True if it succeeds, false if it fails.
+     */
+    bool getFilterExterns(const string& file, vector<const ComponentExtern*>& returnList) const;
+
     bool passConfigList(const string& prefix, const string& suffix, const string& list);
 
+    /**
+     * Adds a new configuration option and updates the option lookup tables.
+     * @param option The options name (in upper case).
+     * @param prefix The options prefix (i.e. HAVE_, CONFIG_ etc.).
+     * @return The ID of the new option (its index within m_configValues).
+     */
+    size_t addConfigOption(const string& option, const string& prefix);
+
+    /**
+     * Gets the IDs of all configuration options with a given name.
+     * @remark Some options appear more than once with different prefixes. IDs are returned in the order the options
+     * were added.
+     * @param optionUpper The options name (in upper case).
+     * @param prefixed    (Optional) True if the name includes the options prefix (i.e. HAVE_, CONFIG_ etc.).
+     * @return The list of option IDs, nullptr if option not found.
+     */
+    const vector<size_t>* getConfigOptionIDs(const string& optionUpper, bool prefixed = false) const;
+
     bool passEnabledComponents(const string& file, const string& structName, const string& name, const string& list);
 
     /**
@@ -253,6 +652,12 @@ private:
      */
     bool buildDefaultValues();
 
+    /** Sets any project directories that have not been explicitly set to their default values. */
+    void buildDefaultDirectories();
+
+    /** Detects which of the auto detected libs are available on the current system. */
+    void buildAutoDetectLibs();
+
     bool buildAutoDetectValues();
 
     /**
@@ -272,15 +677,33 @@ private:
 
     /**
      * Update configuration option and perform any dependency option updates as well.
-     * @param option    The option to update.
-     * @param enable    True to enable, false to disable.
-     * @param weak      (Optional) True to only change a value if it is not already set.
-     * @param deep      (Optional) True to also enable _select and _suggest dependencies.
-     * @param recursive (Optional) True if the function has been called from within itself.
+     * @remark Dependent toggles are processed depth first using an explicit stack so that each option is only ever
+     * changed after all the toggles it causes have been processed.
+     * @param option The option to update.
+     * @param enable True to enable, false to disable.
+     * @param weak   (Optional) True to only change a value if it is not already set.
+     * @param deep   (Optional) True to also enable _select and _suggest dependencies.
      * @returns True if it succeeds, false if it fails.
      */
-    bool toggleConfigValue(
-        const string& option, bool enable, bool weak = false, bool deep = false, bool recursive = false);
+    bool toggleConfigValue(const string& option, bool enable, bool weak = false, bool deep = false);
+
+    /**
+     * Gets the list of dependent toggles caused by toggling a configuration option.
+     * @remark The list is only built the first time it is requested.
+     * @param optionLower The options name (in lower case).
+     * @param enable      True if the option is being enabled, false if disabled.
+     * @param deep        True to include _select and _suggest dependencies.
+     * @return The list of toggles.
+     */
+    const vector<ToggleChild>& getToggleExpansion(const string& optionLower, bool enable, bool deep);
+
+    /**
+     * Finds the IDs of a configuration option that is toggled as a dependency of another option.
+     * @remark Options that are not found are added as new unlisted options.
+     * @param       optionLower The options name (in lower case).
+     * @param [out] ids         The IDs of the option.
+     */
+    void getToggleIDs(const string& optionLower, vector<size_t>& ids);
 
     /**
      * Gets configuration option.
@@ -300,6 +723,56 @@ private:
 
     ValuesList::const_iterator getConfigOptionPrefixed(const string& option) const;
 
+    /**
+     * Queries if a configuration options value is enabled.
+     * @param option The configuration option.
+     * @return True if the configuration option is enabled, false if it is disabled or not yet set.
+     */
+    bool isConfigValueEnabled(ValuesList::const_iterator option) const;
+
+    /**
+     * Queries if a configuration options value is disabled.
+     * @param option The configuration option.
+     * @return True if the configuration option is disabled, false if it is enabled or not yet set.
+     */
+    bool isConfigValueDisabled(ValuesList::const_iterator option) const;
+
+    /**
+     * Queries if a configuration options value is enabled.
+     * @param id The ID of the configuration option.
+     * @return True if the configuration option is enabled, false if it is disabled or not yet set.
+     */
+    bool isConfigIDEnabled(size_t id) const;
+
+    /**
+     * Queries if a configuration options value is disabled.
+     * @param id The ID of the configuration option.
+     * @return True if the configuration option is disabled, false if it is enabled or not yet set.
+     */
+    bool isConfigIDDisabled(size_t id) const;
+
+    /**
+     * Gets a configuration options value.
+     * @param option The configuration option.
+     * @return The value ("1" if enabled, "0" if disabled or empty if not yet set).
+     */
+    string getConfigValue(ValuesList::const_iterator option) const;
+
+    /**
+     * Toggles a list of configuration options. Options without dependencies that need processing are updated together.
+     * @param options The options to update.
+     * @param enable  True to enable, false to disable.
+     * @param weak    (Optional) True to only change a value if it is not already set.
+     */
+    void toggleConfigValues(const vector<string>& options, bool enable, bool weak = false);
+
+    /**
+     * Creates a set containing the IDs of all configuration options within a list.
+     * @param       list The list of option names.
+     * @param [out] bits The set of option IDs.
+     */
+    void buildOptionBits(const vector<string>& list, OptionBits& bits) const;
+
     /**
      * Queries if a configuration option is enabled.
      * @param option The option.
@@ -351,9 +824,69 @@ private:
      * @param [out] minor The version number minor.
      * @return True if it succeeds, false if it fails.
      */
-    bool getMinWindowsVersion(uint& major, uint& minor) const;
+    bool getMinWindowsVersion(size_t& major, size_t& minor) const;
 
-    bool passDependencyCheck(const ValuesList::iterator& option);
+    /**
+     * Sets the value of a configuration option and records any change.
+     * @param id     The options ID.
+     * @param enable True to enable, false to disable.
+     * @return True if the value was changed, false if it was already set to the requested value.
+     */
+    bool setConfigValue(size_t id, bool enable);
+
+    /**
+     * Sets the value of multiple configuration options and records each change.
+     * @param ids    The IDs of the options to set.
+     * @param enable True to enable, false to disable.
+     * @return The number of values that were changed.
+     */
+    size_t setConfigValues(const OptionBits& ids, bool enable);
+
+    /**
+     * Adds any config options that have not yet been added to the dependency graph and updates the order in which
+     * options must be checked.
+     */
+    void buildDependencyGraph();
+
+    /**
+     * Creates a list of dependency references from a list of config option names.
+     * @param          list         The list of option names (each may be prefixed with '!').
+     * @param [out]    refs         The dependency references.
+     * @param [in,out] dependencies The IDs of any referenced config options.
+     */
+    void buildDependencyRefs(const vector<string>& list, vector<DependencyRef>& refs, vector<size_t>& dependencies);
+
+    /**
+     * Orders the dependency graph so that each option is checked after all of its dependencies. Options that form a
+     * dependency cycle are grouped together and ordered by ID.
+     */
+    void buildDependencyOrder();
+
+    /**
+     * Perform dependency checks on a set of options along with any previously checked options that are affected by
+     * the resulting changes.
+     * @remark Fails if the values of a dependency cycle never settle.
+     * @param options The IDs of the options to check.
+     * @return True if it succeeds, false if it fails.
+     */
+    bool passDependencyChecks(const vector<size_t>& options);
+
+    /**
+     * Perform dependency check on a single option.
+     * @remark Assumes that all of the options dependencies have already been checked.
+     * @param id The options ID.
+     * @return True if it succeeds, false if it fails.
+     */
+    bool passDependencyCheck(size_t id);
+
+    /**
+     * Queries if a dependency is enabled.
+     * @param dep         The dependency.
+     * @param type        The type of dependency (used for output messages).
+     * @param optionLower The option that has the dependency (used for output messages).
+     * @return True if the dependency is enabled, false if not.
+     */
+    bool isDependencyEnabled(const DependencyRef& dep, const string& type, const string& optionLower) const;
 };
 
 #endif
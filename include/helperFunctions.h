@@ -21,17 +21,15 @@
 #ifndef _HELPERFUNCTIONS_H_
 #define _HELPERFUNCTIONS_H_
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 using namespace std;
 
-#if defined(__x86_64) || defined(_M_X64)
-typedef unsigned __int64 uint;
-#else
-using uint = unsigned int;
-#endif
-
 namespace project_generate {
 /**
  * Loads from a file.
@@ -43,6 +41,33 @@ namespace project_generate {
  */
 bool loadFromFile(const string& fileName, string& retString, bool binary = false, bool outError = true);
 
+/** A read only view of a files contents that is mapped directly into memory. */
+class MappedFile
+{
+public:
+    /**
+     * Maps a file into memory.
+     * @remark Any previously mapped file is released. Unlike loadFromFile no line ending conversion is performed so the
+     * view may contain "\r\n" line endings.
+     * @param fileName Filename of the file.
+     * @param outError (Optional) True to output any detected errors.
+     * @return True if it succeeds, false if it fails.
+     */
+    bool open(const string& fileName, bool outError = true);
+
+    /**
+     * Gets the contents of the mapped file.
+     * @remark The view remains valid for as long as this object (or any copy of it) exists.
+     * @return The file contents.
+     */
+    string_view view() const;
+
+private:
+    struct Mapping;
+    shared_ptr<Mapping> m_mapping;
+    string_view m_view;
+};
+
 /**
  * Loads from an internal embedded resource.
  * @param       resourceID Identifier for the resource.
@@ -53,6 +78,8 @@ bool loadFromResourceFile(int resourceID, string& retString);
 
 /**
  * Writes to file.
+ * @remark The file is only written if its existing contents differ from those being written. Any changed file is
+ *  replaced atomically so that a partially written file is never left behind.
  * @param fileName Filename of the file.
  * @param inString The inString to write.
  * @param binary   (Optional) True to write in binary mode (in normal text mode line ending are converted to OS
@@ -61,6 +88,21 @@ bool loadFromResourceFile(int resourceID, string& retString);
  */
 bool writeToFile(const string& fileName, const string& inString, bool binary = false);
 
+/**
+ * Checks whether a file has been output (written or copied) during the current run.
+ * @param fileName Filename of the file.
+ * @return True if the file has been output, false if not.
+ */
+bool isFileWritten(const string& fileName);
+
+/**
+ * Gets all files output (written or copied) during the current run that are within a directory or any of its
+ * sub-directories.
+ * @param          directory Pathname of the directory.
+ * @param [in,out] retFiles  The returned list of files relative to the directory (in sorted order).
+ */
+void getWrittenFiles(const string& directory, vector<string>& retFiles);
+
 /**
  * Copies an internal embedded resource to a file.
  * @param resourceID      Identifier for the resource.
@@ -138,6 +180,32 @@ bool findFiles(const string& fileSearch, vector<string>& retFiles, bool recursiv
  */
 bool findFolders(const string& folderSearch, vector<string>& retFolders, bool recursive = true);
 
+/**
+ * Adds all files within a directory and any of its sub-directories to the file index. Any file created or deleted
+ * using the functions in this file is then automatically updated in the index.
+ * @param directory Pathname of the directory.
+ */
+void indexFiles(const string& directory);
+
+/**
+ * Searches for the first file by name (supports wildcards). Files within an indexed directory are found using the
+ * file index, any other files are searched for directly.
+ * @param       fileName    The file name to search for.
+ * @param [out] retFileName Filename of the found file.
+ * @return True if it succeeds, false if it fails.
+ */
+bool findIndexedFile(const string& fileName, string& retFileName);
+
+/**
+ * Searches for files by name (supports wildcards). Files within an indexed directory are found using the file index,
+ * any other files are searched for directly.
+ * @param          fileSearch The file name to search for.
+ * @param [in,out] retFiles   The returned list of found files.
+ * @param          recursive  (Optional) True to process any sub-directories.
+ * @return True if it succeeds, false if it fails.
+ */
+bool findIndexedFiles(const string& fileSearch, vector<string>& retFiles, bool recursive = true);
+
 /**
  * Makes a file path relative to another.
  * @param       path           Input path.
@@ -146,6 +214,14 @@ bool findFolders(const string& folderSearch, vector<string>& retFolders, bool re
  */
 void makePathsRelative(const string& path, const string& makeRelativeTo, string& retPath);
 
+/**
+ * Checks whether 2 directory paths refer to the same directory.
+ * @param directory  The first directory (relative to the current working directory or absolute).
+ * @param directory2 The second directory (relative to the current working directory or absolute).
+ * @return True if the same, false if not.
+ */
+bool isSameDirectory(const string& directory, const string& directory2);
+
 /**
  * Removes all whitespace from a string in place.
  * @param [in,out] inputString The string to operate on.
@@ -160,6 +236,14 @@ void removeWhiteSpace(string& inputString);
  */
 void findAndReplace(string& inString, const string& search, const string& replace);
 
+/**
+ * Creates a 64bit FNV-1a hash of a string.
+ * @param inString The string to hash.
+ * @param seed     (Optional) The hash to continue from (allows multiple strings to be combined).
+ * @return The hash value.
+ */
+uint64_t hashString(const string_view inString, uint64_t seed = 14695981039346656037ULL);
+
 /**
  * Searches for the existence of an environment variable.
  * @param envVar The environment variable.
@@ -0,0 +1,249 @@
+/*
+ * copyright (c) 2017 Matthew Oliver
+ *
+ * This file is part of ShiftMediaProject.
+ *
+ * ShiftMediaProject is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * ShiftMediaProject is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with ShiftMediaProject; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef PREPROCESSOR_H
+#define PREPROCESSOR_H
+
+#include "helperFunctions.h"
+
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * A minimal C pre-processor used to expand source files without requiring an external compiler.
+ * @remark Supports includes, object and function like macros (including '#' and '##') and conditional blocks. Any
+ *  included file that cannot be found (such as system headers) is skipped (with an info message for files included
+ *  using quotes) and all other directives are ignored.
+ */
+class PreProcessor
+{
+public:
+    /**
+     * Adds a directory to search for included files. Directories are searched in the order they are added.
+     * @param directory The directory to add.
+     */
+    void addIncludeDirectory(const string& directory);
+
+    /**
+     * Adds a macro that is defined before each file is pre-processed.
+     * @param name  The macro name.
+     * @param value (Optional) The macro value.
+     */
+    void addDefine(const string& name, const string& value = "1");
+
+    /**
+     * Pre-processes a source file. Each file is processed separately starting with only the added defines.
+     * @param       fileName  Filename of the file (used to find files included relative to it).
+     * @param       file      The contents of the file.
+     * @param [out] retOutput The pre-processed output.
+     * @return True if it succeeds, false if it fails.
+     */
+    bool process(const string& fileName, const string& file, string& retOutput);
+
+    /**
+     * Gets every file that has been included while pre-processing.
+     * @return The list of included files.
+     */
+    const set<string>& getIncludedFiles() const
+    {
+        return m_includedFiles;
+    }
+
+private:
+    enum class TokenType
+    {
+        Identifier,
+        Number,
+        Literal,
+        Punctuator,
+        NewLine,
+        PlaceMarker,
+    };
+
+    struct Token
+    {
+        TokenType type;     // The type of token
+        string text;        // The tokens text
+        bool space;         // True if the token is preceded by whitespace
+        size_t hideSet = 0; // The macros that cannot be expanded by this token (index into m_hideSets)
+    };
+    using TokenList = vector<Token>;
+
+    struct Macro
+    {
+        bool function = false; // True if this is a function like macro
+        bool variadic = false; // True if the last parameter takes a variable number of arguments
+        vector<string> params; // The name of each parameter
+        TokenList body;        // The replacement tokens
+    };
+    using Macros = unordered_map<string, Macro>;
+
+    struct Conditional
+    {
+        bool active;       // True if the current block is used
+        bool taken;        // True if any block has been used
+        bool parentActive; // True if the enclosing block is used
+    };
+
+    vector<string> m_includeDirs;                       // The directories to search for included files
+    Macros m_defines;                                   // The macros defined before each file
+    Macros m_macros;                                    // The macros defined in the current file
+    unordered_map<string, TokenList> m_files;           // The tokens of each loaded file
+    unordered_map<string, string> m_includes;           // Maps an included name and its search directory to the found file
+    set<string> m_includedFiles;                        // Every file that has been included
+    set<string> m_onceFiles;                            // Files included using "#pragma once" in the current file
+    vector<set<string>> m_hideSets;                     // Each unique set of macro names used to prevent recursive expansion
+    map<pair<size_t, string>, size_t> m_hideSetAdds;    // Cache of hide set additions
+    map<pair<size_t, size_t>, size_t> m_hideSetMerges;  // Cache of hide set unions
+    map<pair<size_t, size_t>, size_t> m_hideSetCommons; // Cache of hide set intersections
+    size_t m_depth = 0;                                 // The current include depth
+
+    /**
+     * Splits text into tokens.
+     * @param       text      The text to split.
+     * @param [out] retTokens The list of tokens.
+     */
+    static void tokenize(string_view text, TokenList& retTokens);
+
+    /**
+     * Outputs tokens as text.
+     * @param          tokens    The tokens to output.
+     * @param [in,out] retOutput The output to append the text to.
+     */
+    static void outputTokens(const TokenList& tokens, string& retOutput);
+
+    /**
+     * Pre-processes the tokens of a file.
+     * @param          fileName  Filename of the file.
+     * @param          tokens    The tokens of the file.
+     * @param [in,out] retOutput The output to append the pre-processed file to.
+     * @return True if it succeeds, false if it fails.
+     */
+    bool processTokens(const string& fileName, const TokenList& tokens, string& retOutput);
+
+    /**
+     * Processes an include directive.
+     * @param          directory The directory containing the current file.
+     * @param          tokens    The tokens following the directive name.
+     * @param [in,out] retOutput The output to append the included file to.
+     * @return True if it succeeds, false if it fails.
+     */
+    bool processInclude(const string& directory, const TokenList& tokens, string& retOutput);
+
+    /**
+     * Finds an included file.
+     * @param       name        The name of the included file.
+     * @param       directory   The directory to search first, empty to only search the include directories.
+     * @param [out] retFileName Filename of the found file.
+     * @return True if it succeeds, false if it fails.
+     */
+    bool findInclude(const string& name, const string& directory, string& retFileName);
+
+    /**
+     * Gets the parameter that a token refers to.
+     * @param macro The macro containing the token.
+     * @param token The token.
+     * @return The index of the parameter, string::npos if the token is not a parameter.
+     */
+    static size_t findMacroParam(const Macro& macro, const Token& token);
+
+    /**
+     * Processes a define directive.
+     * @param tokens The tokens following the directive name.
+     */
+    void defineMacro(const TokenList& tokens);
+
+    /**
+     * Expands all macros within a list of tokens.
+     * @param       tokens    The tokens to expand.
+     * @param [out] retTokens The expanded tokens.
+     */
+    void expandTokens(const TokenList& tokens, TokenList& retTokens);
+
+    /**
+     * Replaces a macro with its body while substituting any parameters.
+     * @param       macro     The macro.
+     * @param       args      The arguments passed to each parameter.
+     * @param       hideSet   The hide set to add to each replaced token.
+     * @param [out] retTokens The replaced tokens.
+     */
+    void substituteMacro(const Macro& macro, const vector<TokenList>& args, size_t hideSet, TokenList& retTokens);
+
+    /**
+     * Evaluates the condition of an if/elif directive.
+     * @param tokens The tokens following the directive name.
+     * @return True if the condition is met, false if not.
+     */
+    bool evaluateCondition(const TokenList& tokens);
+
+    /**
+     * Evaluates a conditional expression.
+     * @param          tokens The expanded expression tokens.
+     * @param [in,out] pos    The position of the next token to evaluate.
+     * @return The value of the expression.
+     */
+    int64_t evaluateTernary(const TokenList& tokens, size_t& pos) const;
+
+    /**
+     * Evaluates a binary expression containing only operators with at least a minimum precedence.
+     * @param          tokens        The expanded expression tokens.
+     * @param [in,out] pos           The position of the next token to evaluate.
+     * @param          minPrecedence The minimum operator precedence.
+     * @return The value of the expression.
+     */
+    int64_t evaluateBinary(const TokenList& tokens, size_t& pos, int minPrecedence) const;
+
+    /**
+     * Evaluates a unary expression.
+     * @param          tokens The expanded expression tokens.
+     * @param [in,out] pos    The position of the next token to evaluate.
+     * @return The value of the expression.
+     */
+    int64_t evaluateUnary(const TokenList& tokens, size_t& pos) const;
+
+    /**
+     * Gets a hide set with an additional macro name.
+     * @param hideSet The hide set.
+     * @param name    The name to add.
+     * @return The new hide set.
+     */
+    size_t addHideSet(size_t hideSet, const string& name);
+
+    /**
+     * Gets the union of 2 hide sets.
+     * @param hideSet  The first hide set.
+     * @param hideSet2 The second hide set.
+     * @return The new hide set.
+     */
+    size_t mergeHideSets(size_t hideSet, size_t hideSet2);
+
+    /**
+     * Gets the intersection of 2 hide sets.
+     * @param hideSet  The first hide set.
+     * @param hideSet2 The second hide set.
+     * @return The new hide set.
+     */
+    size_t commonHideSets(size_t hideSet, size_t hideSet2);
+};
+
+#endif
@@ -22,15 +22,158 @@
 #define _PROJECTGENERATOR_H_
 
 #include "configGenerator.h"
+#include "preProcessor.h"
 
-#include <fstream>
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <memory>
 #include <set>
+#include <unordered_set>
 
 class ProjectGenerator
 {
 private:
     using StaticList = vector<string>;
-    using UnknownList = map<string, StaticList>;
+
+    /**
+     * A list of unique items that keeps the order in which each item was first added.
+     * @remark Membership checks use a hash lookup so that large file lists can be de-duplicated as they are built.
+     */
+    class UniqueList
+    {
+    public:
+        using const_iterator = StaticList::const_iterator;
+
+        /**
+         * Adds an item to the end of the list if it is not already contained within the list.
+         * @param item The item to add.
+         * @return True if the item was added, false if it was already in the list.
+         */
+        bool push_back(const string& item)
+        {
+            if (!m_index.insert(item).second) {
+                return false;
+            }
+            m_list.push_back(item);
+            return true;
+        }
+
+        bool contains(const string& item) const
+        {
+            return m_index.find(item) != m_index.end();
+        }
+
+        void clear()
+        {
+            m_list.clear();
+            m_index.clear();
+        }
+
+        size_t size() const
+        {
+            return m_list.size();
+        }
+
+        bool empty() const
+        {
+            return m_list.empty();
+        }
+
+        const_iterator begin() const
+        {
+            return m_list.begin();
+        }
+
+        const_iterator end() const
+        {
+            return m_list.end();
+        }
+
+    private:
+        StaticList m_list;
+        unordered_set<string> m_index;
+    };
+
+    using UnknownList = map<string, UniqueList>;
+
+    /** The reserved config conditions for a replaced object, classified as they are added. */
+    class ReplaceConds
+    {
+    public:
+        /**
+         * Adds a condition and updates the combined condition and its classification.
+         * @param condition The config option (prefixed with '!' if negated).
+         */
+        void push_back(const string& condition)
+        {
+            if (!m_conditions.empty()) {
+                m_idents += " || ";
+            }
+            m_idents += condition;
+            m_conditions.push_back(condition);
+            if (condition == "ARCH_X86_32" || condition == "!ARCH_X86_64") {
+                m_is32 = true;
+            } else if (condition == "ARCH_X86_64" || condition == "!ARCH_X86_32") {
+                m_is64 = true;
+            } else if (condition == "CONFIG_SHARED" || condition == "!CONFIG_STATIC") {
+                m_isShared = true;
+            } else if (condition == "CONFIG_STATIC" || condition == "!CONFIG_SHARED") {
+                m_isStatic = true;
+            } else {
+                m_hasOther = true;
+            }
+        }
+
+        bool contains(const string& condition) const
+        {
+            return find(m_conditions.begin(), m_conditions.end(), condition) != m_conditions.end();
+        }
+
+        /** Gets all conditions joined into a single pre-processor expression. */
+        const string& idents() const
+        {
+            return m_idents;
+        }
+
+        bool isStatic() const
+        {
+            return m_isStatic;
+        }
+
+        bool isShared() const
+        {
+            return m_isShared;
+        }
+
+        bool is32() const
+        {
+            return m_is32;
+        }
+
+        bool is64() const
+        {
+            return m_is64;
+        }
+
+        /** Checks if any condition cannot be handled by a VS configuration (i.e. static/shared|32/64bit). */
+        bool hasOther() const
+        {
+            return m_hasOther;
+        }
+
+    private:
+        StaticList m_conditions;
+        string m_idents;
+        bool m_isStatic = false;
+        bool m_isShared = false;
+        bool m_is32 = false;
+        bool m_is64 = false;
+        bool m_hasOther = false;
+    };
+    using ReplaceList = map<string, ReplaceConds>;
+    using ReplaceStems = unordered_map<string, StaticList>;
+
     struct ConfigConds
     {
         bool isStatic = false;
@@ -46,46 +189,89 @@ private:
         {}
     };
     using ConditionalList = map<string, ConfigConds>;
-    ifstream m_inputFile;
-    string m_inLine;
-    StaticList m_includes;
-    StaticList m_includesCPP;
-    StaticList m_includesC;
-    StaticList m_includesASM;
+
+    struct MakeStatement
+    {
+        enum Type
+        {
+            MAKE_ASSIGNMENT, // A variable assignment (e.g. OBJS-$(CONFIG_X) += file.o)
+            MAKE_INCLUDE,    // An include or -include directive
+            MAKE_IFDEF,      // An ifdef directive
+            MAKE_IFNDEF,     // An ifndef directive
+            MAKE_IFEQ,       // An ifeq or ifneq directive
+            MAKE_ELSE,       // An else directive
+            MAKE_ENDIF,      // An endif directive
+            MAKE_OTHER,      // Any other line (rules, recipes, function calls etc.)
+        };
+
+        Type type = MAKE_OTHER;
+        string name;           // The assigned variable, included file or condition (the whole line for MAKE_OTHER)
+        string ident;          // The condition used by an assigned variable (e.g. CONFIG_X from OBJS-$(CONFIG_X))
+        vector<string> values; // The assigned words with any continuation lines joined and comments removed
+    };
+    using MakeFile = vector<MakeStatement>;
+
+    struct MakeCondition
+    {
+        size_t id = string::npos; // The ID of the conditions config option, string::npos if the option is unknown
+        bool negate = false;      // True if the condition is negated (i.e. !CONFIG_X)
+        bool replace = false;     // True if the option is a reserved type that is replaced in the project files
+    };
+    using MakeConditions = unordered_map<string, MakeCondition>;
+
+    UniqueList m_includes;
+    UniqueList m_includesCPP;
+    UniqueList m_includesC;
+    UniqueList m_includesASM;
     ConditionalList m_includesConditionalCPP;
     ConditionalList m_includesConditionalC;
     ConditionalList m_includesConditionalASM;
     ConditionalList m_includesConditionalCU;
     ConditionalList m_includesConditionalCL;
     ConditionalList m_includesConditionalCOMP;
-    StaticList m_includesH;
-    StaticList m_includesRC;
-    StaticList m_includesCU;
-    StaticList m_includesCL;
-    StaticList m_includesCOMP;
-    UnknownList m_replaceIncludes;
-    StaticList m_libs;
+    UniqueList m_includesH;
+    UniqueList m_includesRC;
+    UniqueList m_includesCU;
+    UniqueList m_includesCL;
+    UniqueList m_includesCOMP;
+    ReplaceList m_replaceIncludes;
+    UniqueList m_libs;
     UnknownList m_unknowns;
+    MakeConditions m_makeConditions; // Each condition used by the Makefiles resolved against the current config
     string m_projectName;
     string m_projectDir;
     StaticList m_subDirs;
 
     map<string, StaticList> m_projectLibs;
 
-    const string m_tempDirectory = "FFVSTemp/";
+    string m_tempDirectory;
 
 public:
-    ConfigGenerator m_configHelper;
+    const ConfigGenerator& m_configHelper;
+
+    /**
+     * Constructor.
+     * @remark The config helper is only ever read from so it can be shared between several project generators.
+     * @param configHelper  The config helper used to determine the current configuration.
+     * @param tempDirectory (Optional) The directory used to store any temporary files.
+     */
+    explicit ProjectGenerator(const ConfigGenerator& configHelper, const string& tempDirectory = "FFVSTemp/");
 
     /**
      * Checks all found Makefiles based on current configuration and generates project files and a solution files as
      * needed.
+     * @remark Each library project is generated in parallel once all of the libraries it depends on are complete.
      * @return True if it succeeds, false if it fails.
      */
     bool passAllMake();
 
-    /** Deletes any files that may have been created by previous runs. */
-    void deleteCreatedFiles();
+    /**
+     * Deletes any files that may have been created by previous runs. The files are read from the manifest written at
+     * the end of the previous run, if there is no manifest then the solution directory is searched instead.
+     * @param staleOnly (Optional) True to only delete files that were not output during the current run, the manifest
+     *                  is then updated with the files output during the current run.
+     */
+    void deleteCreatedFiles(bool staleOnly = false);
 
     /**
      * Error function to cleanly exit.
@@ -93,7 +279,26 @@ public:
      */
     void errorFunc(bool cleanupFiles = true);
 
+    /** Deletes any partially created files and any temporary files after an error. */
+    void cleanupCreatedFiles();
+
 private:
+    /**
+     * Checks whether a file is one of those generated by a run.
+     * @param fileName  Filename of the file relative to the solution directory.
+     * @param libraries The list of all libraries (including the "lib" prefix).
+     * @param programs  The list of all programs.
+     * @return True if the file is a generated file, false if not.
+     */
+    bool isCreatedFile(const string& fileName, const vector<string>& libraries, const vector<string>& programs) const;
+
+    /**
+     * Passes the Makefiles for the current library project and outputs its project files.
+     * @param dependencies The results of each of the libraries the project depends on.
+     * @return True if it succeeds, false if it fails.
+     */
+    bool passProject(const vector<shared_future<bool>>& dependencies);
+
     /**
      * Outputs a project file for the current project directory.
      * @return True if it succeeds, false if it fails.
@@ -117,141 +322,201 @@ private:
      */
     bool outputSolution();
 
-    bool passStaticIncludeObject(uint& startPos, uint& endPos, StaticList& staticIncludes);
+    /**
+     * Loads a makefile and splits it into a list of statements.
+     * @remark Each makefile is only passed once and the result is shared with any later requests for the same file.
+     * @param       fileName Filename of the makefile.
+     * @param [out] makeFile The passed makefile statements.
+     * @return True if it succeeds, false if it fails.
+     */
+    static bool loadMakeFile(const string& fileName, shared_ptr<const MakeFile>& makeFile);
+
+    /**
+     * Splits the contents of a makefile into a list of statements.
+     * @param       contents The makefile contents.
+     * @param [out] makeFile The passed makefile statements.
+     */
+    static void passMakeFile(string_view contents, MakeFile& makeFile);
+
+    /**
+     * Passes a single logical makefile line (i.e. with any continuation lines already joined).
+     * @param       line      The line to pass.
+     * @param [out] statement The passed statement.
+     * @return True if the line contains a statement, false if it is blank or only a comment.
+     */
+    static bool passMakeLine(string_view line, MakeStatement& statement);
 
-    bool passStaticIncludeLine(uint startPos, StaticList& staticIncludes);
+    /**
+     * Gets the configuration option used by a dynamic makefile variable name (e.g. CONFIG_X from OBJS-$(CONFIG_X)).
+     * @param name The variable name.
+     * @return The configuration option, empty if the name does not contain one.
+     */
+    static string getMakeIdent(const string& name);
+
+    bool passStaticIncludeObject(const string& object, UniqueList& staticIncludes);
 
-    bool passStaticInclude(uint length, StaticList& staticIncludes);
+    bool passStaticInclude(const vector<string>& values, UniqueList& staticIncludes);
+
+    /**
+     * Resolves a Makefile condition to its configuration option.
+     * @remark The config does not change while passing a project so each condition is only resolved once.
+     * @param ident The condition (e.g. CONFIG_X or !CONFIG_X).
+     * @return The resolved condition.
+     */
+    const MakeCondition& getMakeCondition(const string& ident);
 
-    bool passDynamicIncludeObject(uint& startPos, uint& endPos, string& ident, StaticList& includes);
+    /**
+     * Checks whether a Makefile condition is met by the current configuration.
+     * @param condition The resolved condition.
+     * @return True if the condition is met, false if it is not or the conditions option is unknown.
+     */
+    bool isMakeConditionMet(const MakeCondition& condition) const;
 
-    bool passDynamicIncludeLine(uint startPos, string& ident, StaticList& includes);
+    bool passDynamicIncludeObject(
+        const string& object, const string& ident, const MakeCondition& condition, UniqueList& includes);
 
-    bool passDynamicInclude(uint length, StaticList& includes);
+    bool passDynamicInclude(const string& ident, const vector<string>& values, UniqueList& includes);
 
     /**
-     * Pass a static source include line from current makefile that is wrapped in a reserved conditional.
-     * @param condition The pre-processor condition applied to the current line.
+     * Pass a static source include statement from current makefile that is wrapped in a reserved conditional.
+     * @param condition The pre-processor condition applied to the current statement.
+     * @param values    The statements assigned values.
      * @param list      The file list to add any found files to when the condition evaluates to 'true'.
      * @param replace   The file list to add any found files to when the condition is a reserved value.
-     * @param offset    The offset to start passing (used to separate different file tags).
      * @return True if it succeeds, false if it fails.
      */
-    bool passCondition(const string& condition, StaticList& list, UnknownList& replace, uint offset = 0);
+    bool passCondition(const string& condition, const vector<string>& values, UniqueList& list, ReplaceList& replace);
 
     /**
-     * Pass a dynamic source include line from current makefile that is wrapped in a reserved conditional.
-     * @param condition The pre-processor condition applied to the current line.
+     * Pass a dynamic source include statement from current makefile that is wrapped in a reserved conditional.
+     * @param condition The pre-processor condition applied to the current statement.
+     * @param ident     The configuration option used by the statement.
+     * @param values    The statements assigned values.
      * @param list      The file list to add any found files to when the condition evaluates to 'true'.
      * @param replace   The file list to add any found files to when the condition is a reserved value.
-     * @param offset    The offset to start passing (used to separate different file tags).
      * @return True if it succeeds, false if it fails.
      */
-    bool passDCondition(const string& condition, StaticList& list, UnknownList& replace, uint offset = 0);
+    bool passDCondition(const string& condition, const string& ident, const vector<string>& values, UniqueList& list,
+        ReplaceList& replace);
 
     /**
-     * Pass a static source include line from current makefile.
-     * @param condition (Optional) The pre-processor condition applied to the current line.
+     * Pass a static source include statement from current makefile.
+     * @param statement The statement to pass.
+     * @param condition (Optional) The pre-processor condition applied to the current statement.
      * @return True if it succeeds, false if it fails.
      */
-    bool passCInclude(const string& condition = "");
+    bool passCInclude(const MakeStatement& statement, const string& condition = "");
 
     /**
-     * Pass a dynamic source include line from current makefile.
-     * @param condition (Optional) The pre-processor condition applied to the current line.
+     * Pass a dynamic source include statement from current makefile.
+     * @param statement The statement to pass.
+     * @param condition (Optional) The pre-processor condition applied to the current statement.
      * @return True if it succeeds, false if it fails.
      */
-    bool passDCInclude(const string& condition = "");
+    bool passDCInclude(const MakeStatement& statement, const string& condition = "");
 
     /**
-     * Pass a static asm include line from current makefile.
-     * @param offset The offset to start passing (used to separate old yasm and x86asm).
-     * @param condition (Optional) The pre-processor condition applied to the current line.
+     * Pass a static asm include statement from current makefile.
+     * @param statement The statement to pass.
+     * @param condition (Optional) The pre-processor condition applied to the current statement.
      * @return True if it succeeds, false if it fails.
      */
-    bool passASMInclude(uint offset, const string& condition = "");
+    bool passASMInclude(const MakeStatement& statement, const string& condition = "");
 
     /**
-     * Pass a dynamic asm include line from current makefile.
-     * @param offset The offset to start passing (used to separate old yasm and x86asm).
-     * @param condition (Optional) The pre-processor condition applied to the current line.
+     * Pass a dynamic asm include statement from current makefile.
+     * @param statement The statement to pass.
+     * @param condition (Optional) The pre-processor condition applied to the current statement.
      * @return True if it succeeds, false if it fails.
      */
-    bool passDASMInclude(uint offset, const string& condition = "");
+    bool passDASMInclude(const MakeStatement& statement, const string& condition = "");
 
     /**
-     * Pass a static mmx include line from current makefile.
-     * @param condition (Optional) The pre-processor condition applied to the current line.
+     * Pass a static mmx include statement from current makefile.
+     * @param statement The statement to pass.
+     * @param condition (Optional) The pre-processor condition applied to the current statement.
      * @return True if it succeeds, false if it fails.
      */
-    bool passMMXInclude(const string& condition = "");
+    bool passMMXInclude(const MakeStatement& statement, const string& condition = "");
 
     /**
-     * Pass a dynamic mmx include line from current makefile.
-     * @param condition (Optional) The pre-processor condition applied to the current line.
+     * Pass a dynamic mmx include statement from current makefile.
+     * @param statement The statement to pass.
+     * @param condition (Optional) The pre-processor condition applied to the current statement.
      * @return True if it succeeds, false if it fails.
      */
-    bool passDMMXInclude(const string& condition = "");
+    bool passDMMXInclude(const MakeStatement& statement, const string& condition = "");
 
     /**
-     * Pass a static header include line from current makefile.
+     * Pass a static header include statement from current makefile.
+     * @param statement The statement to pass.
      * @return True if it succeeds, false if it fails.
      */
-    bool passHInclude(uint cutPos = 7);
+    bool passHInclude(const MakeStatement& statement);
 
     /**
-     * Pass a dynamic header include line from current makefile.
+     * Pass a dynamic header include statement from current makefile.
+     * @param statement The statement to pass.
      * @return True if it succeeds, false if it fails.
      */
-    bool passDHInclude();
+    bool passDHInclude(const MakeStatement& statement);
 
     /**
-     * Pass a static lib include line from current makefile.
+     * Pass a static lib include statement from current makefile.
+     * @param statement The statement to pass.
      * @return True if it succeeds, false if it fails.
      */
-    bool passLibInclude();
+    bool passLibInclude(const MakeStatement& statement);
 
     /**
-     * Pass a dynamic lib include line from current makefile.
+     * Pass a dynamic lib include statement from current makefile.
+     * @param statement The statement to pass.
      * @return True if it succeeds, false if it fails.
      */
-    bool passDLibInclude();
+    bool passDLibInclude(const MakeStatement& statement);
 
     /**
-     * Pass a static unknown type include line from current makefile.
+     * Pass a dynamic unknown type include statement from current makefile.
+     * @param statement The statement to pass.
      * @return True if it succeeds, false if it fails.
      */
-    bool passDUnknown();
+    bool passDUnknown(const MakeStatement& statement);
 
     /**
-     * Pass a dynamic unknown type include line from current makefile.
+     * Pass a shared only dynamic source include statement from current makefile.
+     * @param statement The statement to pass.
      * @return True if it succeeds, false if it fails.
      */
-    bool passDLibUnknown();
+    bool passSharedDCInclude(const MakeStatement& statement);
 
     /**
-     * Pass a shared only dynamic source include line from current makefile.
+     * Pass a shared only source include statement from current makefile.
+     * @param statement The statement to pass.
      * @return True if it succeeds, false if it fails.
      */
-    bool passSharedDCInclude();
+    bool passSharedCInclude(const MakeStatement& statement);
 
     /**
-     * Pass a shared only source include line from current makefile.
+     * Pass a static only dynamic source include statement from current makefile.
+     * @param statement The statement to pass.
      * @return True if it succeeds, false if it fails.
      */
-    bool passSharedCInclude();
+    bool passStaticDCInclude(const MakeStatement& statement);
 
     /**
-     * Pass a static only dynamic source include line from current makefile.
+     * Pass a static only source include statement from current makefile.
+     * @param statement The statement to pass.
      * @return True if it succeeds, false if it fails.
      */
-    bool passStaticDCInclude();
+    bool passStaticCInclude(const MakeStatement& statement);
 
     /**
-     * Pass a static only source include line from current makefile.
+     * Pass a program object statement (i.e. OBJS-ffmpeg or OBJS-$(prog)) from current makefile.
+     * @param statement The statement to pass.
+     * @param prefix    The length of the variable name prefix that identifies the program.
      * @return True if it succeeds, false if it fails.
      */
-    bool passStaticCInclude();
+    bool passProgramInclude(const MakeStatement& statement, size_t prefix);
 
     /**
      * Passes the makefile for the current project directory.
@@ -314,6 +579,34 @@ private:
         }
     };
 
+    struct DCEDeclaration
+    {
+        string declaration;        // The complete declaration
+        string file;               // The file containing the declaration (relative to the root directory)
+        bool isFunction = false;   // True if this is a function, false if it is a variable/table
+        bool isDefinition = false; // True if no declaration was found before the definition
+    };
+    using DCEDeclarations = unordered_map<string, DCEDeclaration>;
+
+    struct DCEScanResult
+    {
+        bool success = false;                 // True if the file was successfully scanned
+        bool requiresPreProcess = false;      // True if the file requires pre processing
+        StaticList includedFiles;             // Any included header files in the order they were found
+        map<string, DCEParams> foundDCEUsage; // The DCE usage found only within the file
+        set<string> nonDCEUsage;              // The usage not in DCE found within the file
+        uint64_t hash = 0;                    // Hash of the scanned file contents (including inlined source files)
+    };
+
+    struct DCESnapshot
+    {
+        map<string, DCEScanResult> files;            // The scan results of each file
+        uint64_t key = 0;                            // Key covering all input used to create the DCE definitions
+        vector<pair<string, uint64_t>> dependencies; // Each file read while pre-processing and its hash
+        bool hasOutput = false;                      // True if a DCE definitions file was output
+        uint64_t outputHash = 0;                     // Hash of the output DCE definitions file
+    };
+
     /**
      * Builds project specific DCE functions and variables that are not automatically detected.
      * @param [out] definitionsDCE The return list of built DCE functions.
@@ -326,15 +619,16 @@ private:
     /**
      * Builds '_wrap' files to wrap source files in a conditional compilation statement.
      * @param replaceIncludes              The list of files to scan.
+     * @param replaceStems                 Maps each file stem to the replaced objects with that stem.
      * @param [in,out] existingIncludes    The list of existing processed files.
      * @param [in,out] conditionalIncludes The list of existing conditional files.
      */
-    bool createReplaceFiles(
-        const StaticList& replaceIncludes, StaticList& existingIncludes, ConditionalList& conditionalIncludes);
+    bool createReplaceFiles(const UniqueList& replaceIncludes, const ReplaceStems& replaceStems,
+        UniqueList& existingIncludes, ConditionalList& conditionalIncludes);
 
-    bool findProjectFiles(const StaticList& includes, StaticList& includesC, StaticList& includesCPP,
-        StaticList& includesASM, StaticList& includesH, StaticList& includesRC, StaticList& includesCU,
-        StaticList& includesCL, StaticList& includesCOMP) const;
+    bool findProjectFiles(const UniqueList& includes, UniqueList& includesC, UniqueList& includesCPP,
+        UniqueList& includesASM, UniqueList& includesH, UniqueList& includesRC, UniqueList& includesCU,
+        UniqueList& includesCL, UniqueList& includesCOMP) const;
 
     /**
      * Replace occurrences of known tags in string.
@@ -349,8 +643,8 @@ private:
      */
     void outputPropsTags(string& projectTemplate) const;
 
-    void outputSourceFileType(StaticList& fileList, const string& type, const string& filterType,
-        string& projectTemplate, string& filterTemplate, StaticList& foundObjects, set<string>& foundFilters,
+    void outputSourceFileType(const UniqueList& fileList, const string& type, const string& filterType,
+        string& projectTemplate, string& filterTemplate, UniqueList& foundObjects, set<string>& foundFilters,
         bool checkExisting, bool staticOnly = false, bool sharedOnly = false, bool bit32Only = false,
         bool bit64Only = false) const;
 
@@ -369,37 +663,40 @@ private:
     bool outputProjectExports(const StaticList& includeDirs) const;
 
     /**
-     * Executes a batch script to perform operations using a compiler based on current configuration.
+     * Executes a batch script to generate an sbr file for each input file using a compiler based on current
+     * configuration.
      * @param          includeDirs      The list of current directories to look for included files.
      * @param [in,out] directoryObjects A list of subdirectories with each one containing a vector of files contained
      *   within it.
-     * @param          runType          The type of operation to run on input files (0=generate an sbr file, 1=pre-
-     *  process to .i file).
      * @returns True if it succeeds, false if it fails.
      */
-    bool runCompiler(
-        const vector<string>& includeDirs, map<string, vector<string>>& directoryObjects, int runType) const;
+    bool runCompiler(const vector<string>& includeDirs, map<string, vector<string>>& directoryObjects) const;
 
     /**
-     * Executes a batch script to perform operations using the msvc compiler.
-     * @param          includeDirs      The list of current directories to look for included files.
-     * @param [in,out] directoryObjects A list of subdirectories with each one containing a vector of files contained
-     *   within it.
-     * @param          runType          The type of operation to run on input files (0=generate an sbr file, 1=pre-
-     *  process to .i file).
-     * @returns True if it succeeds, false if it fails.
+     * Gets the include directories used by the compiler with any project specific directories resolved.
+     * @param       includeDirs    The list of current directories to look for included files.
+     * @param [out] retIncludeDirs The list of compiler include directories.
+     */
+    void buildCompilerIncludeDirs(const StaticList& includeDirs, StaticList& retIncludeDirs) const;
+
+    /**
+     * Sets up a pre-processor to use the same include directories and defines as the compiler.
+     * @remark Only the x64 debug configuration is defined so code specific to other architectures or release builds
+     *  is not seen. Include directories using environment variables are skipped as they are only available from
+     *  within the compiler environment.
+     * @param          includeDirs  The list of current directories to look for included files.
+     * @param [in,out] preProcessor The pre-processor.
      */
-    bool runMSVC(const vector<string>& includeDirs, map<string, vector<string>>& directoryObjects, int runType) const;
+    void buildPreProcessor(const StaticList& includeDirs, PreProcessor& preProcessor) const;
 
     /**
-     * Executes a bash script to perform operations using the gcc compiler.
+     * Executes a batch script to generate an sbr file for each input file using the msvc compiler.
      * @param          includeDirs      The list of current directories to look for included files.
      * @param [in,out] directoryObjects A list of subdirectories with each one containing a vector of files contained
      *   within it.
-     * @param          runType          The type of operation to run on input files (1=pre-process to .i file).
      * @returns True if it succeeds, false if it fails.
      */
-    bool runGCC(const vector<string>& includeDirs, map<string, vector<string>>& directoryObjects, int runType) const;
+    bool runMSVC(const vector<string>& includeDirs, map<string, vector<string>>& directoryObjects) const;
 
     /**
      * Output additional build events to the project.
@@ -455,6 +752,67 @@ private:
      */
     bool outputProjectDCE(const StaticList& includeDirs);
 
+    /**
+     * Scans files for DCE usage until there are no files left. Used to scan files using multiple threads.
+     * @param          files     The list of files.
+     * @param          firstFile The index of the file that the first result is for.
+     * @param [in,out] nextFile  The index of the next file to be scanned, shared between each thread.
+     * @param [in,out] results   The results for each file.
+     * @param          snapshot  The snapshot of a previous run used to skip scanning unchanged files.
+     */
+    void outputProjectDCEScanFiles(const StaticList& files, size_t firstFile, atomic<size_t>& nextFile,
+        vector<DCEScanResult>& results, const DCESnapshot& snapshot) const;
+
+    /**
+     * Scans a file for DCE usage. Any included source files are scanned as part of the file.
+     * @remark The results only depend on the contents of the file so that multiple files can be scanned at once.
+     * @param       fileName Filename of the file.
+     * @param [out] result   The results of the scan.
+     * @param       snapshot The snapshot of a previous run used to skip scanning unchanged files.
+     * @return True if it succeeds, false if it fails.
+     */
+    bool outputProjectDCEScanFile(const string& fileName, DCEScanResult& result, const DCESnapshot& snapshot) const;
+
+    /**
+     * Finds the DCE usage within a scanned file, reusing the results of any other variant that scanned the same file.
+     * @remark Each file is only scanned once for each project and the result is shared with any later requests for
+     * the same file contents.
+     * @param          file     The loaded file (including inlined source files) to search for DCE usage in.
+     * @param          fileName Filename of the file.
+     * @param [in,out] result   The results of the scan. The hash must already be set.
+     */
+    void outputProjectDCEFindSharedFunctions(string_view file, const string& fileName, DCEScanResult& result) const;
+
+    /**
+     * Creates a key that identifies all input used to create the DCE definitions of the current project.
+     * @remark Files read while pre-processing are not covered by the key and are checked separately.
+     * @param includeDirs  The list of current directories to look for included files.
+     * @param scannedFiles The scan results of each project file.
+     * @param projectFiles The list of all files in the project directory.
+     * @return The key value.
+     */
+    uint64_t buildDCESnapshotKey(const StaticList& includeDirs, const map<string, DCEScanResult>& scannedFiles,
+        const StaticList& projectFiles) const;
+
+    /**
+     * Loads the DCE results of a previous run from a snapshot file.
+     * @param [out] snapshot The loaded snapshot, left empty if no valid snapshot was found.
+     */
+    void loadDCESnapshot(DCESnapshot& snapshot) const;
+
+    /**
+     * Saves the DCE results of the current run to a snapshot file.
+     * @param snapshot The snapshot to save.
+     */
+    void saveDCESnapshot(const DCESnapshot& snapshot) const;
+
+    /**
+     * Checks whether any file read while pre-processing has changed since a snapshot was created.
+     * @param snapshot The snapshot to check.
+     * @return True if all files are unchanged, false if not.
+     */
+    static bool checkDCESnapshotDependencies(const DCESnapshot& snapshot);
+
     /**
      * Passes an input file and looks for any function usage within a block of code eliminated by DCE.
      * @param          file               The loaded file to search for DCE usage in.
@@ -463,7 +821,7 @@ private:
      * @param [out]    requiresPreProcess The file requires pre processing.
      * @param [in,out] nonDCEUsage        The return list of found functions not in DCE.
      */
-    void outputProjectDCEFindFunctions(const string& file, const string& fileName,
+    void outputProjectDCEFindFunctions(const string_view file, const string& fileName,
         map<string, DCEParams>& foundDCEUsage, bool& requiresPreProcess, set<string>& nonDCEUsage) const;
 
     /**
@@ -473,18 +831,55 @@ private:
     void outputProgramDCEsResolveDefine(string& define);
 
     /**
-     * Find any declaration of a specified function. Can also find a definition of the function if no declaration as
-     * found first.
-     * @param       file           The loaded file to search for function in.
+     * Checks whether an occurrence of a function or variable name within a file is its declaration. Can also find a
+     * definition of the function if it is not a declaration.
+     * @param       file           The loaded file containing the name.
+     * @param       findPos        The position of the name within the file.
+     * @param       length         The length of the name.
+     * @param [out] retDeclaration Returns the complete declaration for the found function.
+     * @param [out] isFunction     Returns if the found declaration was actually for a function or an incorrectly
+     *                              identified table/array declaration.
+     * @param [out] isDefinition   Returns if the found declaration is actually a definition.
+     * @return True if the name is declared at the specified position, false if not.
+     */
+    static bool outputProjectDCEsCheckDeclaration(string_view file, size_t findPos, size_t length,
+        string& retDeclaration, bool& isFunction, bool& isDefinition);
+
+    /**
+     * Finds every function and variable declaration within a file and adds them to a declaration index.
+     * @remark Names that are already in the index are not replaced, so files should be passed in order of precedence.
+     * Only the first declaration of a name within a file is used.
+     * @param          file         The loaded file to search for declarations in.
+     * @param          fileName     Filename of the file to store with each declaration.
+     * @param [in,out] declarations The declaration index.
+     */
+    static void outputProjectDCEIndexDeclarations(
+        string_view file, const string& fileName, DCEDeclarations& declarations);
+
+    /**
+     * Loads a file and indexes every function and variable declaration within it.
+     * @remark Each file is only indexed once and the result is shared with any later requests for the same file
+     * contents.
+     * @param       file         Filename of the file to load.
+     * @param       fileName     Filename of the file to store with each declaration.
+     * @param [out] declarations The declaration index of the file.
+     * @return True if it succeeds, false if it fails.
+     */
+    static bool loadDCEDeclarations(
+        const string& file, const string& fileName, shared_ptr<const DCEDeclarations>& declarations);
+
+    /**
+     * Find the declaration of a specified function within a declaration index.
+     * @param       declarations   The declaration index to search.
      * @param       function       The name of the function to search for.
-     * @param       fileName       Filename of the file being searched through.
      * @param [out] retDeclaration Returns the complete declaration for the found function.
      * @param [out] isFunction     Returns if the found declaration was actually for a function or an incorrectly
      *                              identified table/array declaration.
+     * @param [out] retFile        Returns the file that contains the declaration.
      * @return True if it succeeds finding the function, false if it fails.
      */
-    static bool outputProjectDCEsFindDeclarations(
-        const string& file, const string& function, const string& fileName, string& retDeclaration, bool& isFunction);
+    static bool outputProjectDCEsFindDeclaration(const DCEDeclarations& declarations, const string& function,
+        string& retDeclaration, bool& isFunction, string& retFile);
 
     /**
      * Cleans a pre-processor define conditional string to remove any invalid values.
@@ -20,8 +20,18 @@
 #include "configGenerator.h"
 
 #include <algorithm>
+#include <cstdlib>
 #include <fstream>
+#include <mutex>
 #include <regex>
+#include <set>
+
+// Guards the caches that are filled by const lookups as projects may be generated from multiple threads
+static mutex g_cacheMutex;
+
+// Version of the config snapshot format and value resolution. This must be incremented whenever a change to the
+// generator changes the values resolved from the same input so that any existing snapshots are no longer used.
+static const size_t g_configSnapshotVersion = 1;
 
 ConfigGenerator::ConfigGenerator()
     : m_projectName("FFMPEG")
@@ -29,33 +39,72 @@ ConfigGenerator::ConfigGenerator()
 
 bool ConfigGenerator::passConfig(const int argc, char** argv)
 {
-    // Check for initial input arguments
+    vector<string> options;
+    for (int i = 1; i < argc; i++) {
+        options.emplace_back(argv[i]);
+    }
+    return passConfigure(options) && passConfigValues(options);
+}
+
+bool ConfigGenerator::passConfigure(const vector<string>& options)
+{
+    if (!passEarlyConfig(options)) {
+        return false;
+    }
+    return passConfigureFile();
+}
+
+bool ConfigGenerator::passConfigValues(const vector<string>& options)
+{
+    // Early options have already been passed along with the configure file
+    buildDefaultDirectories();
+    buildAutoDetectLibs();
+
+    // Check for a snapshot of the values resolved by a previous run with identical input
     vector<string> earlyArgs;
     buildEarlyConfigArgs(earlyArgs);
-    for (int i = 1; i < argc; i++) {
-        string option = string(argv[i]);
-        string command = option;
-        const uint pos = option.find('=');
-        if (pos != string::npos) {
-            command = option.substr(0, pos);
+    // Tracing requires all values to be resolved so snapshots are not used
+    bool useSnapshot = !m_traceConfig;
+    for (const auto& i : options) {
+        if (i.find("--use-existing-config") == 0) {
+            useSnapshot = false;
         }
-        if (find(earlyArgs.begin(), earlyArgs.end(), command) != earlyArgs.end()) {
-            if (!changeConfig(option)) {
+    }
+    const uint64_t snapshotKey = (useSnapshot) ? buildSnapshotKey(options) : 0;
+    if (useSnapshot && loadConfigSnapshot(snapshotKey)) {
+        outputLine("  Using previously resolved config values...");
+        vector<string> reservedItems;
+        buildReservedValues(reservedItems);
+        for (const auto& option : options) {
+            if (find(earlyArgs.begin(), earlyArgs.end(), option) != earlyArgs.end()) {
+                continue;
+            }
+            if ((option.find("--enable-") == 0) || (option.find("--disable-") == 0)) {
+                // Values are already resolved so only the configuration string needs updating. Reserved options are
+                // ignored by changeConfig so they are never added.
+                string option2 = option.substr(option.find('-', 2) + 1);
+                replace(option2.begin(), option2.end(), '-', '_');
+                if (find(reservedItems.begin(), reservedItems.end(), option2) != reservedItems.end()) {
+                    outputWarning("Reserved option (" + option2 + ") was passed in command line option (" + option2 +
+                        ")");
+                    outputWarning("This option is reserved and will be ignored", false);
+                    continue;
+                }
+                addConfigurationOption(option);
+            } else if (!changeConfig(option)) {
                 return false;
             }
         }
+        return true;
     }
-    if (!passConfigureFile()) {
-        return false;
-    }
+
     // Load with default values
     if (!buildDefaultValues()) {
         return false;
     }
     // Pass input arguments
-    for (int i = 1; i < argc; i++) {
+    for (const auto& option : options) {
         // Check that option hasn't already been processed
-        string option = string(argv[i]);
         if (find(earlyArgs.begin(), earlyArgs.end(), option) == earlyArgs.end()) {
             if (!changeConfig(option)) {
                 return false;
@@ -75,6 +124,29 @@ bool ConfigGenerator::passConfig(const int argc, char** argv)
     }
     // Super ensure forced values
     buildForcedValues();
+    if (useSnapshot) {
+        saveConfigSnapshot(snapshotKey);
+    }
+    return true;
+}
+
+bool ConfigGenerator::passEarlyConfig(const vector<string>& options)
+{
+    // Check for initial input arguments
+    vector<string> earlyArgs;
+    buildEarlyConfigArgs(earlyArgs);
+    for (const auto& option : options) {
+        string command = option;
+        const size_t pos = option.find('=');
+        if (pos != string::npos) {
+            command = option.substr(0, pos);
+        }
+        if (find(earlyArgs.begin(), earlyArgs.end(), command) != earlyArgs.end()) {
+            if (!changeConfig(option)) {
+                return false;
+            }
+        }
+    }
     return true;
 }
 
@@ -88,12 +160,12 @@ bool ConfigGenerator::passConfigureFile()
         // Search paths starting in current directory then checking parents
         string pathList[] = {"./", "../", "./ffmpeg/", "../ffmpeg/", "../../ffmpeg/", "../../../", "../../", "./libav/",
             "../libav/", "../../libav/"};
-        uint pathCount = 0;
-        const uint numPaths = sizeof(pathList) / sizeof(string);
+        size_t pathCount = 0;
+        const size_t numPaths = sizeof(pathList) / sizeof(string);
         for (; pathCount < numPaths; pathCount++) {
             m_rootDirectory = pathList[pathCount];
             string configFile = m_rootDirectory + "configure";
-            if (loadFromFile(configFile, m_configureFile, false, false)) {
+            if (m_configureMapping.open(configFile, false)) {
                 break;
             }
         }
@@ -104,14 +176,18 @@ bool ConfigGenerator::passConfigureFile()
     } else {
         // Open configure file
         const string configFile = m_rootDirectory + "configure";
-        if (!loadFromFile(configFile, m_configureFile, false, false)) {
+        if (!m_configureMapping.open(configFile, false)) {
             outputError("Failed to find a 'configure' file in specified root directory");
             return false;
         }
     }
+    m_configureFile = m_configureMapping.view();
+
+    // Find all variable definitions so that lists can be quickly looked up
+    passConfigureAssignments();
 
     // Search for start of config.h file parameters
-    uint startPos = m_configureFile.find("#define FFMPEG_CONFIG_H");
+    size_t startPos = m_configureFile.find("#define FFMPEG_CONFIG_H");
     if (startPos == string::npos) {
         // Check if this is instead a libav configure
         startPos = m_configureFile.find("#define LIBAV_CONFIG_H");
@@ -123,33 +199,33 @@ bool ConfigGenerator::passConfigureFile()
         m_projectName = "LIBAV";
     }
     // Move to end of header guard
-    startPos += 23 - static_cast<uint>(m_isLibav);
+    startPos += 23 - static_cast<size_t>(m_isLibav);
 
     // Build default value list
     DefaultValuesList defaultValues;
     buildFixedValues(defaultValues);
 
-    for (uint searches = 0; searches < 2; ++searches) {
+    for (size_t searches = 0; searches < 2; ++searches) {
         // Get each defined option till EOF
-        uint configEnd = m_configureFile.find("EOF", startPos + 1);
+        size_t configEnd = m_configureFile.find("EOF", startPos + 1);
         startPos = m_configureFile.find("#define", startPos + 1);
         if (configEnd == string::npos) {
             outputError("Failed finding config.h parameters end");
             return false;
         }
-        uint endPos = configEnd;
+        size_t endPos = configEnd;
         while ((startPos != string::npos) && (startPos < configEnd)) {
             // Skip white space
             startPos = m_configureFile.find_first_not_of(g_whiteSpace, startPos + 7);
             // Get first string
             endPos = m_configureFile.find_first_of(g_whiteSpace, startPos + 1);
-            const string configName = m_configureFile.substr(startPos, endPos - startPos);
+            const string configName(m_configureFile.substr(startPos, endPos - startPos));
             // Get second string
             startPos = m_configureFile.find_first_not_of(g_whiteSpace, endPos + 1);
             endPos = m_configureFile.find_first_of(g_whiteSpace, startPos + 1);
-            string configValue = m_configureFile.substr(startPos, endPos - startPos);
+            string configValue(m_configureFile.substr(startPos, endPos - startPos));
             // Check if the value is a variable
-            const uint startPos2 = configValue.find('$');
+            const size_t startPos2 = configValue.find('$');
             if (startPos2 != string::npos) {
                 // Check if it is a function call
                 if (configValue.at(startPos2 + 1) == '(') {
@@ -157,7 +233,7 @@ bool ConfigGenerator::passConfigureFile()
                     configValue = m_configureFile.substr(startPos, endPos - startPos + 1);
                 }
                 // Remove any quotes from the tag if there are any
-                const uint endPos2 =
+                const size_t endPos2 =
                     (configValue.at(configValue.length() - 1) == '"') ? configValue.length() - 1 : configValue.length();
                 // Find and replace the value
                 auto val = defaultValues.find(configValue.substr(startPos2, endPos2 - startPos2));
@@ -177,7 +253,7 @@ bool ConfigGenerator::passConfigureFile()
             }
 
             // Add to the list
-            m_fixedConfigValues.push_back(ConfigPair(configName, "", configValue));
+            m_fixedConfigValues.push_back(FixedPair(configName, configValue));
 
             // Find next
             startPos = m_configureFile.find("#define", endPos + 1);
@@ -197,7 +273,7 @@ bool ConfigGenerator::passConfigureFile()
             // Find prefix
             startPos = m_configureFile.find_first_not_of(g_whiteSpace, startPos + 12);
             endPos = m_configureFile.find_first_of(g_whiteSpace, startPos + 1);
-            string prefix = m_configureFile.substr(startPos, endPos - startPos);
+            string prefix(m_configureFile.substr(startPos, endPos - startPos));
             // Skip unneeded var
             startPos = m_configureFile.find_first_not_of(g_whiteSpace, endPos + 1);
             endPos = m_configureFile.find_first_of(g_whiteSpace, startPos + 1);
@@ -205,7 +281,7 @@ bool ConfigGenerator::passConfigureFile()
             // Find option list
             startPos = m_configureFile.find_first_not_of(g_whiteSpace, endPos + 1);
             endPos = m_configureFile.find_first_of(g_whiteSpace, startPos + 1);
-            string sList = m_configureFile.substr(startPos, endPos - startPos);
+            string sList(m_configureFile.substr(startPos, endPos - startPos));
             // Strip the variable prefix from start
             sList.erase(0, 1);
 
@@ -217,15 +293,15 @@ bool ConfigGenerator::passConfigureFile()
             // Check if multiple lines
             endPos = m_configureFile.find_first_not_of(g_whiteSpace, endPos + 1);
             while (m_configureFile.at(endPos) == '\\') {
-                // Skip newline
-                ++endPos;
+                // Skip newline (which may be a "\r\n" pair)
+                endPos = m_configureFile.find('\n', endPos + 1);
                 startPos = m_configureFile.find_first_not_of(" \t", endPos + 1);
                 // Check for blank line
-                if (m_configureFile.at(startPos) == '\n') {
+                if (g_endLine.find(m_configureFile.at(startPos)) != string::npos) {
                     break;
                 }
                 endPos = m_configureFile.find_first_of(g_whiteSpace, startPos + 1);
-                string list = m_configureFile.substr(startPos, endPos - startPos);
+                string list(m_configureFile.substr(startPos, endPos - startPos));
                 // Strip the variable prefix from start
                 list.erase(0, 1);
 
@@ -254,10 +330,44 @@ bool ConfigGenerator::passConfigureFile()
     }
     // Mark the end of the config list. Any elements added after this are considered temporary and should not be
     // exported
-    m_configValuesEnd = m_configValues.size(); // must be uint in case of realloc
+    m_configValuesEnd = m_configValues.size(); // must be size_t in case of realloc
+
+    // Now that all options are known the dependency lookups can be created
+    buildDependencyTables();
     return true;
 }
 
+void ConfigGenerator::passConfigureAssignments()
+{
+    m_configureAssignments.clear();
+    m_cachedConfigLists.clear();
+    // Any line that starts with 'name=' is a variable definition
+    size_t start = m_configureFile.find('\n');
+    while (start != string::npos) {
+        ++start;
+        const size_t end = m_configureFile.find_first_of(g_nonName, start);
+        if ((end != string::npos) && (end > start) && (m_configureFile[end] == '=')) {
+            // Definitions are found in file order so each list is already sorted
+            m_configureAssignments[string(m_configureFile.substr(start, end - start))].push_back(start);
+        }
+        start = m_configureFile.find('\n', start);
+    }
+}
+
+size_t ConfigGenerator::findConfigListDefinition(const string& list, const size_t currentFilePos) const
+{
+    const auto definitions = m_configureAssignments.find(list);
+    if (definitions == m_configureAssignments.end()) {
+        return string::npos;
+    }
+    // Find the last definition that starts at or before the current position
+    auto definition = upper_bound(definitions->second.begin(), definitions->second.end(), currentFilePos);
+    if (definition == definitions->second.begin()) {
+        return string::npos;
+    }
+    return *--definition;
+}
+
 bool ConfigGenerator::passExistingConfig()
 {
     outputLine("  Passing in existing config.h file...");
@@ -272,11 +382,11 @@ bool ConfigGenerator::passExistingConfig()
     }
 
     // Find the first valid configuration option
-    uint pos = -1;
+    size_t pos = -1;
     const string configTags[] = {"ARCH_", "HAVE_", "CONFIG_"};
     for (const auto& configTag : configTags) {
         string search = "#define " + configTag;
-        uint pos2 = configH.find(search);
+        size_t pos2 = configH.find(search);
         pos = (pos2 < pos) ? pos2 : pos;
     }
 
@@ -284,7 +394,7 @@ bool ConfigGenerator::passExistingConfig()
     while (pos != string::npos) {
         pos = configH.find_first_not_of(g_whiteSpace, pos + 7);
         // Get the tag
-        uint pos2 = configH.find_first_of(g_whiteSpace, pos + 1);
+        size_t pos2 = configH.find_first_of(g_whiteSpace, pos + 1);
         string option = configH.substr(pos, pos2 - pos);
 
         // Check if the options is valid
@@ -328,7 +438,7 @@ bool ConfigGenerator::passExistingConfig()
 bool ConfigGenerator::changeConfig(const string& option)
 {
     if (option == "--help") {
-        uint start = m_configureFile.find("show_help(){");
+        size_t start = m_configureFile.find("show_help(){");
         if (start == string::npos) {
             outputError("Failed finding help list in config file");
             return false;
@@ -339,8 +449,10 @@ bool ConfigGenerator::changeConfig(const string& option)
             outputError("Incompatible help list in config file");
             return false;
         }
-        uint end = m_configureFile.find("EOF", start);
-        string helpOptions = m_configureFile.substr(start, end - start);
+        size_t end = m_configureFile.find("EOF", start);
+        string helpOptions(m_configureFile.substr(start, end - start));
+        // Strip any "\r\n" line endings so that sections can be found by their blank line
+        helpOptions.erase(remove(helpOptions.begin(), helpOptions.end(), '\r'), helpOptions.end());
         // Search through help options and remove any values not supported
         string removeSections[] = {"Standard options:", "Documentation options:", "Toolchain options:",
             "Advanced options (experts only):", "Developer options (useful when working on FFmpeg itself):", "NOTE:"};
@@ -360,11 +472,14 @@ bool ConfigGenerator::changeConfig(const string& option)
         // outputLine("  --incdir=DIR             install includes in DIR [PREFIX/include]");
         outputLine("  --rootdir=DIR            location of source configure file [auto]");
         outputLine("  --projdir=DIR            location of output project files [ROOT/SMP]");
+        outputLine(
+            "  --variant=NAME           generate a named project variant using all following options (requires its own --projdir)");
         outputLine(
             "  --use-existing-config    use an existing config.h file found in rootdir, ignoring any other passed parameters affecting config");
         // Add in custom toolchain string
         outputLine("Toolchain options:");
         outputLine("  --dce-only               do not output a project and only generate missing DCE files");
+        outputLine("  --trace-config           output the number of dependent values changed by each config toggle");
         outputLine(
             "  --use-yasm               use YASM instead of the default NASM (this is not advised as it does not support newer instructions)");
         // Add in reserved values
@@ -470,7 +585,7 @@ bool ConfigGenerator::changeConfig(const string& option)
         outputLine(option2 + ": ");
         for (auto& i : list) {
             // cut off any trailing type
-            uint pos = i.rfind('_');
+            size_t pos = i.rfind('_');
             if (pos != string::npos) {
                 i = i.substr(0, pos);
             }
@@ -478,6 +593,9 @@ bool ConfigGenerator::changeConfig(const string& option)
             outputLine("  " + i);
         }
         return false;
+    } else if (option == "--trace-config") {
+        // This has no parameters and just sets internal value
+        m_traceConfig = true;
     } else if (option.find("--quiet") == 0) {
         setOutputVerbosity(VERBOSITY_ERROR);
     } else if (option.find("--loud") == 0) {
@@ -511,7 +629,7 @@ bool ConfigGenerator::changeConfig(const string& option)
                 return true;
             }
         }
-        uint startPos = option2.find('=');
+        size_t startPos = option2.find('=');
         if (startPos != string::npos) {
             // Find before the =
             string list = option2.substr(0, startPos);
@@ -641,6 +759,12 @@ bool ConfigGenerator::changeConfig(const string& option)
             }
         }
     }
+    addConfigurationOption(option);
+    return true;
+}
+
+void ConfigGenerator::addConfigurationOption(const string& option)
+{
     // Add to the internal configuration variable
     auto configPair = m_fixedConfigValues.begin();
     for (; configPair < m_fixedConfigValues.end(); ++configPair) {
@@ -656,9 +780,121 @@ bool ConfigGenerator::changeConfig(const string& option)
         }
         configPair->m_value += option + "\"";
     }
+}
+
+uint64_t ConfigGenerator::buildSnapshotKey(const vector<string>& options) const
+{
+    uint64_t key = hashString("config snapshot " + to_string(g_configSnapshotVersion) + '\n');
+    key = hashString(m_configureFile, key);
+    for (const auto& i : m_configValues) {
+        key = hashString(i.m_prefix + i.m_option + '\n', key);
+    }
+    // Options that only change output locations or verbosity do not affect the resolved values
+    const string ignoredArgs[] = {
+        "--rootdir", "--projdir", "--prefix", "--loud", "--quiet", "--dce-only", "--trace-config"};
+    for (const auto& option : options) {
+        bool ignored = false;
+        for (const auto& j : ignoredArgs) {
+            if (option.find(j) == 0) {
+                ignored = true;
+                break;
+            }
+        }
+        if (ignored) {
+            continue;
+        }
+        // Enable and disable options are normalised in the same way as when they are passed
+        string normalised = option;
+        if (option.find("--enable-") == 0) {
+            replace(normalised.begin() + 9, normalised.end(), '-', '_');
+        } else if (option.find("--disable-") == 0) {
+            replace(normalised.begin() + 10, normalised.end(), '-', '_');
+        }
+        key = hashString(normalised + '\n', key);
+    }
+    for (const auto& i : m_autoDetectLibs) {
+        key = hashString(i.first + ((i.second) ? "=1\n" : "=0\n"), key);
+    }
+    return key;
+}
+
+bool ConfigGenerator::loadConfigSnapshot(const uint64_t key)
+{
+    string snapshot;
+    if (!loadFromFile(m_solutionDirectory + "config.snapshot", snapshot, false, false)) {
+        return false;
+    }
+    // First line is the key
+    size_t endPos = snapshot.find('\n');
+    if ((endPos == string::npos) || (snapshot.substr(0, endPos) != to_string(key))) {
+        return false;
+    }
+    // Second line is the total number of options
+    size_t startPos = endPos + 1;
+    endPos = snapshot.find('\n', startPos);
+    if (endPos == string::npos) {
+        return false;
+    }
+    const string numLine = snapshot.substr(startPos, endPos - startPos);
+    char* numEnd = nullptr;
+    const size_t numOptions = strtoull(numLine.c_str(), &numEnd, 10);
+    if (numLine.empty() || (numLine[0] < '0') || (numLine[0] > '9') || (*numEnd != '\0')) {
+        // Corrupt snapshot
+        return false;
+    }
+    if ((numOptions < m_configValues.size()) || (m_configValues.size() != m_configValuesEnd)) {
+        return false;
+    }
+    // Followed by any options that were added while resolving values
+    vector<pair<string, string>> addedOptions;
+    for (size_t i = m_configValues.size(); i < numOptions; ++i) {
+        startPos = endPos + 1;
+        endPos = snapshot.find('\n', startPos);
+        if (endPos == string::npos) {
+            return false;
+        }
+        const string line = snapshot.substr(startPos, endPos - startPos);
+        const size_t split = line.find(' ');
+        if (split == string::npos) {
+            addedOptions.emplace_back(line, "");
+        } else {
+            addedOptions.emplace_back(line.substr(0, split), line.substr(split + 1));
+        }
+    }
+    // Last line contains the value of each option
+    startPos = endPos + 1;
+    endPos = snapshot.find('\n', startPos);
+    if ((endPos == string::npos) || (endPos - startPos != numOptions)) {
+        return false;
+    }
+    for (const auto& i : addedOptions) {
+        addConfigOption(i.first, i.second);
+    }
+    for (size_t i = 0; i < numOptions; ++i) {
+        const char value = snapshot[startPos + i];
+        if (value != '-') {
+            m_configSet.set(i);
+            m_configEnabled.set(i, value == '1');
+        }
+    }
     return true;
 }
 
+void ConfigGenerator::saveConfigSnapshot(const uint64_t key) const
+{
+    string snapshot = to_string(key) + '\n';
+    snapshot += to_string(m_configValues.size()) + '\n';
+    for (auto i = m_configValues.begin() + m_configValuesEnd; i < m_configValues.end(); ++i) {
+        snapshot += i->m_option + ((i->m_prefix.empty()) ? "" : ' ' + i->m_prefix) + '\n';
+    }
+    for (auto i = m_configValues.begin(); i < m_configValues.end(); ++i) {
+        const string value = getConfigValue(i);
+        snapshot += (value.empty()) ? '-' : value[0];
+    }
+    snapshot += '\n';
+    writeToFile(m_solutionDirectory + "config.snapshot", snapshot);
+}
+
 bool ConfigGenerator::passCurrentValues()
 {
     if (m_usingExistingConfig) {
@@ -682,123 +918,99 @@ bool ConfigGenerator::passCurrentValues()
         vector<string> list2;
         for (const auto& i : libList) {
             const auto opt = getConfigOption(i);
-            const bool enable = (opt != m_configValues.end()) && (opt->m_value != "0");
+            const bool enable = (opt != m_configValues.end()) && !isConfigValueDisabled(opt);
             const bool weak = enable;
             string optionUpper = i; // Ensure it is in upper case
             transform(optionUpper.begin(), optionUpper.end(), optionUpper.begin(), ::toupper);
             list2.resize(0);
             if (getConfigList(optionUpper + "_COMPONENTS", list2, false)) {
-                for (const auto& j : list2) {
-                    toggleConfigValue(j, enable, weak);
-                }
+                toggleConfigValues(list2, enable, weak);
             }
             list2.resize(0);
             if (getConfigList(optionUpper + "_COMPONENTS_LIST", list2, false)) {
-                for (const auto& j : list2) {
-                    toggleConfigValue(j, enable, weak);
-                }
+                toggleConfigValues(list2, enable, weak);
             }
         }
     }
 
     // Perform full check of all config values
-    auto option = m_configValues.begin();
-    for (; option < m_configValues.end(); ++option) {
-        if (!passDependencyCheck(option)) {
-            return false;
-        }
+    vector<size_t> allOptions(m_configValues.size());
+    for (size_t id = 0; id < allOptions.size(); ++id) {
+        allOptions[id] = id;
     }
-    // Check for any still unset values
-    option = m_configValues.begin();
-    for (; option < m_configValues.end(); ++option) {
-        // If still not set then disable
-        if (option->m_value.empty()) {
-            option->m_value = "0";
-        }
+    if (!passDependencyChecks(allOptions)) {
+        return false;
     }
+    // Check for any still unset values. If still not set then disable (unset values are never enabled)
+    m_configSet.fill();
 
 #if defined(OPTIMISE_ENCODERS) || defined(OPTIMISE_DECODERS)
     // Optimise the config values. Based on user input different encoders/decoder can be disabled as there are now
     // better inbuilt alternatives
-    OptimisedConfigList optimisedDisables;
+    ConfigList optimisedDisables;
     buildOptimisedDisables(optimisedDisables);
     // Check everything that is disabled based on current configuration
-    bool disabledOpt = false;
+    m_changedValues.clear();
     for (const auto& i : optimisedDisables) {
         // Check if optimised value is valid for current configuration
         auto disableOpt = getConfigOption(i.first);
         if (disableOpt != m_configValues.end()) {
-            if (disableOpt->m_value == "1") {
+            if (isConfigValueEnabled(disableOpt)) {
                 // Disable unneeded items
                 for (const auto& j : i.second) {
-                    disabledOpt = true;
                     toggleConfigValue(j, false);
                 }
             }
         }
     }
     // It may be possible that the above optimisation pass disables some dependencies of other options.
-    // If this happens then a full recheck is performed
-    if (disabledOpt) {
-        option = m_configValues.begin();
-        for (; option < m_configValues.end(); ++option) {
-            if (!passDependencyCheck(option)) {
-                return false;
-            }
+    // If this happens then any options that depend on the changed values are rechecked
+    vector<size_t> recheckOptions;
+    for (const auto& i : m_changedValues) {
+        if (getConfigValue(m_configValues.begin() + i.first) != i.second) {
+            const auto& dependents = m_dependencyGraph[i.first].dependents;
+            recheckOptions.insert(recheckOptions.end(), dependents.begin(), dependents.end());
         }
     }
+    if (!passDependencyChecks(recheckOptions)) {
+        return false;
+    }
 #endif
 
     // Check the current options are valid for selected license
     if (!isConfigOptionEnabled("nonfree")) {
         vector<string> licenseList;
+        OptionBits licenseOptions;
         // Check for existence of specific license lists
         if (getConfigList("EXTERNAL_LIBRARY_NONFREE_LIST", licenseList, false)) {
-            for (auto i = licenseList.begin(); i < licenseList.end(); ++i) {
-                if (isConfigOptionEnabled(*i)) {
-                    outputError("Current license does not allow for option (" + getConfigOption(*i)->m_option + ")");
-                    return false;
-                }
-            }
+            buildOptionBits(licenseList, licenseOptions);
             // Check for gpl3 lists
             if (!isConfigOptionEnabled("gplv3")) {
                 licenseList.clear();
                 if (getConfigList("EXTERNAL_LIBRARY_GPLV3_LIST", licenseList, false)) {
-                    for (auto i = licenseList.begin(); i < licenseList.end(); ++i) {
-                        if (isConfigOptionEnabled(*i)) {
-                            outputError(
-                                "Current license does not allow for option (" + getConfigOption(*i)->m_option + ")");
-                            return false;
-                        }
-                    }
+                    buildOptionBits(licenseList, licenseOptions);
                 }
             }
             // Check for version3 lists
             if ((!isConfigOptionEnabled("lgplv3")) && (!isConfigOptionEnabled("gplv3"))) {
                 licenseList.clear();
                 if (getConfigList("EXTERNAL_LIBRARY_VERSION3_LIST", licenseList, false)) {
-                    for (auto itI = licenseList.begin(); itI < licenseList.end(); ++itI) {
-                        if (isConfigOptionEnabled(*itI)) {
-                            outputError(
-                                "Current license does not allow for option (" + getConfigOption(*itI)->m_option + ")");
-                            return false;
-                        }
-                    }
+                    buildOptionBits(licenseList, licenseOptions);
                 }
             }
             // Check for gpl lists
             if (!isConfigOptionEnabled("gpl")) {
                 licenseList.clear();
                 if (getConfigList("EXTERNAL_LIBRARY_GPL_LIST", licenseList, false)) {
-                    for (auto itI = licenseList.begin(); itI < licenseList.end(); ++itI) {
-                        if (isConfigOptionEnabled(*itI)) {
-                            outputError(
-                                "Current license does not allow for option (" + getConfigOption(*itI)->m_option + ")");
-                            return false;
-                        }
-                    }
+                    buildOptionBits(licenseList, licenseOptions);
                 }
             }
+            // Check all disallowed options at once
+            const size_t invalid = m_configEnabled.findCommon(licenseOptions);
+            if (invalid != string::npos) {
+                outputError("Current license does not allow for option (" + m_configValues[invalid].m_option + ")");
+                return false;
+            }
         }
     }
     return true;
@@ -867,16 +1079,16 @@ bool ConfigGenerator::outputConfig()
         string sTagName = i->m_prefix + i->m_option;
         // Check for forced replacement (only if attribute is not disabled)
         string addConfig;
-        if ((i->m_value != "0") && (m_replaceList.find(sTagName) != m_replaceList.end())) {
+        if (!isConfigValueDisabled(i) && (m_replaceList.find(sTagName) != m_replaceList.end())) {
             addConfig = m_replaceList[sTagName];
         } else {
-            addConfig = "#define " + sTagName + ' ' + i->m_value;
+            addConfig = "#define " + sTagName + ' ' + getConfigValue(i);
         }
         configureFile += addConfig + '\n';
-        if ((i->m_value != "0") && (m_replaceListASM.find(sTagName) != m_replaceListASM.end())) {
+        if (!isConfigValueDisabled(i) && (m_replaceListASM.find(sTagName) != m_replaceListASM.end())) {
             configureFileASM += m_replaceListASM[sTagName] + '\n';
         } else {
-            configureFileASM += "%define " + sTagName + ' ' + i->m_value + '\n';
+            configureFileASM += "%define " + sTagName + ' ' + getConfigValue(i) + '\n';
         }
     }
 
@@ -906,10 +1118,10 @@ bool ConfigGenerator::outputConfig()
             string sTagName = i->m_prefix + i->m_option;
             // Check for forced replacement (only if attribute is not disabled)
             string addConfig;
-            if ((i->m_value != "0") && (m_replaceList.find(sTagName) != m_replaceList.end())) {
+            if (!isConfigValueDisabled(i) && (m_replaceList.find(sTagName) != m_replaceList.end())) {
                 addConfig = m_replaceList[sTagName];
             } else {
-                addConfig = "#define " + sTagName + ' ' + i->m_value;
+                addConfig = "#define " + sTagName + ' ' + getConfigValue(i);
             }
             componentsFile += addConfig + '\n';
         }
@@ -943,7 +1155,7 @@ bool ConfigGenerator::outputConfig()
     }
     for (const auto& i : configListAV) {
         auto option2 = getConfigOption(i);
-        configFileAV += "#define AV_HAVE_" + option2->m_option + ' ' + option2->m_value + '\n';
+        configFileAV += "#define AV_HAVE_" + option2->m_option + ' ' + getConfigValue(option2) + '\n';
     }
     configFileAV += "#endif /* SMP_LIBAVUTIL_AVCONFIG_H */\n";
     configFile = m_solutionDirectory + "libavutil/avconfig.h";
@@ -965,6 +1177,9 @@ bool ConfigGenerator::outputConfig()
     string version;
     getline(ifVersionDefFile, version);
     ifVersionDefFile.close();
+    if (!version.empty() && (version.back() == '\r')) {
+        version.pop_back();
+    }
 
     // Output header
     string versionFile = fileHeader + '\n';
@@ -981,24 +1196,24 @@ bool ConfigGenerator::outputConfig()
     }
 
     // Output enabled components lists
-    uint start = m_configureFile.find("print_enabled_components ");
+    size_t start = m_configureFile.find("print_enabled_components ");
     while (start != string::npos) {
         // Get file name input parameter
         start = m_configureFile.find_first_not_of(g_whiteSpace, start + 24);
-        uint end = m_configureFile.find_first_of(g_whiteSpace, start + 1);
-        string file = m_configureFile.substr(start, end - start);
+        size_t end = m_configureFile.find_first_of(g_whiteSpace, start + 1);
+        string file(m_configureFile.substr(start, end - start));
         // Get struct name input parameter
         start = m_configureFile.find_first_not_of(g_whiteSpace, end + 1);
         end = m_configureFile.find_first_of(g_whiteSpace, start + 1);
-        string structName = m_configureFile.substr(start, end - start);
+        string structName(m_configureFile.substr(start, end - start));
         // Get list name input parameter
         start = m_configureFile.find_first_not_of(g_whiteSpace, end + 1);
         end = m_configureFile.find_first_of(g_whiteSpace, start + 1);
-        string name = m_configureFile.substr(start, end - start);
+        string name(m_configureFile.substr(start, end - start));
         // Get config list input parameter
         start = m_configureFile.find_first_not_of(g_whiteSpace, end + 1);
         end = m_configureFile.find_first_of(g_whiteSpace, ++start); // skip preceding '$'
-        string list = m_configureFile.substr(start, end - start);
+        string list(m_configureFile.substr(start, end - start));
         if (!passEnabledComponents(file, structName, name, list)) {
             return false;
         }
@@ -1007,17 +1222,18 @@ bool ConfigGenerator::outputConfig()
     return true;
 }
 
-void ConfigGenerator::deleteCreatedFiles() const
+void ConfigGenerator::deleteCreatedFiles(const bool staleOnly) const
 {
     if (!m_usingExistingConfig) {
         // Delete any previously generated files
-        vector<string> existingFiles;
-        findFiles(m_solutionDirectory + "config.h", existingFiles, false);
-        findFiles(m_solutionDirectory + "config.asm", existingFiles, false);
-        findFiles(m_solutionDirectory + "libavutil/avconfig.h", existingFiles, false);
-        findFiles(m_solutionDirectory + "libavutil/ffversion.h", existingFiles, false);
-        for (const auto& i : existingFiles) {
-            deleteFile(i);
+        // config.h, config.asm and config_components.h are always regenerated and are only rewritten if changed
+        // The file names are fixed so they can be deleted directly without searching for them first
+        const string createdFiles[] = {"libavutil/avconfig.h", "libavutil/ffversion.h"};
+        for (const auto& i : createdFiles) {
+            const string fileName = m_solutionDirectory + i;
+            if (!staleOnly || !isFileWritten(fileName)) {
+                deleteFile(fileName);
+            }
         }
     }
 }
@@ -1026,65 +1242,91 @@ void ConfigGenerator::makeFileProjectRelative(const string& fileName, string& re
 {
     string path;
     string file = fileName;
-    uint pos = file.rfind('/');
+    size_t pos = file.rfind('/');
     if (pos != string::npos) {
         ++pos;
         path = fileName.substr(0, pos);
         file = fileName.substr(pos);
     }
-    makePathsRelative(path, m_solutionDirectory, retFileName);
+    // Check if this path has already been converted
+    const string key = m_solutionDirectory + '\n' + path;
+    {
+        lock_guard<mutex> lock(g_cacheMutex);
+        const auto found = m_projectRelativePaths.find(key);
+        if (found != m_projectRelativePaths.end()) {
+            retFileName = found->second + file;
+            return;
+        }
+    }
+    string relativePath;
+    makePathsRelative(path, m_solutionDirectory, relativePath);
     // Check if relative to project dir
-    if (retFileName.find("./") == 0) {
-        retFileName = retFileName.substr(2);
+    if (relativePath.find("./") == 0) {
+        relativePath = relativePath.substr(2);
+    }
+    {
+        lock_guard<mutex> lock(g_cacheMutex);
+        m_projectRelativePaths.emplace(key, relativePath);
     }
-    retFileName += file;
+    retFileName = relativePath + file;
 }
 
 void ConfigGenerator::makeFileGeneratorRelative(const string& fileName, string& retFileName) const
 {
     string path;
     string file = fileName;
-    uint pos = file.rfind('/');
+    size_t pos = file.rfind('/');
     if (pos != string::npos) {
         ++pos;
         path = fileName.substr(0, pos);
         file = fileName.substr(pos);
     }
-    if (path != m_solutionDirectory) {
-        path = m_solutionDirectory + path;
+    // Check if this path has already been converted
+    const string key = m_solutionDirectory + '\n' + path;
+    {
+        lock_guard<mutex> lock(g_cacheMutex);
+        const auto found = m_generatorRelativePaths.find(key);
+        if (found != m_generatorRelativePaths.end()) {
+            retFileName = found->second + file;
+            return;
+        }
     }
-    makePathsRelative(path, "./", retFileName);
+    string relativePath;
+    makePathsRelative((path != m_solutionDirectory) ? m_solutionDirectory + path : path, "./", relativePath);
     // Check if relative to current dir
-    if (retFileName.length() > 2 && retFileName.find("./") == 0) {
-        retFileName = retFileName.substr(2);
+    if (relativePath.length() > 2 && relativePath.find("./") == 0) {
+        relativePath = relativePath.substr(2);
+    }
+    {
+        lock_guard<mutex> lock(g_cacheMutex);
+        m_generatorRelativePaths.emplace(key, relativePath);
     }
-    retFileName += file;
+    retFileName = relativePath + file;
 }
 
-bool ConfigGenerator::getConfigList(const string& list, vector<string>& returnList, bool force, uint currentFilePos)
+bool ConfigGenerator::getConfigList(
+    const string& list, vector<string>& returnList, bool force, size_t currentFilePos) const
 {
-    // Check if list is in existing cache
-    auto cachedList = m_cachedConfigLists.find(list);
-    if (currentFilePos == string::npos && cachedList != m_cachedConfigLists.end()) {
-        returnList.insert(returnList.end(), cachedList->second.begin(), cachedList->second.end());
-        return true;
-    }
-    vector<string> foundList;
-
-    // Find List name in file (searches backwards so that it finds the closest definition to where we currently are)
+    // Find List name in file (finds the closest definition before where we currently are)
     //   This is in case a list is redefined
-    uint start = m_configureFile.rfind(list + "=", currentFilePos);
-    // Need to ensure this is the correct list
-    while ((start != string::npos) && (m_configureFile.at(start - 1) != '\n')) {
-        start = m_configureFile.rfind(list + "=", start - 1);
-    }
-    if (start == string::npos) {
+    const size_t listStart = findConfigListDefinition(list, currentFilePos);
+    if (listStart == string::npos) {
         if (force) {
             outputError("Failed finding config list (" + list + ")");
         }
         return false;
     }
-    start += list.length() + 1;
+    // Check if list is in existing cache
+    {
+        lock_guard<mutex> lock(g_cacheMutex);
+        const auto cachedList = m_cachedConfigLists.find(listStart);
+        if (cachedList != m_cachedConfigLists.end()) {
+            returnList.insert(returnList.end(), cachedList->second.begin(), cachedList->second.end());
+            return true;
+        }
+    }
+    vector<string> foundList;
+    size_t start = listStart + list.length() + 1;
     // Check if this is a list or a function
     char endList = '\n';
     if (m_configureFile.at(start) == '"') {
@@ -1094,31 +1336,33 @@ bool ConfigGenerator::getConfigList(const string& list, vector<string>& returnLi
         endList = '\'';
         ++start;
     }
+    const string tagEnd = g_whiteSpace + endList;
+    const string paramEnd = g_whiteSpace + ")";
     // Get start of tag
     start = m_configureFile.find_first_not_of(g_whiteSpace, start);
     while (m_configureFile.at(start) != endList) {
         // Check if this is a function
-        uint end;
+        size_t end;
         if ((m_configureFile.at(start) == '$') && (m_configureFile.at(start + 1) == '(')) {
             // Skip $(
             start += 2;
             // Get function name
             end = m_configureFile.find_first_of(g_whiteSpace, start + 1);
-            string function = m_configureFile.substr(start, end - start);
+            const string_view function = m_configureFile.substr(start, end - start);
             // Check if this is a known function
             if (function == "find_things") {
                 // Get first parameter
                 start = m_configureFile.find_first_not_of(g_whiteSpace, end + 1);
                 end = m_configureFile.find_first_of(g_whiteSpace, start + 1);
-                string param1 = m_configureFile.substr(start, end - start);
+                string param1(m_configureFile.substr(start, end - start));
                 // Get second parameter
                 start = m_configureFile.find_first_not_of(g_whiteSpace, end + 1);
                 end = m_configureFile.find_first_of(g_whiteSpace, start + 1);
-                string param2 = m_configureFile.substr(start, end - start);
+                string param2(m_configureFile.substr(start, end - start));
                 // Get file name
                 start = m_configureFile.find_first_not_of(g_whiteSpace, end + 1);
-                end = m_configureFile.find_first_of(g_whiteSpace + ")", start + 1);
-                string param3 = m_configureFile.substr(start, end - start);
+                end = m_configureFile.find_first_of(paramEnd, start + 1);
+                string param3(m_configureFile.substr(start, end - start));
                 // Call function find_things
                 if (!passFindThings(param1, param2, param3, foundList)) {
                     return false;
@@ -1129,21 +1373,21 @@ bool ConfigGenerator::getConfigList(const string& list, vector<string>& returnLi
                 // Get first parameter
                 start = m_configureFile.find_first_not_of(g_whiteSpace, end + 1);
                 end = m_configureFile.find_first_of(g_whiteSpace, start + 1);
-                string param1 = m_configureFile.substr(start, end - start);
+                string param1(m_configureFile.substr(start, end - start));
                 // Get second parameter
                 start = m_configureFile.find_first_not_of(g_whiteSpace, end + 1);
                 end = m_configureFile.find_first_of(g_whiteSpace, start + 1);
-                string param2 = m_configureFile.substr(start, end - start);
+                string param2(m_configureFile.substr(start, end - start));
                 // Get file name
                 start = m_configureFile.find_first_not_of(g_whiteSpace, end + 1);
-                end = m_configureFile.find_first_of(g_whiteSpace + ")", start + 1);
-                string param3 = m_configureFile.substr(start, end - start);
+                end = m_configureFile.find_first_of(paramEnd, start + 1);
+                string param3(m_configureFile.substr(start, end - start));
                 // Check for optional 4th argument
                 string param4;
                 if ((m_configureFile.at(end) != ')') &&
                     (m_configureFile.at(m_configureFile.find_first_not_of(g_whiteSpace, end)) != ')')) {
                     start = m_configureFile.find_first_not_of(g_whiteSpace, end + 1);
-                    end = m_configureFile.find_first_of(g_whiteSpace + ")", start + 1);
+                    end = m_configureFile.find_first_of(paramEnd, start + 1);
                     param4 = m_configureFile.substr(start, end - start);
                 }
                 // Call function find_things
@@ -1156,11 +1400,11 @@ bool ConfigGenerator::getConfigList(const string& list, vector<string>& returnLi
                 // Get first parameter
                 start = m_configureFile.find_first_not_of(g_whiteSpace, end + 1);
                 end = m_configureFile.find_first_of(g_whiteSpace, start + 1);
-                string param1 = m_configureFile.substr(start, end - start);
+                string param1(m_configureFile.substr(start, end - start));
                 // Get second parameter
                 start = m_configureFile.find_first_not_of(g_whiteSpace, end + 1);
-                end = m_configureFile.find_first_of(g_whiteSpace + ")", start + 1);
-                string param2 = m_configureFile.substr(start, end - start);
+                end = m_configureFile.find_first_of(paramEnd, start + 1);
+                string param2(m_configureFile.substr(start, end - start));
                 // Call function add_suffix
                 if (!passAddSuffix(param1, param2, foundList)) {
                     return false;
@@ -1169,16 +1413,16 @@ bool ConfigGenerator::getConfigList(const string& list, vector<string>& returnLi
                 end = (m_configureFile.at(end) == ')') ? end + 1 : end;
             } else if (function == "filter_out") {
                 // This should filter out occurrence of first parameter from the list passed in the second
-                uint startSearch = start - list.length() - 5; // ensure search is before current instance of
+                size_t startSearch = start - list.length() - 5; // ensure search is before current instance of
                 // list
                 // Get first parameter
                 start = m_configureFile.find_first_not_of(g_whiteSpace, end + 1);
                 end = m_configureFile.find_first_of(g_whiteSpace, start + 1);
-                string param1 = m_configureFile.substr(start, end - start);
+                string param1(m_configureFile.substr(start, end - start));
                 // Get second parameter
                 start = m_configureFile.find_first_not_of(g_whiteSpace, end + 1);
-                end = m_configureFile.find_first_of(g_whiteSpace + ")", start + 1);
-                string param2 = m_configureFile.substr(start, end - start);
+                end = m_configureFile.find_first_of(paramEnd, start + 1);
+                string param2(m_configureFile.substr(start, end - start));
                 // Call function add_suffix
                 if (!passFilterOut(param1, param2, foundList, startSearch)) {
                     return false;
@@ -1188,8 +1432,8 @@ bool ConfigGenerator::getConfigList(const string& list, vector<string>& returnLi
             } else if (function == "find_filters_extern") {
                 // Get file name
                 start = m_configureFile.find_first_not_of(g_whiteSpace, end + 1);
-                end = m_configureFile.find_first_of(g_whiteSpace + ")", start + 1);
-                string param = m_configureFile.substr(start, end - start);
+                end = m_configureFile.find_first_of(paramEnd, start + 1);
+                string param(m_configureFile.substr(start, end - start));
                 // Call function find_filters_extern
                 if (!passFindFiltersExtern(param, foundList)) {
                     return false;
@@ -1197,24 +1441,22 @@ bool ConfigGenerator::getConfigList(const string& list, vector<string>& returnLi
                 // Make sure the closing ) is not included
                 end = (m_configureFile.at(end) == ')') ? end + 1 : end;
             } else {
-                outputError("Unknown list function (" + function + ") found in list (" + list + ")");
+                outputError("Unknown list function (" + string(function) + ") found in list (" + list + ")");
                 return false;
             }
         } else {
-            end = m_configureFile.find_first_of(g_whiteSpace + endList, start + 1);
+            end = m_configureFile.find_first_of(tagEnd, start + 1);
             // Get the tag
-            string tag = m_configureFile.substr(start, end - start);
+            const string_view tag = m_configureFile.substr(start, end - start);
             // Check the type of tag
             if (tag.at(0) == '$') {
-                // Strip the identifier
-                tag.erase(0, 1);
-                // Recursively pass
-                if (!getConfigList(tag, foundList, force, end)) {
+                // Recursively pass (stripping the identifier)
+                if (!getConfigList(string(tag.substr(1)), foundList, force, end)) {
                     return false;
                 }
             } else {
                 // Directly add the identifier
-                foundList.push_back(tag);
+                foundList.emplace_back(tag);
             }
         }
         start = m_configureFile.find_first_not_of(g_whiteSpace, end);
@@ -1224,9 +1466,8 @@ bool ConfigGenerator::getConfigList(const string& list, vector<string>& returnLi
         }
     }
     // Add the new list to the cache
-    if (currentFilePos == string::npos) {
-        m_cachedConfigLists[list] = foundList;
-    }
+    lock_guard<mutex> lock(g_cacheMutex);
+    m_cachedConfigLists[listStart] = foundList;
     returnList.insert(returnList.end(), foundList.begin(), foundList.end());
     return true;
 }
@@ -1234,19 +1475,46 @@ bool ConfigGenerator::getConfigList(const string& list, vector<string>& returnLi
 bool ConfigGenerator::passFindThings(const string& param1, const string& param2, const string& param3,
     vector<string>& returnList, vector<string>* returnExterns) const
 {
-    // Need to find and open the specified file
-    const string file = m_rootDirectory + param3;
-    string findFile;
-    if (!loadFromFile(file, findFile)) {
-        return false;
+    // Check if these parameters have already been searched for
+    const string key = param1 + ' ' + param2 + ' ' + param3 + ((returnExterns != nullptr) ? " externs" : "");
+    const FoundThings* cached = nullptr;
+    {
+        lock_guard<mutex> lock(g_cacheMutex);
+        const auto found = m_foundThings.find(key);
+        if (found != m_foundThings.end()) {
+            cached = &found->second;
+        }
+    }
+    if (cached == nullptr) {
+        // Need to find the specified file
+        const ComponentSource* source = getComponentSource(param3);
+        if (source == nullptr) {
+            return false;
+        }
+        FoundThings found;
+        passFindThingsSource(param1, param2, source->mapping.view(), found, returnExterns != nullptr);
+        lock_guard<mutex> lock(g_cacheMutex);
+        cached = &m_foundThings.emplace(key, found).first->second;
+    }
+    returnList.insert(returnList.end(), cached->list.begin(), cached->list.end());
+    if (returnExterns != nullptr) {
+        returnExterns->insert(returnExterns->end(), cached->externs.begin(), cached->externs.end());
     }
+    return true;
+}
+
+void ConfigGenerator::passFindThingsSource(
+    const string& param1, const string& param2, const string_view findFile, FoundThings& found, const bool externs)
+{
     string decl;
+    const string tagStart = g_whiteSpace + "(";
+    const string tagEnd = g_whiteSpace + ",);";
 
     // Find the search pattern in the file
-    uint start = findFile.find(param2);
+    size_t start = findFile.find(param2);
     while (start != string::npos) {
         // Find the start of the tag (also as ENCDEC should be treated as both DEC+ENC we skip that as well)
-        start = findFile.find_first_of(g_whiteSpace + "(", start + 1);
+        start = findFile.find_first_of(tagStart, start + 1);
         // Skip any filling white space
         start = findFile.find_first_not_of(" \t", start);
         // Check if valid
@@ -1257,21 +1525,22 @@ bool ConfigGenerator::passFindThings(const string& param1, const string& param2,
         }
         ++start;
         // Find end of tag
-        uint end = findFile.find_first_of(g_whiteSpace + ",);", start);
+        size_t end = findFile.find_first_of(tagEnd, start);
         if (findFile.at(end) != ',') {
             // Get next
             start = findFile.find(param2, end + 1);
             continue;
         }
         // Get the tag string
-        string tag = findFile.substr(start, end - start);
+        const string_view tag = findFile.substr(start, end - start);
         // Check to make sure this is a definition not a macro declaration
         if (tag == "X") {
-            if ((returnExterns != nullptr) && (decl.length() == 0)) {
+            if ((externs) && (decl.length() == 0)) {
                 // Get the first occurance of extern then till ; as that gives naming for export as well as type
                 start = findFile.find("extern ", end + 1) + 7;
                 end = findFile.find(';', start + 1);
                 decl = findFile.substr(start, end - start);
+                decl.erase(remove(decl.begin(), decl.end(), '\r'), decl.end());
                 start = decl.find("##");
                 while (start != string::npos) {
                     char cReplace = '@';
@@ -1289,26 +1558,15 @@ bool ConfigGenerator::passFindThings(const string& param1, const string& param2,
         }
         // Get second tag
         start = findFile.find_first_not_of(" \t", end + 1);
-        end = findFile.find_first_of(g_whiteSpace + ",);", start);
+        end = findFile.find_first_of(tagEnd, start);
         if ((findFile.at(end) != ')') && (findFile.at(end) != ',')) {
             // Get next
             start = findFile.find(param2, end + 1);
             continue;
         }
-        string tag2 = findFile.substr(start, end - start);
-        if (returnExterns == nullptr) {
-            // Check that both tags match
-            transform(tag2.begin(), tag2.end(), tag2.begin(), ::toupper);
-            if (tag2 != tag) {
-                // This is somewhat incorrect as the official configuration will always take the second tag
-                //  and create a config option out of it. This is actually incorrect as the source code itself
-                //  only uses the first parameter as the config option.
-                swap(tag, tag2);
-            }
-        }
-        transform(tag.begin(), tag.end(), tag.begin(), ::tolower);
+        const string_view tag2 = findFile.substr(start, end - start);
         // Add any requested externs
-        if (returnExterns != nullptr) {
+        if (externs) {
             // Create new extern by replacing tag with found one
             start = 0;
             string decTag = decl;
@@ -1320,13 +1578,13 @@ bool ConfigGenerator::passFindThings(const string& param1, const string& param2,
             if (decTag.find('$') != string::npos) {
                 // Get third tag
                 start = findFile.find_first_not_of(" \t", end + 1);
-                end = findFile.find_first_of(g_whiteSpace + ",);", start);
+                end = findFile.find_first_of(tagEnd, start);
                 if ((findFile.at(end) != ')') && (findFile.at(end) != ',')) {
                     // Get next
                     start = findFile.find(param2, end + 1);
                     continue;
                 }
-                string tag3 = findFile.substr(start, end - start);
+                const string_view tag3 = findFile.substr(start, end - start);
                 // Replace second tag
                 start = 0;
                 while ((start = decTag.find('$', start)) != std::string::npos) {
@@ -1336,80 +1594,50 @@ bool ConfigGenerator::passFindThings(const string& param1, const string& param2,
             }
 
             // Add to the list
-            returnExterns->push_back(decTag);
-        }
-        tag += "_" + param1;
+            found.externs.push_back(std::move(decTag));
+        }
+        // The official configuration will always take the second tag and create a config option out of it. This is
+        //  actually incorrect as the source code itself only uses the first parameter as the config option.
+        string option(externs ? tag : tag2);
+        transform(option.begin(), option.end(), option.begin(), ::tolower);
+        option += '_';
+        option += param1;
         // Add the new value to list
-        returnList.push_back(tag);
+        found.list.push_back(std::move(option));
         // Get next
         start = findFile.find(param2, end + 1);
     }
-    return true;
 }
 
 bool ConfigGenerator::passFindThingsExtern(const string& param1, const string& param2, const string& param3,
     const string& param4, vector<string>& returnList) const
 {
-    // Need to find and open the specified file
-    const string file = m_rootDirectory + param3;
-    string findFile;
-    if (!loadFromFile(file, findFile)) {
+    // Need to find the specified file
+    const ComponentSource* source = getComponentSource(param3);
+    if (source == nullptr) {
         return false;
     }
 
-    // Find the search pattern in the file
-    const string startSearch = "extern ";
-    uint start = findFile.find(startSearch);
-    while (start != string::npos) {
-        start += startSearch.length();
-        // Skip any occurrence of 'const'
-        if ((findFile.at(start) == 'c') && (findFile.find("const ", start) == start)) {
-            start += 6;
-        } else if ((findFile.at(start) == 'L') && (findFile.find("LIBX264_CONST ", start) == start)) {
-            // Hacky fix for detecting a macro define of const
-            start += 14;
-        }
-        if ((findFile.at(start) == 's') && (findFile.find("struct ", start) == start)) {
-            start += 7;
-        }
-        // Check for search tag
-        start = findFile.find_first_not_of(g_whiteSpace, start);
-        if ((findFile.at(start) != param2.at(0)) || (findFile.find(param2, start) != start)) {
-            // Get next
-            start = findFile.find(startSearch, start + 1);
-            continue;
-        }
-        start += param2.length() + 1;
-        start = findFile.find_first_not_of(g_whiteSpace, start);
-        // Check for function start
-        if ((findFile.at(start) != 'f') || (findFile.find("ff_", start) != start)) {
-            // Get next
-            start = findFile.find(startSearch, start + 1);
+    // Find each declaration of the searched for type
+    const string suffix = "_" + param1;
+    for (const auto& i : source->externs) {
+        if (i.type != param2) {
             continue;
         }
-        start += 3;
-        // Find end of tag
-        uint end = findFile.find_first_of(g_whiteSpace + ",();[]", start);
-        uint end2 = findFile.find("_" + param1, start);
-        end = (end2 < end) ? end2 : end;
-        if ((findFile.at(end) != '_') || (end2 != end)) {
-            // Get next
-            start = findFile.find(startSearch, end + 1);
+        // Get the tag string
+        const size_t end = i.name.find(suffix);
+        if (end == string::npos) {
             continue;
         }
-        // Get the tag string
-        end += 1 + param1.length();
-        string tag = findFile.substr(start, end - start);
+        string tag = i.name.substr(0, end + suffix.length());
         // Check for any 4th value replacements
         if (param4.length() > 0) {
-            const uint rep = tag.find("_" + param1);
-            tag.replace(rep, rep + 1 + param1.length(), "_" + param4);
+            const size_t rep = tag.find(suffix);
+            tag.replace(rep, rep + suffix.length(), "_" + param4);
         }
         // Add the new value to list
         transform(tag.begin(), tag.end(), tag.begin(), ::tolower);
         returnList.push_back(tag);
-        // Get next
-        start = findFile.find(startSearch, end + 1);
     }
     return true;
 }
@@ -1421,58 +1649,23 @@ bool ConfigGenerator::passFindFiltersExtern(const string& param1, vector<string>
     // s/^extern const AVFilter ff_[avfsinkrc]\{2,5\}_\([[:alnum:]_]\{1,\}\);/\1_filter/p
     // Changed in 7.2+ to:
     // s/^extern const FFFilter ff_[avfsinkrc]\{2,5\}_\([[:alnum:]_]\{1,\}\);/\1_filter/p
-    // Need to find and open the specified file
-    const string file = m_rootDirectory + param1;
-    string findFile;
-    if (!loadFromFile(file, findFile)) {
+    vector<const ComponentExtern*> filters;
+    if (!getFilterExterns(param1, filters)) {
         return false;
     }
-
-    // Find the search pattern in the file
-    string search = "extern const FFFilter ff_";
-    uint start = findFile.find(search);
-    if (start == string::npos) {
-        search = "extern const AVFilter ff_";
-        start = findFile.find(search);
-        if (start == string::npos) {
-            search = "extern AVFilter ff_";
-            start = findFile.find(search);
-        }
-    }
-    while (start != string::npos) {
-        // Find the start and end of the tag
-        start += search.length();
-        // Find end of tag
-        const uint end = findFile.find_first_of(g_whiteSpace + ",();", start);
-        // Get the tag string
-        string tag = findFile.substr(start, end - start);
-        // Get first part
-        start = tag.find('_');
-        if (start == string::npos) {
-            // Get next
-            start = findFile.find(search, end + 1);
-            continue;
-        }
-        const string first = tag.substr(0, start);
-        if (first.find_first_not_of("avfsinkrc") != string::npos) {
-            // Get next
-            start = findFile.find(search, end + 1);
-            continue;
-        }
+    for (const auto& i : filters) {
         // Get second part
-        tag = tag.substr(++start);
+        string tag = i->name.substr(i->name.find('_') + 1);
         transform(tag.begin(), tag.end(), tag.begin(), ::tolower);
         tag += "_filter";
         // Add the new value to list
         returnList.push_back(tag);
-        // Get next
-        start = findFile.find(search, end + 1);
     }
     return true;
 }
 
 bool ConfigGenerator::passAddSuffix(
-    const string& param1, const string& param2, vector<string>& returnList, const uint currentFilePos)
+    const string& param1, const string& param2, vector<string>& returnList, const size_t currentFilePos) const
 {
     // Convert the first parameter to upper case
     string param1Upper = param1;
@@ -1492,7 +1685,7 @@ bool ConfigGenerator::passAddSuffix(
 }
 
 bool ConfigGenerator::passFilterOut(
-    const string& param1, const string& param2, vector<string>& returnList, const uint currentFilePos)
+    const string& param1, const string& param2, vector<string>& returnList, const size_t currentFilePos) const
 {
     // Remove the "'" from the front and back of first parameter
     const string param1Cut = param1.substr(1, param1.length() - 2);
@@ -1519,54 +1712,119 @@ bool ConfigGenerator::passFullFilterName(const string& param1, string& returnStr
     // s/^extern const AVFilter ff_[avfsinkrc]\{2,5\}_\([[:alnum:]_]\{1,\}\);/\1_filter/p
     // Changed in 7.2+ to:
     // s/^extern const FFFilter ff_[avfsinkrc]\{2,5\}_\([[:alnum:]_]\{1,\}\);/\1_filter/p
-    // Need to find and open the specified file
-    const string file = m_rootDirectory + "libavfilter/allfilters.c";
-    string findFile;
-    if (!loadFromFile(file, findFile)) {
+    vector<const ComponentExtern*> filters;
+    if (!getFilterExterns("libavfilter/allfilters.c", filters)) {
         return false;
     }
+    for (const auto& i : filters) {
+        // Get second part
+        string second = i->name.substr(i->name.find('_') + 1);
+        transform(second.begin(), second.end(), second.begin(), ::tolower);
+        if (second == param1) {
+            returnString = i->name;
+            transform(returnString.begin(), returnString.end(), returnString.begin(), ::tolower);
+            return true;
+        }
+    }
+    return true;
+}
 
-    // Find the search pattern in the file
-    string search = "extern const FFFilter ff_";
-    uint start = findFile.find(search);
-    if (start == string::npos) {
-        search = "extern const AVFilter ff_";
-        start = findFile.find(search);
-        if (start == string::npos) {
-            search = "extern AVFilter ff_";
-            start = findFile.find(search);
+const ConfigGenerator::ComponentSource* ConfigGenerator::getComponentSource(const string& file) const
+{
+    {
+        lock_guard<mutex> lock(g_cacheMutex);
+        const auto source = m_componentRegistry.find(file);
+        if (source != m_componentRegistry.end()) {
+            return &source->second;
         }
     }
+    ComponentSource newSource;
+    if (!newSource.mapping.open(m_rootDirectory + file)) {
+        return nullptr;
+    }
+
+    // Find every extern declaration of a ff_ variable
+    const string_view findFile = newSource.mapping.view();
+    const string startSearch = "extern ";
+    size_t start = findFile.find(startSearch);
     while (start != string::npos) {
-        // Find the start and end of the tag
-        start += search.length();
-        // Find end of tag
-        const uint end = findFile.find_first_of(g_whiteSpace + ",();", start);
-        // Get the tag string
-        string tag = findFile.substr(start, end - start);
-        // Get first part
-        start = tag.find('_');
-        if (start == string::npos) {
-            // Get next
-            start = findFile.find(search, end + 1);
-            continue;
+        start += startSearch.length();
+        // Skip any occurrence of 'const'
+        bool isConst = false;
+        if (findFile.compare(start, 6, "const ") == 0) {
+            start += 6;
+            isConst = true;
+        } else if (findFile.compare(start, 14, "LIBX264_CONST ") == 0) {
+            // Hacky fix for detecting a macro define of const
+            start += 14;
+        }
+        if (findFile.compare(start, 7, "struct ") == 0) {
+            start += 7;
+        }
+        // Get the type
+        start = findFile.find_first_not_of(g_whiteSpace, start);
+        size_t end = findFile.find_first_of(g_whiteSpace + ",();[]", start);
+        if ((start == string::npos) || (end == string::npos)) {
+            break;
         }
-        const string first = tag.substr(0, start);
-        if (first.find_first_not_of("avfsinkrc") != string::npos) {
+        string type(findFile.substr(start, end - start));
+        // Check for variable start
+        start = findFile.find_first_not_of(g_whiteSpace, end);
+        if ((start == string::npos) || (findFile.compare(start, 3, "ff_") != 0)) {
             // Get next
-            start = findFile.find(search, end + 1);
+            start = findFile.find(startSearch, end);
             continue;
         }
-        // Get second part
-        string second = tag.substr(++start);
-        transform(second.begin(), second.end(), second.begin(), ::tolower);
-        if (second == param1) {
-            returnString = tag;
-            transform(returnString.begin(), returnString.end(), returnString.begin(), ::tolower);
-            return true;
+        start += 3;
+        // Find end of name
+        end = findFile.find_first_of(g_whiteSpace + ",();[]", start);
+        if (end == string::npos) {
+            break;
         }
+        newSource.externs.emplace_back(type, string(findFile.substr(start, end - start)), isConst);
         // Get next
-        start = findFile.find(search, end + 1);
+        start = findFile.find(startSearch, end + 1);
+    }
+    lock_guard<mutex> lock(g_cacheMutex);
+    return &m_componentRegistry.emplace(file, newSource).first->second;
+}
+
+bool ConfigGenerator::getFilterExterns(const string& file, vector<const ComponentExtern*>& returnList) const
+{
+    const ComponentSource* source = getComponentSource(file);
+    if (source == nullptr) {
+        return false;
+    }
+
+    // Find the declaration form used by the source
+    string type = "FFFilter";
+    bool isConst = true;
+    bool found = false;
+    const pair<string, bool> forms[] = {{"FFFilter", true}, {"AVFilter", true}, {"AVFilter", false}};
+    for (const auto& i : forms) {
+        for (const auto& j : source->externs) {
+            if ((j.type == i.first) && (j.isConst == i.second)) {
+                type = i.first;
+                isConst = i.second;
+                found = true;
+                break;
+            }
+        }
+        if (found) {
+            break;
+        }
+    }
+
+    for (const auto& i : source->externs) {
+        if ((i.type != type) || (i.isConst != isConst)) {
+            continue;
+        }
+        // Get first part
+        const size_t start = i.name.find('_');
+        if ((start == string::npos) || (i.name.find_first_not_of("avfsinkrc") < start)) {
+            continue;
+        }
+        returnList.push_back(&i);
     }
     return true;
 }
@@ -1581,13 +1839,31 @@ bool ConfigGenerator::passConfigList(const string& prefix, const string& suffix,
             string tag = i;
             transform(tag.begin(), tag.end(), tag.begin(), ::toupper);
             tag += suffix;
-            m_configValues.push_back(ConfigPair(tag, prefix, ""));
+            addConfigOption(tag, prefix);
         }
         return true;
     }
     return false;
 }
 
+size_t ConfigGenerator::addConfigOption(const string& option, const string& prefix)
+{
+    const size_t id = m_configValues.size();
+    m_configValues.push_back(ConfigPair(option, prefix));
+    m_configSet.resize(m_configValues.size());
+    m_configEnabled.resize(m_configValues.size());
+    m_optionIndex[option].push_back(id);
+    m_optionIndexPrefixed[prefix + option].push_back(id);
+    return id;
+}
+
+const vector<size_t>* ConfigGenerator::getConfigOptionIDs(const string& optionUpper, const bool prefixed) const
+{
+    const OptionIndex& index = (prefixed) ? m_optionIndexPrefixed : m_optionIndex;
+    const auto found = index.find(optionUpper);
+    return (found != index.end()) ? &found->second : nullptr;
+}
+
 bool ConfigGenerator::passEnabledComponents(
     const string& file, const string& structName, const string& name, const string& list)
 {
@@ -1627,24 +1903,24 @@ bool ConfigGenerator::passEnabledComponents(
             outputError("Unknown config option (" + i + ") found in component list (" + list + ")");
             continue;
         }
-        if (option->m_value == "1") {
+        if (isConfigValueEnabled(option)) {
             string optionLower = option->m_option;
             transform(optionLower.begin(), optionLower.end(), optionLower.begin(), ::tolower);
             // Check for device type replacements
             if (name == "indev_list") {
-                uint find = optionLower.find("_indev");
+                size_t find = optionLower.find("_indev");
                 if (find != string::npos) {
                     optionLower.resize(find);
                     optionLower += "_demuxer";
                 }
             } else if (name == "outdev_list") {
-                uint find = optionLower.find("_outdev");
+                size_t find = optionLower.find("_outdev");
                 if (find != string::npos) {
                     optionLower.resize(find);
                     optionLower += "_muxer";
                 }
             } else if (staticFilterList) {
-                uint find = optionLower.find("_filter");
+                size_t find = optionLower.find("_filter");
                 if (find != string::npos) {
                     optionLower.resize(find);
                 }
@@ -1682,104 +1958,168 @@ bool ConfigGenerator::fastToggleConfigValue(const string& option, const bool ena
     string optionUpper = option; // Ensure it is in upper case
     transform(optionUpper.begin(), optionUpper.end(), optionUpper.begin(), ::toupper);
     // Find in internal list
-    bool bRet = false;
+    const auto ids = getConfigOptionIDs(optionUpper);
+    if (ids == nullptr) {
+        return false;
+    }
     // Some options appear more than once with different prefixes
-    for (auto& i : m_configValues) {
-        if (i.m_option == optionUpper) {
-            if (weak && !i.m_value.empty()) {
-                continue;
-            }
-            i.m_value = (enable) ? "1" : "0";
-            bRet = true;
+    bool bRet = false;
+    for (const auto& id : *ids) {
+        if (weak && m_configSet.test(id)) {
+            continue;
         }
+        setConfigValue(id, enable);
+        bRet = true;
     }
     return bRet;
 }
 
-bool ConfigGenerator::toggleConfigValue(
-    const string& option, const bool enable, const bool weak, const bool deep, const bool recursive)
+bool ConfigGenerator::toggleConfigValue(const string& option, const bool enable, const bool weak, const bool deep)
 {
     string optionUpper = option; // Ensure it is in upper case
     transform(optionUpper.begin(), optionUpper.end(), optionUpper.begin(), ::toupper);
     // Find in internal list
-    bool ret = false;
-    // Some options appear more than once with different prefixes
-    for (auto& i : m_configValues) {
-        if (i.m_option == optionUpper) {
-            ret = true;
-            if (!i.m_lock) {
-                // Skip weak setting an already configured value
-                if (!!(weak && !i.m_value.empty())) {
-                    continue;
-                }
-                // Lock the item to prevent cyclic conditions
-                i.m_lock = true;
-                // Need to convert the name to lower case
-                string optionLower = option;
-                transform(optionLower.begin(), optionLower.end(), optionLower.begin(), ::tolower);
-                if (enable) {
-                    if (deep) {
-                        string checkFunc = optionLower + "_select";
-                        vector<string> checkList;
-                        if (getConfigList(checkFunc, checkList, false)) {
-                            for (const auto& j : checkList) {
-                                toggleConfigValue(j, true, weak, true);
-                            }
-                        }
+    const auto ids = getConfigOptionIDs(optionUpper);
+    if (ids == nullptr) {
+        bool depEnabled;
+        if (!getAdditionalDependency(option, depEnabled)) {
+            outputError("Unknown config option (" + option + ")");
+            return false;
+        }
+        return true;
+    }
+    // Need to convert the name to lower case
+    string optionLower = option;
+    transform(optionLower.begin(), optionLower.end(), optionLower.begin(), ::tolower);
 
-                        // If enabled then all of these should then be enabled if not already disabled
-                        checkFunc = optionLower + "_suggest";
-                        checkList.resize(0);
-                        if (getConfigList(checkFunc, checkList, false)) {
-                            for (const auto& j : checkList) {
-                                toggleConfigValue(j, true, true, true);
-                            }
-                        }
-                    }
+    // Process each toggle and any toggles it causes depth first
+    m_toggleTrace = ToggleTrace();
+    vector<ToggleFrame> toggles;
+    toggles.emplace_back(optionLower, enable, weak, deep, *ids);
+    while (!toggles.empty()) {
+        m_toggleTrace.maxDepth = (toggles.size() > m_toggleTrace.maxDepth) ? toggles.size() : m_toggleTrace.maxDepth;
+        ToggleFrame& toggle = toggles.back();
+        if (toggle.children == nullptr) {
+            // Some options appear more than once with different prefixes
+            for (; toggle.currentID < toggle.ids.size(); ++toggle.currentID) {
+                // Skip locked items and weak setting an already configured value
+                const size_t id = toggle.ids[toggle.currentID];
+                if (!m_configValues[id].m_lock && !(toggle.weak && m_configSet.test(id))) {
+                    break;
+                }
+            }
+            if (toggle.currentID == toggle.ids.size()) {
+                toggles.pop_back();
+                continue;
+            }
+            // Lock the item to prevent cyclic conditions
+            m_configValues[toggle.ids[toggle.currentID]].m_lock = true;
+            toggle.children = &getToggleExpansion(toggle.option, toggle.enable, toggle.deep);
+            toggle.currentChild = 0;
+            ++m_toggleTrace.expansions;
+        }
+        if (toggle.currentChild < toggle.children->size()) {
+            // Process the next dependent toggle before changing this items value
+            const ToggleChild& child = (*toggle.children)[toggle.currentChild];
+            ++toggle.currentChild;
+            if (child.fast) {
+                fastToggleConfigValue(child.option, child.enable);
+                continue;
+            }
+            vector<size_t> childIDs;
+            getToggleIDs(child.option, childIDs);
+            if (!childIDs.empty()) {
+                const bool childWeak = (child.inheritWeak) ? toggle.weak : child.weak;
+                toggles.emplace_back(child.option, child.enable, childWeak, true, childIDs);
+            }
+            continue;
+        }
+        // All dependent toggles have been processed so the items value can now be changed
+        const size_t id = toggle.ids[toggle.currentID];
+        if (!(toggle.weak && m_configSet.test(id))) {
+            setConfigValue(id, toggle.enable);
+        }
+        // Unlock item
+        m_configValues[id].m_lock = false;
+        ++toggle.currentID;
+        toggle.children = nullptr;
+    }
+    if (m_traceConfig) {
+        outputLine("  Trace: " + string((enable) ? "enable " : "disable ") + optionLower + ((weak) ? " (weak)" : "") +
+            " toggled " + to_string(m_toggleTrace.expansions) + " values using " +
+            to_string(m_toggleTrace.listLookups) + " list lookups with a max depth of " +
+            to_string(m_toggleTrace.maxDepth));
+    }
+    return true;
+}
 
-                    // Check for any hard dependencies that must be enabled
-                    vector<string> forceEnable;
-                    buildForcedEnables(optionLower, forceEnable);
-                    for (const auto& j : forceEnable) {
-                        toggleConfigValue(j, true, weak, true);
-                    }
-                } else if (!enable) {
-                    // Check for any hard dependencies that must be disabled
-                    vector<string> forceDisable;
-                    buildForcedDisables(optionLower, forceDisable);
-                    for (const auto& j : forceDisable) {
-                        toggleConfigValue(j, false, false, true);
-                    }
+const vector<ConfigGenerator::ToggleChild>& ConfigGenerator::getToggleExpansion(
+    const string& optionLower, const bool enable, const bool deep)
+{
+    const string key = optionLower + ((enable) ? ((deep) ? " deep" : " enable") : " disable");
+    const auto found = m_toggleExpansions.find(key);
+    if (found != m_toggleExpansions.end()) {
+        return found->second;
+    }
+    vector<ToggleChild> children;
+    if (enable) {
+        if (deep) {
+            vector<string> checkList;
+            ++m_toggleTrace.listLookups;
+            if (getConfigList(optionLower + "_select", checkList, false)) {
+                for (auto& j : checkList) {
+                    transform(j.begin(), j.end(), j.begin(), ::tolower);
+                    children.emplace_back(j, true, false, true);
                 }
-                if (!(weak && !i.m_value.empty())) {
-                    // Change the items value
-                    i.m_value = (enable) ? "1" : "0";
+            }
+
+            // If enabled then all of these should then be enabled if not already disabled
+            checkList.resize(0);
+            ++m_toggleTrace.listLookups;
+            if (getConfigList(optionLower + "_suggest", checkList, false)) {
+                for (auto& j : checkList) {
+                    transform(j.begin(), j.end(), j.begin(), ::tolower);
+                    children.emplace_back(j, true, true, false);
                 }
-                // Unlock item
-                i.m_lock = false;
             }
         }
-    }
-    if (!ret) {
-        DependencyList additionalDependencies;
-        buildAdditionalDependencies(additionalDependencies);
-        const auto dep = additionalDependencies.find(option);
-        if (recursive) {
-            // Ensure this is not already set
-            if (dep == additionalDependencies.end()) {
-                // Some options are passed in recursively that do not exist in internal list
-                // However there dependencies should still be processed
-                m_configValues.push_back(ConfigPair(optionUpper, "", ""));
-                outputInfo("Unlisted config dependency found (" + option + ")");
+
+        // Check for any hard dependencies that must be enabled
+        const auto forceEnable = getForcedToggles(optionLower, true);
+        if (forceEnable != nullptr) {
+            for (const auto& j : *forceEnable) {
+                children.emplace_back(j.option, true, false, true, j.fast);
             }
-        } else {
-            if (dep == additionalDependencies.end()) {
-                outputError("Unknown config option (" + option + ")");
-                return false;
+        }
+    } else {
+        // Check for any hard dependencies that must be disabled
+        const auto forceDisable = getForcedToggles(optionLower, false);
+        if (forceDisable != nullptr) {
+            for (const auto& j : *forceDisable) {
+                children.emplace_back(j.option, false, false, false, j.fast);
             }
         }
     }
-    return true;
+    return m_toggleExpansions.emplace(key, children).first->second;
+}
+
+void ConfigGenerator::getToggleIDs(const string& optionLower, vector<size_t>& ids)
+{
+    string optionUpper = optionLower;
+    transform(optionUpper.begin(), optionUpper.end(), optionUpper.begin(), ::toupper);
+    const auto found = getConfigOptionIDs(optionUpper);
+    if (found != nullptr) {
+        ids = *found;
+        return;
+    }
+    ids.resize(0);
+    bool depEnabled;
+    if (!getAdditionalDependency(optionLower, depEnabled)) {
+        // Some options are passed in as dependencies that do not exist in internal list
+        // These are added so that they can be set by any later toggles
+        addConfigOption(optionUpper, "");
+        outputInfo("Unlisted config dependency found (" + optionLower + ")");
+    }
 }
 
 ConfigGenerator::ValuesList::iterator ConfigGenerator::getConfigOption(const string& option)
@@ -1788,13 +2128,11 @@ ConfigGenerator::ValuesList::iterator ConfigGenerator::getConfigOption(const str
     string optionUpper = option;
     transform(optionUpper.begin(), optionUpper.end(), optionUpper.begin(), ::toupper);
     // Find in internal list
-    auto values = m_configValues.begin();
-    for (; values < m_configValues.end(); ++values) {
-        if (values->m_option == optionUpper) {
-            return values;
-        }
+    const auto ids = getConfigOptionIDs(optionUpper);
+    if (ids == nullptr) {
+        return m_configValues.end();
     }
-    return values;
+    return m_configValues.begin() + ids->front();
 }
 
 vector<ConfigGenerator::ConfigPair>::const_iterator ConfigGenerator::getConfigOption(const string& option) const
@@ -1803,13 +2141,11 @@ vector<ConfigGenerator::ConfigPair>::const_iterator ConfigGenerator::getConfigOp
     string optionUpper = option;
     transform(optionUpper.begin(), optionUpper.end(), optionUpper.begin(), ::toupper);
     // Find in internal list
-    auto values = m_configValues.begin();
-    for (; values < m_configValues.end(); ++values) {
-        if (values->m_option == optionUpper) {
-            return values;
-        }
+    const auto ids = getConfigOptionIDs(optionUpper);
+    if (ids == nullptr) {
+        return m_configValues.end();
     }
-    return values;
+    return m_configValues.begin() + ids->front();
 }
 
 ConfigGenerator::ValuesList::iterator ConfigGenerator::getConfigOptionPrefixed(const string& option)
@@ -1818,13 +2154,11 @@ ConfigGenerator::ValuesList::iterator ConfigGenerator::getConfigOptionPrefixed(c
     string optionUpper = option;
     transform(optionUpper.begin(), optionUpper.end(), optionUpper.begin(), ::toupper);
     // Find in internal list
-    auto values = m_configValues.begin();
-    for (; values < m_configValues.end(); ++values) {
-        if (optionUpper == values->m_prefix + values->m_option) {
-            return values;
-        }
+    const auto ids = getConfigOptionIDs(optionUpper, true);
+    if (ids == nullptr) {
+        return m_configValues.end();
     }
-    return values;
+    return m_configValues.begin() + ids->front();
 }
 
 ConfigGenerator::ValuesList::const_iterator ConfigGenerator::getConfigOptionPrefixed(const string& option) const
@@ -1833,19 +2167,110 @@ ConfigGenerator::ValuesList::const_iterator ConfigGenerator::getConfigOptionPref
     string optionUpper = option;
     transform(optionUpper.begin(), optionUpper.end(), optionUpper.begin(), ::toupper);
     // Find in internal list
-    auto values = m_configValues.begin();
-    for (; values < m_configValues.end(); ++values) {
-        if (optionUpper == values->m_prefix + values->m_option) {
-            return values;
+    const auto ids = getConfigOptionIDs(optionUpper, true);
+    if (ids == nullptr) {
+        return m_configValues.end();
+    }
+    return m_configValues.begin() + ids->front();
+}
+
+bool ConfigGenerator::getAdditionalDependency(const string& name, bool& enabled) const
+{
+    const auto dep = m_additionalDependencies.find(name);
+    if (dep == m_additionalDependencies.end()) {
+        return false;
+    }
+    enabled = (dep->second.id != string::npos) ? m_configEnabled.test(dep->second.id) : dep->second.enabled;
+    return true;
+}
+
+const vector<ConfigGenerator::ForcedToggle>* ConfigGenerator::getForcedToggles(
+    const string& optionLower, const bool enable) const
+{
+    const ForcedList& forced = (enable) ? m_forcedEnables : m_forcedDisables;
+    const auto found = forced.find(optionLower);
+    return (found != forced.end()) ? &found->second : nullptr;
+}
+
+bool ConfigGenerator::isConfigValueEnabled(const ValuesList::const_iterator option) const
+{
+    return isConfigIDEnabled(option - m_configValues.begin());
+}
+
+bool ConfigGenerator::isConfigValueDisabled(const ValuesList::const_iterator option) const
+{
+    return isConfigIDDisabled(option - m_configValues.begin());
+}
+
+bool ConfigGenerator::isConfigIDEnabled(const size_t id) const
+{
+    return m_configEnabled.test(id);
+}
+
+bool ConfigGenerator::isConfigIDDisabled(const size_t id) const
+{
+    return m_configSet.test(id) && !m_configEnabled.test(id);
+}
+
+string ConfigGenerator::getConfigValue(const ValuesList::const_iterator option) const
+{
+    const size_t id = option - m_configValues.begin();
+    if (!m_configSet.test(id)) {
+        return "";
+    }
+    return (m_configEnabled.test(id)) ? "1" : "0";
+}
+
+void ConfigGenerator::toggleConfigValues(const vector<string>& options, const bool enable, const bool weak)
+{
+    OptionBits toggleOptions;
+    toggleOptions.resize(m_configValues.size());
+    for (const auto& i : options) {
+        string optionUpper = i; // Ensure it is in upper case
+        transform(optionUpper.begin(), optionUpper.end(), optionUpper.begin(), ::toupper);
+        string optionLower = i;
+        transform(optionLower.begin(), optionLower.end(), optionLower.begin(), ::tolower);
+        const auto ids = getConfigOptionIDs(optionUpper);
+        if ((ids == nullptr) || (getForcedToggles(optionLower, enable) != nullptr)) {
+            // Unknown options and those with forced dependencies need to be individually processed
+            toggleConfigValue(i, enable, weak);
+            continue;
+        }
+        for (const auto& id : *ids) {
+            if (!m_configValues[id].m_lock) {
+                toggleOptions.set(id);
+            }
+        }
+    }
+    if (weak) {
+        // Skip any already configured values
+        toggleOptions.remove(m_configSet);
+    }
+    const size_t changed = setConfigValues(toggleOptions, enable);
+    if (m_traceConfig) {
+        outputLine("  Trace: " + string((enable) ? "enable " : "disable ") + to_string(options.size()) +
+            " listed options" + ((weak) ? " (weak)" : "") + " toggled " + to_string(changed) +
+            " values without dependent toggles");
+    }
+}
+
+void ConfigGenerator::buildOptionBits(const vector<string>& list, OptionBits& bits) const
+{
+    bits.resize(m_configValues.size());
+    for (const auto& i : list) {
+        string optionUpper = i; // Ensure it is in upper case
+        transform(optionUpper.begin(), optionUpper.end(), optionUpper.begin(), ::toupper);
+        const auto ids = getConfigOptionIDs(optionUpper);
+        if (ids != nullptr) {
+            bits.set(ids->front());
         }
     }
-    return values;
 }
 
 bool ConfigGenerator::isConfigOptionEnabled(const string& option) const
 {
     const auto opt = getConfigOption(option);
-    return (opt != m_configValues.end()) && (opt->m_value == "1");
+    return (opt != m_configValues.end()) && isConfigValueEnabled(opt);
 }
 
 bool ConfigGenerator::isConfigOptionValid(const string& option) const
@@ -1881,27 +2306,27 @@ bool ConfigGenerator::isSPIRVEnabled() const
         (isConfigOptionValidPrefixed("CONFIG_LIBGLSLANG") || isConfigOptionValidPrefixed("CONFIG_LIBSHADERC"));
 }
 
-bool ConfigGenerator::getMinWindowsVersion(uint& major, uint& minor) const
+bool ConfigGenerator::getMinWindowsVersion(size_t& major, size_t& minor) const
 {
     const string search = "cppflags -D_WIN32_WINNT=0x";
-    uint pos = m_configureFile.find(search);
-    uint majorT = 10; // Initially set minimum version to Win 10
-    uint minorT = 0;
+    size_t pos = m_configureFile.find(search);
+    size_t majorT = 10; // Initially set minimum version to Win 10
+    size_t minorT = 0;
     bool found = false;
     while (pos != string::npos) {
         pos += search.length();
-        const uint endPos = m_configureFile.find_first_of(g_nonName, pos);
+        const size_t endPos = m_configureFile.find_first_of(g_nonName, pos);
         // Check if valid version tag
         if ((endPos - pos) != 4) {
             outputInfo("Unknown windows version string found (" + search + ")");
         } else {
-            const string versionMajor = m_configureFile.substr(pos, 2);
+            const string versionMajor(m_configureFile.substr(pos, 2));
             // Convert to int from hex string
-            const uint major2 = stoul(versionMajor, nullptr, 16);
+            const size_t major2 = stoul(versionMajor, nullptr, 16);
             // Check if new version is less than current
             if (major2 <= majorT) {
-                const string versionMinor = m_configureFile.substr(pos + 2, 2);
-                const uint minor2 = stoul(versionMinor, nullptr, 16);
+                const string versionMinor(m_configureFile.substr(pos + 2, 2));
+                const size_t minor2 = stoul(versionMinor, nullptr, 16);
                 if ((major2 < majorT) || (minor2 < minorT)) {
                     // Update best found version
                     majorT = major2;
@@ -1920,276 +2345,366 @@ bool ConfigGenerator::getMinWindowsVersion(uint& major, uint& minor) const
     return found;
 }
 
-bool ConfigGenerator::passDependencyCheck(const ValuesList::iterator& option)
+bool ConfigGenerator::setConfigValue(const size_t id, const bool enable)
 {
-    // Need to convert the name to lower case
-    string optionLower = option->m_option;
-    transform(optionLower.begin(), optionLower.end(), optionLower.begin(), ::tolower);
+    if (!m_configSet.test(id) || (m_configEnabled.test(id) != enable)) {
+        // Only the value from before the first change is kept
+        m_changedValues.emplace(id, getConfigValue(m_configValues.begin() + id));
+        m_configSet.set(id);
+        m_configEnabled.set(id, enable);
+        return true;
+    }
+    return false;
+}
 
-    // Get list of additional dependencies
-    DependencyList additionalDependencies;
-    buildAdditionalDependencies(additionalDependencies);
+size_t ConfigGenerator::setConfigValues(const OptionBits& ids, const bool enable)
+{
+    size_t changed = 0;
+    for (size_t id = ids.findNext(0); id != string::npos; id = ids.findNext(id + 1)) {
+        if (setConfigValue(id, enable)) {
+            ++changed;
+        }
+    }
+    return changed;
+}
 
-    // Check if not enabled
-    if (option->m_value != "1") {
-        // Enabled if any of these
-        string checkFunc = optionLower + "_if_any";
-        vector<string> checkList;
-        bool valid = getConfigList(checkFunc, checkList, false);
-        // Also check if this has its own component list
-        string optionUpper = option->m_option;
-        transform(optionUpper.begin(), optionUpper.end(), optionUpper.begin(), ::toupper);
-        valid |= getConfigList(optionUpper + "_COMPONENTS", checkList, false);
-        if (valid) {
-            for (auto& i : checkList) {
-                // Check if this is a not !
-                bool bToggle = false;
-                if (i.at(0) == '!') {
-                    i.erase(0);
-                    bToggle = true;
-                }
-                bool enabled;
-                auto temp = getConfigOption(i);
-                if (temp == m_configValues.end()) {
-                    auto dep = additionalDependencies.find(i);
-                    if (dep == additionalDependencies.end()) {
-                        outputInfo("Unknown option in ifa dependency (" + i + ") for option (" + optionLower + ")");
-                        enabled = false;
-                    } else {
-                        enabled = dep->second ^ bToggle;
+void ConfigGenerator::buildDependencyGraph()
+{
+    const size_t startID = m_dependencyGraph.size();
+    if (startID == m_configValues.size()) {
+        return;
+    }
+    m_dependencyGraph.resize(m_configValues.size());
+    if (startID > 0) {
+        // Link any existing references to options that did not exist when they were created
+        for (size_t id = 0; id < startID; ++id) {
+            auto& node = m_dependencyGraph[id];
+            vector<DependencyRef>* lists[] = {
+                &node.ifAny, &node.ifAll, &node.deps, &node.depsAny, &node.conflict, &node.select};
+            for (auto& list : lists) {
+                for (auto& dep : *list) {
+                    if (dep.id != string::npos) {
+                        continue;
                     }
-                } else {
-                    // Check if this variable has been initialized already
-                    if (temp > option) {
-                        if (!passDependencyCheck(temp)) {
-                            return false;
-                        }
+                    string depUpper = dep.name;
+                    transform(depUpper.begin(), depUpper.end(), depUpper.begin(), ::toupper);
+                    const auto ids = getConfigOptionIDs(depUpper);
+                    if (ids != nullptr) {
+                        dep.id = ids->front();
+                        node.dependencies.push_back(dep.id);
+                        m_dependencyGraph[dep.id].dependents.push_back(id);
                     }
-                    enabled = (temp->m_value == "1") ^ bToggle;
-                }
-                if (enabled) {
-                    // If any deps are enabled then enable
-                    toggleConfigValue(optionLower, true, true);
-                    break;
                 }
             }
         }
     }
-    // Check if still not enabled
-    if (option->m_value != "1") {
-        // Should be enabled if all of these
-        string checkFunc = optionLower + "_if";
+    for (size_t id = startID; id < m_configValues.size(); ++id) {
+        // Need to convert the name to lower case
+        string optionLower = m_configValues[id].m_option;
+        transform(optionLower.begin(), optionLower.end(), optionLower.begin(), ::tolower);
+        string optionUpper = m_configValues[id].m_option;
+        transform(optionUpper.begin(), optionUpper.end(), optionUpper.begin(), ::toupper);
+        DependencyNode& node = m_dependencyGraph[id];
         vector<string> checkList;
-        if (getConfigList(checkFunc, checkList, false)) {
-            bool allEnabled = true;
-            for (auto& i : checkList) {
-                // Check if this is a not !
-                bool toggle = false;
-                if (i.at(0) == '!') {
-                    i.erase(0);
-                    toggle = true;
-                }
-                auto temp = getConfigOption(i);
-                if (temp == m_configValues.end()) {
-                    auto dep = additionalDependencies.find(i);
-                    if (dep == additionalDependencies.end()) {
-                        outputInfo("Unknown option in if dependency (" + i + ") for option (" + optionLower + ")");
-                        allEnabled = false;
-                    } else {
-                        allEnabled = dep->second ^ toggle;
-                    }
-                } else {
-                    // Check if this variable has been initialized already
-                    if (temp > option) {
-                        if (!passDependencyCheck(temp)) {
-                            return false;
-                        }
-                    }
-                    allEnabled = (temp->m_value == "1") ^ toggle;
+        // Enabled if any of these. Also check if this has its own component list
+        getConfigList(optionLower + "_if_any", checkList, false);
+        getConfigList(optionUpper + "_COMPONENTS", checkList, false);
+        buildDependencyRefs(checkList, node.ifAny, node.dependencies);
+        // Should be enabled if all of these
+        checkList.resize(0);
+        node.hasIfAll = getConfigList(optionLower + "_if", checkList, false);
+        buildDependencyRefs(checkList, node.ifAll, node.dependencies);
+        // The following are the needed dependencies that must be enabled
+        checkList.resize(0);
+        getConfigList(optionLower + "_deps", checkList, false);
+        buildDependencyRefs(checkList, node.deps, node.dependencies);
+        // Any 1 of the following dependencies are needed
+        checkList.resize(0);
+        node.hasDepsAny = getConfigList(optionLower + "_deps_any", checkList, false);
+        buildDependencyRefs(checkList, node.depsAny, node.dependencies);
+        // If conflict items are enabled then this one must be disabled
+        checkList.resize(0);
+        getConfigList(optionLower + "_conflict", checkList, false);
+        buildDependencyRefs(checkList, node.conflict, node.dependencies);
+        // All select items are enabled when this item is enabled
+        checkList.resize(0);
+        getConfigList(optionLower + "_select", checkList, false);
+        buildDependencyRefs(checkList, node.select, node.dependencies);
+    }
+    // Update reverse links for the new options
+    for (size_t id = startID; id < m_configValues.size(); ++id) {
+        for (const auto& dep : m_dependencyGraph[id].dependencies) {
+            m_dependencyGraph[dep].dependents.push_back(id);
+        }
+    }
+    buildDependencyOrder();
+}
+
+void ConfigGenerator::buildDependencyRefs(
+    const vector<string>& list, vector<DependencyRef>& refs, vector<size_t>& dependencies)
+{
+    for (const auto& i : list) {
+        // Check if this is a not !
+        const bool toggle = (i.at(0) == '!');
+        string name = (toggle) ? i.substr(1) : i;
+        string nameUpper = name;
+        transform(nameUpper.begin(), nameUpper.end(), nameUpper.begin(), ::toupper);
+        const auto ids = getConfigOptionIDs(nameUpper);
+        size_t id = string::npos;
+        if (ids != nullptr) {
+            id = ids->front();
+            dependencies.push_back(id);
+        }
+        refs.emplace_back(name, id, toggle);
+    }
+}
+
+void ConfigGenerator::buildDependencyOrder()
+{
+    // Uses Tarjan's algorithm to find each group of cyclic options. Groups are found in reverse topological order
+    // which means each group is only found after all of the groups that it depends on.
+    const size_t count = m_dependencyGraph.size();
+    vector<size_t> index(count, string::npos);
+    vector<size_t> lowLink(count, 0);
+    vector<bool> onStack(count, false);
+    vector<size_t> stack;
+    vector<pair<size_t, size_t>> searchStack; // Pair of option ID and next dependency to check
+    size_t nextIndex = 0;
+    m_dependencyOrder.resize(0);
+    m_dependencyOrder.reserve(count);
+    for (size_t root = 0; root < count; ++root) {
+        if (index[root] != string::npos) {
+            continue;
+        }
+        index[root] = lowLink[root] = nextIndex++;
+        stack.push_back(root);
+        onStack[root] = true;
+        searchStack.emplace_back(root, 0);
+        while (!searchStack.empty()) {
+            const size_t id = searchStack.back().first;
+            const auto& dependencies = m_dependencyGraph[id].dependencies;
+            if (searchStack.back().second < dependencies.size()) {
+                const size_t dep = dependencies[searchStack.back().second++];
+                if (index[dep] == string::npos) {
+                    // Search the dependency before continuing with this option
+                    index[dep] = lowLink[dep] = nextIndex++;
+                    stack.push_back(dep);
+                    onStack[dep] = true;
+                    searchStack.emplace_back(dep, 0);
+                } else if (onStack[dep]) {
+                    lowLink[id] = min(lowLink[id], index[dep]);
                 }
-                if (!allEnabled) {
-                    break;
+                continue;
+            }
+            if (lowLink[id] == index[id]) {
+                // Found a complete group, options within a group are ordered by ID
+                const size_t groupStart = m_dependencyOrder.size();
+                size_t member;
+                do {
+                    member = stack.back();
+                    stack.pop_back();
+                    onStack[member] = false;
+                    m_dependencyOrder.push_back(member);
+                } while (member != id);
+                sort(m_dependencyOrder.begin() + groupStart, m_dependencyOrder.end());
+            }
+            searchStack.pop_back();
+            if (!searchStack.empty()) {
+                const size_t parent = searchStack.back().first;
+                lowLink[parent] = min(lowLink[parent], lowLink[id]);
+            }
+        }
+    }
+    m_dependencyRank.resize(count);
+    for (size_t rank = 0; rank < count; ++rank) {
+        m_dependencyRank[m_dependencyOrder[rank]] = rank;
+    }
+}
+
+bool ConfigGenerator::passDependencyChecks(const vector<size_t>& options)
+{
+    buildDependencyGraph();
+
+    // Work through each option in dependency order
+    set<size_t> workList;
+    for (const auto& id : options) {
+        workList.insert(m_dependencyRank[id]);
+    }
+    vector<size_t> checks(m_dependencyGraph.size(), 0);
+    while (!workList.empty()) {
+        const size_t id = m_dependencyOrder[*workList.begin()];
+        workList.erase(workList.begin());
+        // Options that are part of a dependency cycle may need to be checked multiple times until they settle. The
+        // limit scales with the graph so that long chains of changes are never cut short, any option checked more
+        // often than there are options is part of a cycle whose values never settle.
+        if (checks[id] >= m_dependencyGraph.size()) {
+            outputError("Option (" + m_configValues[id].m_option + ") dependencies did not settle due to a cyclic "
+                "dependency");
+            return false;
+        }
+        ++checks[id];
+        m_changedValues.clear();
+        if (!passDependencyCheck(id)) {
+            return false;
+        }
+        if (m_configValues.size() > m_dependencyGraph.size()) {
+            // New unlisted options were found so they need to be added and checked as well
+            vector<size_t> pending;
+            for (const auto& rank : workList) {
+                pending.push_back(m_dependencyOrder[rank]);
+            }
+            for (size_t newID = m_dependencyGraph.size(); newID < m_configValues.size(); ++newID) {
+                pending.push_back(newID);
+            }
+            buildDependencyGraph();
+            checks.resize(m_dependencyGraph.size(), 0);
+            workList.clear();
+            for (const auto& pendingID : pending) {
+                workList.insert(m_dependencyRank[pendingID]);
+            }
+        }
+        // Any option that was changed and any options that depend on it must be (re)checked
+        for (const auto& changed : m_changedValues) {
+            if (getConfigValue(m_configValues.begin() + changed.first) == changed.second) {
+                continue;
+            }
+            if (changed.first != id) {
+                // The changed option may now fail its own dependencies
+                workList.insert(m_dependencyRank[changed.first]);
+            }
+            for (const auto& dependent : m_dependencyGraph[changed.first].dependents) {
+                if (dependent != id) {
+                    workList.insert(m_dependencyRank[dependent]);
                 }
             }
-            if (allEnabled) {
-                // If all deps are enabled then enable
+        }
+    }
+    m_changedValues.clear();
+    return true;
+}
+
+bool ConfigGenerator::isDependencyEnabled(const DependencyRef& dep, const string& type, const string& optionLower) const
+{
+    if (dep.id != string::npos) {
+        return m_configEnabled.test(dep.id) ^ dep.toggle;
+    }
+    bool enabled;
+    if (!getAdditionalDependency(dep.name, enabled)) {
+        outputInfo("Unknown option in " + type + "dependency (" + dep.name + ") for option (" + optionLower + ")");
+        return false;
+    }
+    return enabled ^ dep.toggle;
+}
+
+bool ConfigGenerator::passDependencyCheck(const size_t id)
+{
+    // Need to convert the name to lower case
+    string optionLower = m_configValues[id].m_option;
+    transform(optionLower.begin(), optionLower.end(), optionLower.begin(), ::tolower);
+    const DependencyNode& node = m_dependencyGraph[id];
+
+    // Check if not enabled
+    if (!m_configEnabled.test(id)) {
+        // Enabled if any of these
+        for (const auto& i : node.ifAny) {
+            if (isDependencyEnabled(i, "ifa ", optionLower)) {
+                // If any deps are enabled then enable
                 toggleConfigValue(optionLower, true, true);
+                break;
+            }
+        }
+    }
+    // Check if still not enabled
+    if (!m_configEnabled.test(id) && node.hasIfAll) {
+        // Should be enabled if all of these
+        bool allEnabled = true;
+        for (const auto& i : node.ifAll) {
+            if (!isDependencyEnabled(i, "if ", optionLower)) {
+                allEnabled = false;
+                break;
             }
         }
+        if (allEnabled) {
+            // If all deps are enabled then enable
+            toggleConfigValue(optionLower, true, true);
+        }
     }
     // Perform dependency check if not disabled
-    if (option->m_value != "0") {
+    if (m_configEnabled.test(id) || !m_configSet.test(id)) {
         // The following are the needed dependencies that must be enabled
-        string checkFunc = optionLower + "_deps";
-        vector<string> checkList;
-        if (getConfigList(checkFunc, checkList, false)) {
-            for (auto& i : checkList) {
-                // Check if this is a not !
-                bool toggle = false;
-                if (i.at(0) == '!') {
-                    i.erase(0, 1);
-                    toggle = true;
-                }
-                bool enabled;
-                auto temp = getConfigOption(i);
-                if (temp == m_configValues.end()) {
-                    auto dep = additionalDependencies.find(i);
-                    if (dep == additionalDependencies.end()) {
-                        outputInfo("Unknown option in dependency (" + i + ") for option (" + optionLower + ")");
-                        enabled = false;
-                    } else {
-                        enabled = dep->second ^ toggle;
-                    }
-                } else {
-                    // Check if this variable has been initialized already
-                    if (temp > option) {
-                        if (!passDependencyCheck(temp)) {
-                            return false;
-                        }
-                    }
-                    enabled = (temp->m_value == "1") ^ toggle;
-                }
+        for (const auto& i : node.deps) {
+            if (!isDependencyEnabled(i, "", optionLower)) {
                 // If not all deps are enabled then disable
-                if (!enabled) {
-                    toggleConfigValue(optionLower, false);
-                    outputInfo("Option (" + optionLower + ") was disabled due to an unmet dependency (" + i + ')');
-                    break;
-                }
+                toggleConfigValue(optionLower, false);
+                outputInfo("Option (" + optionLower + ") was disabled due to an unmet dependency (" + i.name + ')');
+                break;
             }
         }
     }
     // Perform dependency check if not disabled
-    if (option->m_value != "0") {
+    if ((m_configEnabled.test(id) || !m_configSet.test(id)) && node.hasDepsAny) {
         // Any 1 of the following dependencies are needed
-        string checkFunc = optionLower + "_deps_any";
-        vector<string> checkList;
-        if (getConfigList(checkFunc, checkList, false)) {
-            bool anyEnabled = false;
-            for (auto& i : checkList) {
-                // Check if this is a not !
-                bool toggle = false;
-                if (i.at(0) == '!') {
-                    i.erase(0);
-                    toggle = true;
-                }
-                auto temp = getConfigOption(i);
-                if (temp == m_configValues.end()) {
-                    auto dep = additionalDependencies.find(i);
-                    if (dep == additionalDependencies.end()) {
-                        outputInfo("Unknown option in any dependency (" + i + ") for option (" + optionLower + ")");
-                        anyEnabled = false;
-                    } else {
-                        anyEnabled = dep->second ^ toggle;
-                    }
-                } else {
-                    // Check if this variable has been initialized already
-                    if (temp > option) {
-                        if (!passDependencyCheck(temp)) {
-                            return false;
-                        }
-                    }
-                    anyEnabled = (temp->m_value == "1") ^ toggle;
-                }
-                if (anyEnabled) {
-                    break;
-                }
+        bool anyEnabled = false;
+        for (const auto& i : node.depsAny) {
+            if (isDependencyEnabled(i, "any ", optionLower)) {
+                anyEnabled = true;
+                break;
             }
-            if (!anyEnabled) {
-                // If not a single dep is enabled then disable
-                toggleConfigValue(optionLower, false);
-                string deps;
-                for (const auto& j : checkList) {
-                    if (!deps.empty()) {
-                        deps += ',';
-                    }
-                    deps += j;
+        }
+        if (!anyEnabled) {
+            // If not a single dep is enabled then disable
+            toggleConfigValue(optionLower, false);
+            string deps;
+            for (const auto& j : node.depsAny) {
+                if (!deps.empty()) {
+                    deps += ',';
                 }
-                outputInfo("Option (" + optionLower + ") was disabled due to an unmet any dependency (" + deps + ')');
+                deps += j.name;
             }
+            outputInfo("Option (" + optionLower + ") was disabled due to an unmet any dependency (" + deps + ')');
         }
     }
     // Perform dependency check if not disabled
-    if (option->m_value != "0") {
+    if (m_configEnabled.test(id) || !m_configSet.test(id)) {
         // If conflict items are enabled then this one must be disabled
-        string checkFunc = optionLower + "_conflict";
-        vector<string> checkList;
-        if (getConfigList(checkFunc, checkList, false)) {
-            bool anyEnabled = false;
-            for (auto& i : checkList) {
-                // Check if this is a not !
-                bool toggle = false;
-                if (i.at(0) == '!') {
-                    i.erase(0);
-                    toggle = true;
-                }
-                auto temp = getConfigOption(i);
-                if (temp == m_configValues.end()) {
-                    auto dep = additionalDependencies.find(i);
-                    if (dep == additionalDependencies.end()) {
-                        outputInfo(
-                            "Unknown option in conflict dependency (" + i + ") for option (" + optionLower + ")");
-                        anyEnabled = false;
-                    } else {
-                        anyEnabled = dep->second ^ toggle;
-                    }
-                } else {
-                    // Check if this variable has been initialized already
-                    if (temp > option) {
-                        if (!passDependencyCheck(temp)) {
-                            return false;
-                        }
-                    }
-                    anyEnabled = (temp->m_value == "1") ^ toggle;
-                }
-                if (anyEnabled) {
-                    // If a single conflict is enabled then disable
-                    toggleConfigValue(optionLower, false);
-                    outputInfo("Option (" + optionLower + ") was disabled due to an conflict dependency (" + i + ')');
-                    break;
-                }
+        for (const auto& i : node.conflict) {
+            if (isDependencyEnabled(i, "conflict ", optionLower)) {
+                // If a single conflict is enabled then disable
+                toggleConfigValue(optionLower, false);
+                outputInfo(
+                    "Option (" + optionLower + ") was disabled due to an conflict dependency (" + i.name + ')');
+                break;
             }
         }
     }
     // Perform dependency check if not disabled
-    if (option->m_value != "0") {
+    if (m_configEnabled.test(id) || !m_configSet.test(id)) {
         // All select items are enabled when this item is enabled. If one of them has since been disabled then so must
         // this one
-        string checkFunc = optionLower + "_select";
-        vector<string> checkList;
-        if (getConfigList(checkFunc, checkList, false)) {
-            for (auto& i : checkList) {
-                auto temp = getConfigOption(i);
-                if (temp == m_configValues.end()) {
-                    auto dep = additionalDependencies.find(i);
-                    if (dep == additionalDependencies.end()) {
-                        outputInfo("Unknown option in select dependency (" + i + ") for option (" + optionLower + ")");
-                    } else if (!dep->second) {
-                        // If any deps are disabled then disable
-                        toggleConfigValue(optionLower, false);
-                        outputInfo(
-                            "Option (" + optionLower + ") was disabled due to an unmet select dependency (" + i + ')');
-                        break;
-                    }
-                    continue;
-                }
-                // Check if this variable has been initialized already
-                if (temp > option) {
-                    if (!passDependencyCheck(temp)) {
-                        return false;
-                    }
-                }
-                if (temp->m_value == "0") {
-                    // If any deps are disabled then disable
-                    toggleConfigValue(optionLower, false);
+        for (const auto& i : node.select) {
+            bool disabled;
+            if (i.id != string::npos) {
+                disabled = m_configSet.test(i.id) && !m_configEnabled.test(i.id);
+            } else {
+                bool enabled;
+                if (!getAdditionalDependency(i.name, enabled)) {
                     outputInfo(
-                        "Option (" + optionLower + ") was disabled due to an unmet select dependency (" + i + ')');
-                    break;
+                        "Unknown option in select dependency (" + i.name + ") for option (" + optionLower + ")");
+                    continue;
                 }
+                disabled = !enabled;
+            }
+            if (disabled) {
+                // If any deps are disabled then disable
+                toggleConfigValue(optionLower, false);
+                outputInfo(
+                    "Option (" + optionLower + ") was disabled due to an unmet select dependency (" + i.name + ')');
+                break;
             }
         }
     }
     // Enable any required deps if still enabled
-    if (option->m_value == "1") {
+    if (m_configEnabled.test(id)) {
         // Perform a deep enable
         fastToggleConfigValue(optionLower, false);
         toggleConfigValue(optionLower, true, false, true);
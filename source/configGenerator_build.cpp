@@ -21,8 +21,9 @@
 #include "configGenerator.h"
 
 #include <algorithm>
+#include <cctype>
 
-bool ConfigGenerator::buildDefaultValues()
+void ConfigGenerator::buildDefaultDirectories()
 {
     // Set any unset project values
     if (m_solutionDirectory.length() == 0) {
@@ -35,7 +36,10 @@ bool ConfigGenerator::buildDefaultValues()
     if (m_outDirectory.length() == 0) {
         m_outDirectory = "../../../msvc/";
     }
+}
 
+bool ConfigGenerator::buildDefaultValues()
+{
     // Bulk disable most common options. The ones that are actually available will be set later
     vector<string> list;
     vector<string> archLists = {"ARCH_LIST", "HAVE_LIST", "DOCUMENT_LIST", "FEATURE_LIST", "EXAMPLE_LIST"};
@@ -76,7 +80,7 @@ bool ConfigGenerator::buildDefaultValues()
             fastToggleConfigValue(i, true);
             // Get the corresponding list and enable all member elements as well
             i.resize(i.length() - 1); // Need to remove the s from end
-            transform(i.begin(), i.end(), i.begin(), toupper);
+            transform(i.begin(), i.end(), i.begin(), ::toupper);
             // Get the specific list
             list2.resize(0);
             if (getConfigList(i + "_LIST", list2)) {
@@ -263,7 +267,7 @@ bool ConfigGenerator::buildDefaultValues()
 
     // Check if auto detection is enabled
     const auto autoDet = getConfigOption("autodetect");
-    if ((autoDet == m_configValues.end()) || (autoDet->m_value != "0")) {
+    if ((autoDet == m_configValues.end()) || !isConfigValueDisabled(autoDet)) {
         // Enable all the auto detected libs
         vector<string> list;
         if (getConfigList("AUTODETECT_LIBS", list)) {
@@ -297,154 +301,165 @@ bool ConfigGenerator::buildDefaultValues()
     return buildForcedValues();
 }
 
-bool ConfigGenerator::buildAutoDetectValues()
+void ConfigGenerator::buildAutoDetectLibs()
 {
-    // Check if auto detection is enabled
-    const auto autoDet = getConfigOption("autodetect");
-    if ((autoDet != m_configValues.end())) {
-        // Enable/Disable all the auto detected libs
-        const bool enableAuto = (autoDet->m_value != "0");
-        vector<string> list;
-        if (getConfigList("AUTODETECT_LIBS", list)) {
-            string sFileName;
-            for (const auto& i : list) {
-                bool enable;
-                // Handle detection of various libs
-                if (i == "alsa") {
-                    enable = false;
-                } else if (i == "amf") {
-                    makeFileGeneratorRelative(m_outDirectory + "include/AMF/core/Factory.h", sFileName);
-                    enable = findFile(sFileName, sFileName);
-                } else if (i == "appkit") {
-                    enable = false;
-                } else if (i == "audiotoolbox") {
-                    enable = false;
-                } else if (i == "avfoundation") {
-                    enable = false;
-                } else if (i == "bzlib") {
-                    makeFileGeneratorRelative(m_outDirectory + "include/bzlib.h", sFileName);
-                    enable = findFile(sFileName, sFileName);
-                } else if (i == "coreimage") {
-                    enable = false;
-                } else if (i == "crystalhd") {
-                    enable = false;
-                } else if (i == "cuda" || i == "cuvid") {
-                    enable = (findFile(m_rootDirectory + "compat/cuda/dynlink_loader.h", sFileName) &&
-                        findFile(m_rootDirectory + "compat/cuda/dynlink_cuda.h", sFileName));
-                    if (!enable) {
-                        makeFileGeneratorRelative(m_outDirectory + "include/ffnvcodec/dynlink_cuda.h", sFileName);
-                        enable = findFile(sFileName, sFileName);
-                    }
-                } else if (i == "cuda_llvm" || i == "cuda_nvcc") {
-                    // Not currently supported
-                    enable = false;
-                } else if (i == "d3d12va") {
-                    enable = true;
-                } else if (i == "d3d11va") {
-                    enable = true;
-                } else if (i == "dxva2") {
-                    enable = true;
-                } else if (i == "ffnvcodec") {
+    m_autoDetectLibs.resize(0);
+    if (getConfigOption("autodetect") == m_configValues.end()) {
+        return;
+    }
+    vector<string> list;
+    if (getConfigList("AUTODETECT_LIBS", list)) {
+        string sFileName;
+        for (const auto& i : list) {
+            bool enable;
+            // Handle detection of various libs
+            if (i == "alsa") {
+                enable = false;
+            } else if (i == "amf") {
+                makeFileGeneratorRelative(m_outDirectory + "include/AMF/core/Factory.h", sFileName);
+                enable = findFile(sFileName, sFileName);
+            } else if (i == "appkit") {
+                enable = false;
+            } else if (i == "audiotoolbox") {
+                enable = false;
+            } else if (i == "avfoundation") {
+                enable = false;
+            } else if (i == "bzlib") {
+                makeFileGeneratorRelative(m_outDirectory + "include/bzlib.h", sFileName);
+                enable = findFile(sFileName, sFileName);
+            } else if (i == "coreimage") {
+                enable = false;
+            } else if (i == "crystalhd") {
+                enable = false;
+            } else if (i == "cuda" || i == "cuvid") {
+                enable = (findFile(m_rootDirectory + "compat/cuda/dynlink_loader.h", sFileName) &&
+                    findFile(m_rootDirectory + "compat/cuda/dynlink_cuda.h", sFileName));
+                if (!enable) {
                     makeFileGeneratorRelative(m_outDirectory + "include/ffnvcodec/dynlink_cuda.h", sFileName);
                     enable = findFile(sFileName, sFileName);
-                } else if (i == "iconv") {
-                    makeFileGeneratorRelative(m_outDirectory + "include/iconv.h", sFileName);
-                    enable = findFile(sFileName, sFileName);
-                } else if (i == "jack") {
-                    enable = false;
-                } else if (i == "libdrm") {
-                    enable = false;
-                } else if (i == "libxcb") {
-                    enable = false;
-                } else if (i == "libxcb_shm") {
-                    enable = false;
-                } else if (i == "libxcb_shape") {
-                    enable = false;
-                } else if (i == "libxcb_xfixes") {
-                    enable = false;
-                } else if (i == "lzma") {
-                    makeFileGeneratorRelative(m_outDirectory + "include/lzma.h", sFileName);
+                }
+            } else if (i == "cuda_llvm" || i == "cuda_nvcc") {
+                // Not currently supported
+                enable = false;
+            } else if (i == "d3d12va") {
+                enable = true;
+            } else if (i == "d3d11va") {
+                enable = true;
+            } else if (i == "dxva2") {
+                enable = true;
+            } else if (i == "ffnvcodec") {
+                makeFileGeneratorRelative(m_outDirectory + "include/ffnvcodec/dynlink_cuda.h", sFileName);
+                enable = findFile(sFileName, sFileName);
+            } else if (i == "iconv") {
+                makeFileGeneratorRelative(m_outDirectory + "include/iconv.h", sFileName);
+                enable = findFile(sFileName, sFileName);
+            } else if (i == "jack") {
+                enable = false;
+            } else if (i == "libdrm") {
+                enable = false;
+            } else if (i == "libxcb") {
+                enable = false;
+            } else if (i == "libxcb_shm") {
+                enable = false;
+            } else if (i == "libxcb_shape") {
+                enable = false;
+            } else if (i == "libxcb_xfixes") {
+                enable = false;
+            } else if (i == "lzma") {
+                makeFileGeneratorRelative(m_outDirectory + "include/lzma.h", sFileName);
+                enable = findFile(sFileName, sFileName);
+            } else if (i == "mediafoundation") {
+                enable = true;
+            } else if (i == "metal") {
+                enable = false;
+            } else if (i == "nvdec") {
+                enable = (findFile(m_rootDirectory + "compat/cuda/dynlink_loader.h", sFileName) &&
+                    findFile(m_rootDirectory + "compat/cuda/dynlink_cuda.h", sFileName));
+                if (!enable) {
+                    makeFileGeneratorRelative(m_outDirectory + "include/ffnvcodec/dynlink_loader.h", sFileName);
                     enable = findFile(sFileName, sFileName);
-                } else if (i == "mediafoundation") {
-                    enable = true;
-                } else if (i == "metal") {
-                    enable = false;
-                } else if (i == "nvdec") {
-                    enable = (findFile(m_rootDirectory + "compat/cuda/dynlink_loader.h", sFileName) &&
-                        findFile(m_rootDirectory + "compat/cuda/dynlink_cuda.h", sFileName));
-                    if (!enable) {
-                        makeFileGeneratorRelative(m_outDirectory + "include/ffnvcodec/dynlink_loader.h", sFileName);
-                        enable = findFile(sFileName, sFileName);
-                    }
-                } else if (i == "nvenc") {
-                    enable = findFile(m_rootDirectory + "compat/nvenc/nvEncodeAPI.h", sFileName);
-                    if (!enable) {
-                        makeFileGeneratorRelative(m_outDirectory + "include/ffnvcodec/nvEncodeAPI.h", sFileName);
-                        enable = findFile(sFileName, sFileName);
-                    }
-                } else if (i == "opencl") {
-                    makeFileGeneratorRelative(m_outDirectory + "include/cl/cl.h", sFileName);
+                }
+            } else if (i == "nvenc") {
+                enable = findFile(m_rootDirectory + "compat/nvenc/nvEncodeAPI.h", sFileName);
+                if (!enable) {
+                    makeFileGeneratorRelative(m_outDirectory + "include/ffnvcodec/nvEncodeAPI.h", sFileName);
                     enable = findFile(sFileName, sFileName);
-                    if (enable) {
-                        fastToggleConfigValue("opencl_d3d11", true);
-                        fastToggleConfigValue("opencl_dxva2", true);
-                    }
-                } else if (i == "os2threads") {
-                    enable = false;
-                } else if (i == "pthreads") {
-                    enable = false;
-                } else if (i == "schannel") {
+                }
+            } else if (i == "opencl") {
+                makeFileGeneratorRelative(m_outDirectory + "include/cl/cl.h", sFileName);
+                enable = findFile(sFileName, sFileName);
+            } else if (i == "os2threads") {
+                enable = false;
+            } else if (i == "pthreads") {
+                enable = false;
+            } else if (i == "schannel") {
+                enable = true;
+            } else if (i == "sdl2") {
+                makeFileGeneratorRelative(m_outDirectory + "include/SDL/SDL.h", sFileName);
+                enable = findFile(sFileName, sFileName);
+            } else if (i == "securetransport") {
+                enable = false;
+            } else if (i == "sndio") {
+                enable = false;
+            } else if (i == "v4l2_m2m") {
+                enable = false;
+            } else if (i == "vaapi") {
+                enable = false;
+            } else if (i == "vda") {
+                enable = false;
+            } else if (i == "vdpau") {
+                enable = false;
+            } else if (i == "videotoolbox") {
+                enable = false;
+            } else if (i == "videotoolbox_hwaccel") {
+                enable = false;
+            } else if (i == "vulkan") {
+                enable = false;
+                if (findEnvironmentVariable("VULKAN_SDK")) {
                     enable = true;
-                } else if (i == "sdl2") {
-                    makeFileGeneratorRelative(m_outDirectory + "include/SDL/SDL.h", sFileName);
-                    enable = findFile(sFileName, sFileName);
-                } else if (i == "securetransport") {
-                    enable = false;
-                } else if (i == "sndio") {
-                    enable = false;
-                } else if (i == "v4l2_m2m") {
-                    enable = false;
-                } else if (i == "vaapi") {
-                    enable = false;
-                } else if (i == "vda") {
-                    enable = false;
-                } else if (i == "vdpau") {
-                    enable = false;
-                } else if (i == "videotoolbox") {
-                    enable = false;
-                } else if (i == "videotoolbox_hwaccel") {
-                    enable = false;
-                } else if (i == "vulkan") {
-                    enable = false;
-                    if (findEnvironmentVariable("VULKAN_SDK")) {
+                } else {
+                    string fileName;
+                    makeFileGeneratorRelative(m_outDirectory + "include/vulkan/vulkan.h", fileName);
+                    if (findFile(fileName, fileName)) {
                         enable = true;
-                    } else {
-                        string fileName;
-                        makeFileGeneratorRelative(m_outDirectory + "include/vulkan/vulkan.h", fileName);
-                        if (findFile(fileName, fileName)) {
-                            enable = true;
-                        }
                     }
-                } else if (i == "libglslang" || i == " libshaderc" || i == "spirv_compiler") {
-                    // Not currently supported
-                    enable = false;
-                } else if (i == "w32threads") {
-                    enable = true;
-                } else if (i == "xlib") {
-                    enable = false;
-                } else if (i == "xvmc") {
-                    enable = false;
-                } else if (i == "zlib") {
-                    makeFileGeneratorRelative(m_outDirectory + "include/zlib.h", sFileName);
-                    enable = findFile(sFileName, sFileName);
-                } else {
-                    // This is an unknown option
-                    outputInfo("Found unknown auto detected option " + i);
-                    // Just disable
-                    enable = false;
                 }
-                toggleConfigValue(i, enable && enableAuto, true);
+            } else if (i == "libglslang" || i == " libshaderc" || i == "spirv_compiler") {
+                // Not currently supported
+                enable = false;
+            } else if (i == "w32threads") {
+                enable = true;
+            } else if (i == "xlib") {
+                enable = false;
+            } else if (i == "xvmc") {
+                enable = false;
+            } else if (i == "zlib") {
+                makeFileGeneratorRelative(m_outDirectory + "include/zlib.h", sFileName);
+                enable = findFile(sFileName, sFileName);
+            } else {
+                // This is an unknown option
+                outputInfo("Found unknown auto detected option " + i);
+                // Just disable
+                enable = false;
+            }
+            m_autoDetectLibs.emplace_back(i, enable);
+        }
+    }
+}
+
+bool ConfigGenerator::buildAutoDetectValues()
+{
+    // Check if auto detection is enabled
+    const auto autoDet = getConfigOption("autodetect");
+    if ((autoDet != m_configValues.end())) {
+        // Enable/Disable all the auto detected libs
+        const bool enableAuto = !isConfigValueDisabled(autoDet);
+        for (const auto& i : m_autoDetectLibs) {
+            if (i.second && (i.first == "opencl")) {
+                fastToggleConfigValue("opencl_d3d11", true);
+                fastToggleConfigValue("opencl_dxva2", true);
             }
+            toggleConfigValue(i.first, i.second && enableAuto, true);
         }
     }
     return true;
@@ -712,7 +727,7 @@ void ConfigGenerator::buildReplaceValues(
 #endif";
 
         auto opt = getConfigOptionPrefixed("CONFIG_AVISYNTH");
-        if ((opt != m_configValues.end()) && opt->m_value == "1") {
+        if ((opt != m_configValues.end()) && isConfigValueEnabled(opt)) {
             replaceValues["CONFIG_AVISYNTH"] = "#if " + winrtDefine + "\n\
 #   define CONFIG_AVISYNTH 1\n\
 #else\n\
@@ -720,7 +735,7 @@ void ConfigGenerator::buildReplaceValues(
 #endif";
         }
         opt = getConfigOptionPrefixed("CONFIG_LIBMFX");
-        if ((opt != m_configValues.end()) && opt->m_value == "1") {
+        if ((opt != m_configValues.end()) && isConfigValueEnabled(opt)) {
             replaceValues["CONFIG_LIBMFX"] = "#if " + winrtDefine + "\n\
 #   define CONFIG_LIBMFX 1\n\
 #else\n\
@@ -728,7 +743,7 @@ void ConfigGenerator::buildReplaceValues(
 #endif";
         }
         opt = getConfigOptionPrefixed("CONFIG_AMF");
-        if ((opt != m_configValues.end()) && opt->m_value == "1") {
+        if ((opt != m_configValues.end()) && isConfigValueEnabled(opt)) {
             replaceValues["CONFIG_AMF"] = "#if " + winrtDefine + "\n\
 #   define CONFIG_AMF 1\n\
 #else\n\
@@ -736,7 +751,7 @@ void ConfigGenerator::buildReplaceValues(
 #endif";
         }
         opt = getConfigOptionPrefixed("CONFIG_CUDA");
-        if ((opt != m_configValues.end()) && opt->m_value == "1") {
+        if ((opt != m_configValues.end()) && isConfigValueEnabled(opt)) {
             replaceValues["CONFIG_CUDA"] = "#if " + winrtDefine + "\n\
 #   define CONFIG_CUDA 1\n\
 #else\n\
@@ -744,7 +759,7 @@ void ConfigGenerator::buildReplaceValues(
 #endif";
         }
         opt = getConfigOptionPrefixed("CONFIG_CUVID");
-        if ((opt != m_configValues.end()) && opt->m_value == "1") {
+        if ((opt != m_configValues.end()) && isConfigValueEnabled(opt)) {
             replaceValues["CONFIG_CUVID"] = "#if " + winrtDefine + "\n\
 #   define CONFIG_CUVID 1\n\
 #else\n\
@@ -752,7 +767,7 @@ void ConfigGenerator::buildReplaceValues(
 #endif";
         }
         opt = getConfigOptionPrefixed("CONFIG_DECKLINK");
-        if ((opt != m_configValues.end()) && opt->m_value == "1") {
+        if ((opt != m_configValues.end()) && isConfigValueEnabled(opt)) {
             replaceValues["CONFIG_DECKLINK"] = "#if " + winrtDefine + "\n\
 #   define CONFIG_DECKLINK 1\n\
 #else\n\
@@ -760,7 +775,7 @@ void ConfigGenerator::buildReplaceValues(
 #endif";
         }
         opt = getConfigOptionPrefixed("CONFIG_DXVA2");
-        if ((opt != m_configValues.end()) && opt->m_value == "1") {
+        if ((opt != m_configValues.end()) && isConfigValueEnabled(opt)) {
             replaceValues["CONFIG_DXVA2"] = "#if " + winrtDefine + "\n\
 #   define CONFIG_DXVA2 1\n\
 #else\n\
@@ -768,7 +783,7 @@ void ConfigGenerator::buildReplaceValues(
 #endif";
         }
         opt = getConfigOptionPrefixed("CONFIG_FFNVCODEC");
-        if ((opt != m_configValues.end()) && opt->m_value == "1") {
+        if ((opt != m_configValues.end()) && isConfigValueEnabled(opt)) {
             replaceValues["CONFIG_FFNVCODEC"] = "#if " + winrtDefine + "\n\
 #   define CONFIG_FFNVCODEC 1\n\
 #else\n\
@@ -776,7 +791,7 @@ void ConfigGenerator::buildReplaceValues(
 #endif";
         }
         opt = getConfigOptionPrefixed("CONFIG_NVDEC");
-        if ((opt != m_configValues.end()) && opt->m_value == "1") {
+        if ((opt != m_configValues.end()) && isConfigValueEnabled(opt)) {
             replaceValues["CONFIG_NVDEC"] = "#if " + winrtDefine + "\n\
 #   define CONFIG_NVDEC 1\n\
 #else\n\
@@ -784,7 +799,7 @@ void ConfigGenerator::buildReplaceValues(
 #endif";
         }
         opt = getConfigOptionPrefixed("CONFIG_NVENC");
-        if ((opt != m_configValues.end()) && opt->m_value == "1") {
+        if ((opt != m_configValues.end()) && isConfigValueEnabled(opt)) {
             replaceValues["CONFIG_NVENC"] = "#if " + winrtDefine + "\n\
 #   define CONFIG_NVENC 1\n\
 #else\n\
@@ -792,7 +807,7 @@ void ConfigGenerator::buildReplaceValues(
 #endif";
         }
         opt = getConfigOptionPrefixed("CONFIG_SCHANNEL");
-        if ((opt != m_configValues.end()) && opt->m_value == "1") {
+        if ((opt != m_configValues.end()) && isConfigValueEnabled(opt)) {
             replaceValues["CONFIG_SCHANNEL"] = "#if " + winrtDefine + "\n\
 #   define CONFIG_SCHANNEL 1\n\
 #else\n\
@@ -800,7 +815,7 @@ void ConfigGenerator::buildReplaceValues(
 #endif";
         }
         opt = getConfigOptionPrefixed("CONFIG_DSHOW_INDEV");
-        if ((opt != m_configValues.end()) && opt->m_value == "1") {
+        if ((opt != m_configValues.end()) && isConfigValueEnabled(opt)) {
             replaceValues["CONFIG_DSHOW_INDEV"] = "#if " + winrtDefine + "\n\
 #   define CONFIG_DSHOW_INDEV 1\n\
 #else\n\
@@ -808,7 +823,7 @@ void ConfigGenerator::buildReplaceValues(
 #endif";
         }
         opt = getConfigOptionPrefixed("CONFIG_GDIGRAB_INDEV");
-        if ((opt != m_configValues.end()) && opt->m_value == "1") {
+        if ((opt != m_configValues.end()) && isConfigValueEnabled(opt)) {
             replaceValues["CONFIG_GDIGRAB_INDEV"] = "#if " + winrtDefine + "\n\
 #   define CONFIG_GDIGRAB_INDEV 1\n\
 #else\n\
@@ -816,7 +831,7 @@ void ConfigGenerator::buildReplaceValues(
 #endif";
         }
         opt = getConfigOptionPrefixed("CONFIG_VFWCAP_INDEV");
-        if ((opt != m_configValues.end()) && opt->m_value == "1") {
+        if ((opt != m_configValues.end()) && isConfigValueEnabled(opt)) {
             replaceValues["CONFIG_VFWCAP_INDEV"] = "#if " + winrtDefine + "\n\
 #   define CONFIG_VFWCAP_INDEV 1\n\
 #else\n\
@@ -824,7 +839,7 @@ void ConfigGenerator::buildReplaceValues(
 #endif";
         }
         opt = getConfigOptionPrefixed("CONFIG_OPENGL");
-        if ((opt != m_configValues.end()) && opt->m_value == "1") {
+        if ((opt != m_configValues.end()) && isConfigValueEnabled(opt)) {
             replaceValues["CONFIG_OPENGL"] = "#if " + winrtDefine + "\n\
 #   define CONFIG_OPENGL 1\n\
 #else\n\
@@ -832,7 +847,7 @@ void ConfigGenerator::buildReplaceValues(
 #endif";
         }
         opt = getConfigOptionPrefixed("CONFIG_OPENAL");
-        if ((opt != m_configValues.end()) && opt->m_value == "1") {
+        if ((opt != m_configValues.end()) && isConfigValueEnabled(opt)) {
             replaceValues["CONFIG_OPENAL"] = "#if " + winrtDefine + "\n\
 #   define CONFIG_OPENAL 1\n\
 #else\n\
@@ -840,7 +855,7 @@ void ConfigGenerator::buildReplaceValues(
 #endif";
         }
         opt = getConfigOptionPrefixed("CONFIG_VULKAN");
-        if ((opt != m_configValues.end()) && opt->m_value == "1") {
+        if ((opt != m_configValues.end()) && isConfigValueEnabled(opt)) {
             replaceValues["CONFIG_VULKAN"] = "#if " + winrtDefine + "\n\
 #   define CONFIG_VULKAN 1\n\
 #else\n\
@@ -853,7 +868,7 @@ void ConfigGenerator::buildReplaceValues(
     vector<string> inlineList;
     getConfigList("ARCH_EXT_LIST_X86", inlineList);
     for (auto& i : inlineList) {
-        transform(i.begin(), i.end(), i.begin(), toupper);
+        transform(i.begin(), i.end(), i.begin(), ::toupper);
         string name = "HAVE_" + i + "_INLINE";
         replaceValues[name] = "#define " + name + " ARCH_X86 && HAVE_INLINE_ASM";
     }
@@ -873,17 +888,18 @@ void ConfigGenerator::buildReplaceValues(
     // Add any values that may depend on a replace value from above^
     DefaultValuesList newReplaceValues;
     string searchSuffix[] = {"_deps", "_select", "_deps_any"};
-    for (const auto& i : m_configValues) {
+    for (auto it = m_configValues.begin(); it < m_configValues.end(); ++it) {
+        const auto& i = *it;
         string tagName = i.m_prefix + i.m_option;
         // Check for forced replacement (only if attribute is not disabled)
-        if ((i.m_value != "0") && (replaceValues.find(tagName) != replaceValues.end())) {
+        if (!isConfigValueDisabled(it) && (replaceValues.find(tagName) != replaceValues.end())) {
             // Already exists in list so can skip
             continue;
         }
-        if (i.m_value == "1") {
+        if (isConfigValueEnabled(it)) {
             // Check if it depends on a replace value
             string optionLower = i.m_option;
-            transform(optionLower.begin(), optionLower.end(), optionLower.begin(), tolower);
+            transform(optionLower.begin(), optionLower.end(), optionLower.begin(), ::tolower);
             for (const auto& suff : searchSuffix) {
                 string checkFunc = optionLower + suff;
                 vector<string> checkList;
@@ -901,7 +917,7 @@ void ConfigGenerator::buildReplaceValues(
                         auto temp = getConfigOption(*j);
                         if (temp != m_configValues.end()) {
                             string replaceCheck = temp->m_prefix + temp->m_option;
-                            transform(replaceCheck.begin(), replaceCheck.end(), replaceCheck.begin(), toupper);
+                            transform(replaceCheck.begin(), replaceCheck.end(), replaceCheck.begin(), ::toupper);
                             auto dep = replaceValues.find(replaceCheck);
                             if (dep != replaceValues.end()) {
                                 if (addConfig.length() == 0) {
@@ -914,15 +930,15 @@ void ConfigGenerator::buildReplaceValues(
                                     addConfig = '!' + addConfig;
                                 }
                                 reservedDeps = true;
-                            } else if (toggle ^ (temp->m_value == "1")) {
+                            } else if (toggle ^ isConfigValueEnabled(temp)) {
                                 // Check recursively if dep has any deps that are reserved types
                                 string optionLower2 = temp->m_option;
-                                transform(optionLower2.begin(), optionLower2.end(), optionLower2.begin(), tolower);
+                                transform(optionLower2.begin(), optionLower2.end(), optionLower2.begin(), ::tolower);
                                 for (const auto& suff2 : searchSuffix) {
                                     checkFunc = optionLower2 + suff2;
                                     vector<string> checkList2;
                                     if (getConfigList(checkFunc, checkList2, false)) {
-                                        uint cPos = j - checkList.begin();
+                                        size_t cPos = j - checkList.begin();
                                         // Check if not already in list
                                         for (auto& k : checkList2) {
                                             // Check if this is a not !
@@ -1042,9 +1058,11 @@ void ConfigGenerator::buildReservedValues(vector<string>& reservedItems)
     reservedItems.emplace_back("pic");
 }
 
-void ConfigGenerator::buildAdditionalDependencies(DependencyList& additionalDependencies) const
+void ConfigGenerator::buildAdditionalDependencies(
+    DependencyList& additionalDependencies, DefaultValuesList& linkedDependencies) const
 {
     additionalDependencies.clear();
+    linkedDependencies.clear();
     additionalDependencies["android"] = false;
     additionalDependencies["capCreateCaptureWindow"] = true;
     additionalDependencies["const_nan"] = true;
@@ -1087,13 +1105,12 @@ void ConfigGenerator::buildAdditionalDependencies(DependencyList& additionalDepe
     additionalDependencies["VideoDecodeAcceleration_VDADecoder_h"] = false;
     additionalDependencies["X11_extensions_Xvlib_h"] = false;
     additionalDependencies["X11_extensions_XvMClib_h"] = false;
-    additionalDependencies["x264_csp_bgr"] = isConfigOptionEnabled("libx264");
-    bool bCuvid = isConfigOptionEnabled("cuvid");
-    additionalDependencies["CUVIDAV1PICPARAMS"] = bCuvid;
-    additionalDependencies["CUVIDH264PICPARAMS"] = bCuvid;
-    additionalDependencies["CUVIDHEVCPICPARAMS"] = bCuvid;
-    additionalDependencies["CUVIDVC1PICPARAMS"] = bCuvid;
-    additionalDependencies["CUVIDVP9PICPARAMS"] = bCuvid;
+    linkedDependencies["x264_csp_bgr"] = "libx264";
+    linkedDependencies["CUVIDAV1PICPARAMS"] = "cuvid";
+    linkedDependencies["CUVIDH264PICPARAMS"] = "cuvid";
+    linkedDependencies["CUVIDHEVCPICPARAMS"] = "cuvid";
+    linkedDependencies["CUVIDVC1PICPARAMS"] = "cuvid";
+    linkedDependencies["CUVIDVP9PICPARAMS"] = "cuvid";
     additionalDependencies["VAEncPictureParameterBufferH264"] = false;
     additionalDependencies["videotoolbox_encoder"] = false;
     additionalDependencies["VAEncPictureParameterBufferHEVC"] = false;
@@ -1115,20 +1132,18 @@ void ConfigGenerator::buildAdditionalDependencies(DependencyList& additionalDepe
     additionalDependencies["applicationservices"] = false;
     additionalDependencies["libdl"] = false;
     additionalDependencies["libm"] = false;
-    additionalDependencies["libvorbisenc"] = isConfigOptionEnabled("libvorbis");
+    linkedDependencies["libvorbisenc"] = "libvorbis";
     if (!isConfigOptionValid("atomics_native")) {
         additionalDependencies["atomics_native"] = true;
     }
-    additionalDependencies["MFX_CODEC_VP9"] = isConfigOptionEnabled("libmfx");
-    bool bNvenc = isConfigOptionEnabled("nvenc");
-    additionalDependencies["NV_ENC_PIC_PARAMS_AV1"] = bNvenc;
-    const auto spirv = getConfigOption("spirv_compiler");
-    if ((spirv == m_configValues.end())) {
+    linkedDependencies["MFX_CODEC_VP9"] = "libmfx";
+    linkedDependencies["NV_ENC_PIC_PARAMS_AV1"] = "nvenc";
+    if (!isConfigOptionValid("spirv_compiler")) {
         additionalDependencies["spirv_compiler"] = false;
     }
 }
 
-void ConfigGenerator::buildInterDependencies(InterDependencies& interDependencies)
+void ConfigGenerator::buildInterDependencies(InterDependencies& interDependencies) const
 {
     // Dynamically scan the configureFile for prepend {component}_deps and add
     vector<string> libraries;
@@ -1137,31 +1152,31 @@ void ConfigGenerator::buildInterDependencies(InterDependencies& interDependencie
     }
     for (const auto& i : libraries) {
         string prependString = "prepend " + i + "_deps";
-        uint prependPos = m_configureFile.find(prependString);
+        size_t prependPos = m_configureFile.find(prependString);
         while (prependPos != string::npos) {
-            const uint endPos = m_configureFile.rfind("&&", prependPos);
-            const uint startPos = m_configureFile.rfind('\n', endPos) + 1;
-            string enable = m_configureFile.substr(startPos, endPos - startPos);
+            const size_t endPos = m_configureFile.rfind("&&", prependPos);
+            const size_t startPos = m_configureFile.rfind('\n', endPos) + 1;
+            string enable(m_configureFile.substr(startPos, endPos - startPos));
             // Get enabled flags
             vector<string> required;
-            uint enabled = enable.find("enabled ");
+            size_t enabled = enable.find("enabled ");
             while (enabled != string::npos) {
-                const uint enableStart = enable.find_first_not_of(' ', enabled + 8);
-                const uint cutPos = enable.find(' ', enableStart + 1);
+                const size_t enableStart = enable.find_first_not_of(' ', enabled + 8);
+                const size_t cutPos = enable.find(' ', enableStart + 1);
                 required.emplace_back(enable.substr(enableStart, cutPos - enableStart));
                 // Get next
                 enabled = enable.find("enabled ", enabled + 8);
             }
 
             // Get dependencies
-            const uint prependStart = m_configureFile.find('"', prependPos + prependString.length()) + 1;
-            const uint prependEnd = m_configureFile.find('"', prependStart);
-            string prepends = m_configureFile.substr(prependStart, prependEnd - prependStart);
+            const size_t prependStart = m_configureFile.find('"', prependPos + prependString.length()) + 1;
+            const size_t prependEnd = m_configureFile.find('"', prependStart);
+            string prepends(m_configureFile.substr(prependStart, prependEnd - prependStart));
             vector<string> depends;
-            uint cutPos = 0;
+            size_t cutPos = 0;
             do {
                 cutPos = prepends.find_first_not_of(' ', cutPos);
-                const uint cutPos2 = prepends.find(' ', cutPos);
+                const size_t cutPos2 = prepends.find(' ', cutPos);
                 depends.emplace_back(prepends.substr(cutPos, cutPos2 - cutPos));
                 cutPos = cutPos2;
             } while (cutPos != string::npos);
@@ -1228,62 +1243,64 @@ void ConfigGenerator::buildOptimisedDisables(ConfigList& optimisedDisables)
 #endif
 }
 
-#define CHECKFORCEDENABLES(Opt)                             \
-    {                                                       \
-        if (getConfigOption(Opt) != m_configValues.end()) { \
-            forceEnable.emplace_back(Opt);                  \
-        }                                                   \
-    }
+void ConfigGenerator::buildForcedEnables(ForcedList& forceEnable)
+{
+    forceEnable.clear();
+    forceEnable["fontconfig"].emplace_back("libfontconfig");
+    forceEnable["dxva2"].emplace_back("dxva2_lib");
+    forceEnable["libcdio"].emplace_back("cdio_paranoia_paranoia_h");
+    forceEnable["libmfx"].emplace_back("qsv");
+    forceEnable["dcadec"].emplace_back("struct_dcadec_exss_info_matrix_encoding");
+    forceEnable["sdl"].emplace_back("sdl2", true); // must use fastToggle to prevent infinite cycle
+    forceEnable["sdl2"].emplace_back("sdl", true);
+    forceEnable["libvorbis"].emplace_back("libvorbisenc");
+    forceEnable["opencl"].emplace_back("opencl_d3d11");
+    forceEnable["opencl"].emplace_back("opencl_dxva2");
+    forceEnable["ffnvcodec"].emplace_back("cuda");
+    forceEnable["cuda"].emplace_back("ffnvcodec");
+    forceEnable["winrt"].emplace_back("uwp", true); // must use fastToggle to prevent infinite cycle
+    forceEnable["uwp"].emplace_back("winrt", true);
+    forceEnable["threads"].emplace_back("w32threads");
+    forceEnable["w32threads"].emplace_back("threads");
+}
 
-void ConfigGenerator::buildForcedEnables(const string& optionLower, vector<string>& forceEnable)
+void ConfigGenerator::buildForcedDisables(ForcedList& forceDisable)
 {
-    if (optionLower == "fontconfig") {
-        CHECKFORCEDENABLES("libfontconfig");
-    } else if (optionLower == "dxva2") {
-        CHECKFORCEDENABLES("dxva2_lib");
-    } else if (optionLower == "libcdio") {
-        CHECKFORCEDENABLES("cdio_paranoia_paranoia_h");
-    } else if (optionLower == "libmfx") {
-        CHECKFORCEDENABLES("qsv");
-    } else if (optionLower == "dcadec") {
-        CHECKFORCEDENABLES("struct_dcadec_exss_info_matrix_encoding");
-    } else if (optionLower == "sdl") {
-        fastToggleConfigValue("sdl2", true); // must use fastToggle to prevent infinite cycle
-    } else if (optionLower == "sdl2") {
-        fastToggleConfigValue("sdl", true);
-    } else if (optionLower == "libvorbis") {
-        CHECKFORCEDENABLES("libvorbisenc");
-    } else if (optionLower == "opencl") {
-        CHECKFORCEDENABLES("opencl_d3d11");
-        CHECKFORCEDENABLES("opencl_dxva2");
-    } else if (optionLower == "ffnvcodec") {
-        CHECKFORCEDENABLES("cuda");
-    } else if (optionLower == "cuda") {
-        CHECKFORCEDENABLES("ffnvcodec");
-    } else if (optionLower == "winrt") {
-        fastToggleConfigValue("uwp", true); // must use fastToggle to prevent infinite cycle
-    } else if (optionLower == "uwp") {
-        fastToggleConfigValue("winrt", true);
-    } else if (optionLower == "threads") {
-        CHECKFORCEDENABLES("w32threads");
-    } else if (optionLower == "w32threads") {
-        CHECKFORCEDENABLES("threads");
-    }
+    // Currently disable values are exact opposite of the corresponding enable ones
+    buildForcedEnables(forceDisable);
 }
 
-void ConfigGenerator::buildForcedDisables(const string& optionLower, vector<string>& forceDisable)
+void ConfigGenerator::buildDependencyTables()
 {
-    if (optionLower == "sdl") {
-        fastToggleConfigValue("sdl2", false); // must use fastToggle to prevent infinite cycle
-    } else if (optionLower == "sdl2") {
-        fastToggleConfigValue("sdl", false);
-    } else if (optionLower == "winrt") {
-        fastToggleConfigValue("uwp", false);
-    } else if (optionLower == "uwp") {
-        fastToggleConfigValue("winrt", false);
-    } else {
-        // Currently disable values are exact opposite of the corresponding enable ones
-        buildForcedEnables(optionLower, forceDisable);
+    m_toggleExpansions.clear();
+    DependencyList additionalDependencies;
+    DefaultValuesList linkedDependencies;
+    buildAdditionalDependencies(additionalDependencies, linkedDependencies);
+    m_additionalDependencies.clear();
+    for (const auto& i : additionalDependencies) {
+        m_additionalDependencies.emplace(i.first, AdditionalDependency(i.second, string::npos));
+    }
+    for (const auto& i : linkedDependencies) {
+        // Link directly to the option so its current value can be used
+        string optionUpper = i.second;
+        transform(optionUpper.begin(), optionUpper.end(), optionUpper.begin(), ::toupper);
+        const auto ids = getConfigOptionIDs(optionUpper);
+        m_additionalDependencies.emplace(
+            i.first, AdditionalDependency(false, (ids != nullptr) ? ids->front() : string::npos));
+    }
+
+    // Remove any forced options that are not valid for the current configure file
+    ForcedList* forcedLists[] = {&m_forcedEnables, &m_forcedDisables};
+    buildForcedEnables(m_forcedEnables);
+    buildForcedDisables(m_forcedDisables);
+    for (auto& forced : forcedLists) {
+        for (auto i = forced->begin(); i != forced->end();) {
+            auto& toggles = i->second;
+            for (auto j = toggles.begin(); j < toggles.end();) {
+                j = (!j->fast && !isConfigOptionValid(j->option)) ? toggles.erase(j) : j + 1;
+            }
+            i = (toggles.empty()) ? forced->erase(i) : ++i;
+        }
     }
 }
 
@@ -1297,9 +1314,10 @@ void ConfigGenerator::buildEarlyConfigArgs(vector<string>& earlyArgs)
     earlyArgs.emplace_back("--quiet");
     earlyArgs.emplace_back("--autodetect");
     earlyArgs.emplace_back("--use-yasm");
+    earlyArgs.emplace_back("--trace-config");
 }
 
-void ConfigGenerator::buildObjects(const string& tag, vector<string>& objects)
+void ConfigGenerator::buildObjects(const string& tag, vector<string>& objects) const
 {
     if (tag == "COMPAT_OBJS") {
         objects.emplace_back(
@@ -21,16 +21,27 @@
 #include "helperFunctions.h"
 
 #include <algorithm>
-#include <direct.h>
+#include <cerrno>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 
 #ifdef _WIN32
 #    include "Shlwapi.h"
 
 #    include <Windows.h>
+#    include <direct.h>
 #else
 #    include <dirent.h>
+#    include <fcntl.h>
+#    include <filesystem>
+#    include <limits.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
 extern char _binary_template_sln_winrt_start[];
 extern char _binary_template_sln_winrt_end[];
 extern char _binary_template_vcxproj_start[];
@@ -63,6 +74,8 @@ const char* pp_cEndArray[] = {_binary_template_sln_winrt_end, _binary_template_v
     _binary_template_program_vcxproj_filters_end, _binary_template_bat_end, _binary_template_vcxproj_winrt_end,
     _binary_template_props_end, _binary_template_props_winrt_end, _binary_template_file_props_end,
     _binary_template_sln_nowinrt_end};
+// Resource IDs start at 101 (TEMPLATE_SLN_WINRT_ID) and follow the order of the above arrays
+constexpr int g_firstResourceID = 101;
 #endif
 
 #if _DEBUG
@@ -71,6 +84,554 @@ static Verbosity s_outputVerbosity = VERBOSITY_INFO;
 static Verbosity s_outputVerbosity = VERBOSITY_WARNING;
 #endif
 
+// Prevents messages (and console colours) from separate threads being interleaved
+static mutex s_outputMutex;
+
+/** Contents of a single directory within the file index. */
+struct IndexDirectory
+{
+    string path;                                 /**< Normalised path of the directory (in its original case) */
+    unordered_map<string, vector<string>> files; /**< Each file stem mapped to all file names with that stem */
+};
+
+// Index of all files found within the indexed root directories. Each directory is searched only once and all further
+// searches are then performed in memory.
+static unordered_map<string, IndexDirectory> s_fileIndex;
+static vector<string> s_fileIndexRoots;
+static shared_mutex s_fileIndexMutex;
+
+// Every file output during the current run mapped to its absolute path. Any previously generated file not in this list
+// is stale.
+static unordered_map<string, string> s_writtenFiles;
+static mutex s_writtenFilesMutex;
+
+/**
+ * Gets the key used to identify a path within the file index (file names are case insensitive on Windows).
+ * @param path The normalised path.
+ * @return The index key.
+ */
+static string getIndexKey(const string& path)
+{
+#ifdef _WIN32
+    string key = path;
+    for (auto& i : key) {
+        i = static_cast<char>(tolower(static_cast<unsigned char>(i)));
+    }
+    return key;
+#else
+    return path;
+#endif
+}
+
+/**
+ * Normalises a directory path by removing any redundant "./" or "dir/../" components.
+ * @param directory The directory path.
+ * @return The normalised directory (ending in '/' unless it is the current working directory).
+ */
+static string getNormalisedPath(const string& directory)
+{
+    vector<string_view> parts;
+    const bool absolute = (!directory.empty() && ((directory[0] == '/') || (directory[0] == '\\')));
+    size_t start = 0;
+    while (start < directory.length()) {
+        size_t end = directory.find_first_of("/\\", start);
+        end = (end == string::npos) ? directory.length() : end;
+        const string_view part(directory.data() + start, end - start);
+        start = end + 1;
+        if (part.empty() || (part == ".")) {
+            continue;
+        }
+        if ((part == "..") && !parts.empty() && (parts.back() != "..") &&
+            (parts.back().find(':') == string_view::npos)) {
+            parts.pop_back();
+        } else {
+            parts.push_back(part);
+        }
+    }
+    string retPath = (absolute) ? "/" : "";
+    for (const auto& i : parts) {
+        retPath += i;
+        retPath += '/';
+    }
+    return retPath;
+}
+
+/**
+ * Gets the current working directory.
+ * @return The current directory (always ending in '/').
+ */
+static string getCurrentDirectory()
+{
+#ifdef _WIN32
+    char buffer[MAX_PATH];
+    string path(buffer, GetCurrentDirectoryA(MAX_PATH, buffer));
+#else
+    char buffer[PATH_MAX];
+    string path = (getcwd(buffer, PATH_MAX) != NULL) ? buffer : "";
+#endif
+    replace(path.begin(), path.end(), '\\', '/');
+    return path + '/';
+}
+
+/**
+ * Gets the normalised absolute path for a directory. The current working directory is only requested once so that
+ * paths can be converted without accessing the file system.
+ * @param directory The directory path (relative to the current working directory or absolute).
+ * @return The normalised absolute directory (always ending in '/').
+ */
+static string getAbsolutePath(const string& directory)
+{
+    static const string currentDirectory = getCurrentDirectory();
+    if (!directory.empty() && ((directory[0] == '/') || (directory[0] == '\\'))) {
+#ifdef _WIN32
+        // Rooted paths use the drive of the current directory
+        return getNormalisedPath(currentDirectory.substr(0, 2) + directory);
+#else
+        return getNormalisedPath(directory);
+#endif
+    }
+#ifdef _WIN32
+    if ((directory.length() > 1) && (directory[1] == ':')) {
+        return getNormalisedPath(directory);
+    }
+#endif
+    return getNormalisedPath(currentDirectory + directory);
+}
+
+/**
+ * Checks whether 2 characters in a path are the same (file names are case insensitive on Windows).
+ * @param a The first character.
+ * @param b The second character.
+ * @return True if the characters are the same, false if not.
+ */
+static bool isSamePathCharacter(const char a, const char b)
+{
+#ifdef _WIN32
+    return tolower(static_cast<unsigned char>(a)) == tolower(static_cast<unsigned char>(b));
+#else
+    return a == b;
+#endif
+}
+
+/**
+ * Checks whether a directory is contained within another directory.
+ * @param key  The index key of the directory.
+ * @param root The index key of the containing directory.
+ * @return True if the directory is a sub-directory of (or the same as) the root, false if not.
+ */
+static bool isSubDirectory(const string& key, const string& root)
+{
+    if (key.compare(0, root.length(), root) != 0) {
+        return false;
+    }
+    // A relative root does not contain any of its parent directories or any absolute path
+    const string_view remainder(key.data() + root.length(), key.length() - root.length());
+    if (remainder.compare(0, 3, "../") == 0) {
+        return false;
+    }
+    return !root.empty() || key.empty() ||
+        ((key[0] != '/') && (remainder.substr(0, remainder.find('/')).find(':') == string::npos));
+}
+
+/**
+ * Checks whether a directory name is hidden (such as ".git").
+ * @param name The directory name.
+ * @return True if hidden, false if not.
+ */
+static bool isHiddenDirectory(const string_view name)
+{
+    return (name.length() > 1) && (name[0] == '.') && (name != "..");
+}
+
+/**
+ * Checks whether a directory is contained within any of the indexed root directories.
+ * @param key The index key of the directory.
+ * @return True if the directory has been indexed, false if not.
+ */
+static bool isIndexedDirectory(const string& key)
+{
+    for (const auto& i : s_fileIndexRoots) {
+        if (isSubDirectory(key, i)) {
+            // Hidden directories are not indexed so must always be searched directly
+            size_t pos = i.length();
+            while (pos < key.length()) {
+                size_t end = key.find('/', pos);
+                end = (end == string::npos) ? key.length() : end;
+                if (isHiddenDirectory(string_view(key.data() + pos, end - pos))) {
+                    return false;
+                }
+                pos = end + 1;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Adds a file to an index directory.
+ * @param [in,out] directory The index directory.
+ * @param          fileName  The file name.
+ */
+static void addIndexFile(IndexDirectory& directory, const string& fileName)
+{
+    const string key = getIndexKey(fileName);
+    auto& files = directory.files[key.substr(0, key.rfind('.'))];
+    for (const auto& i : files) {
+        if (getIndexKey(i) == key) {
+            return;
+        }
+    }
+    files.push_back(fileName);
+}
+
+#ifndef _WIN32
+/**
+ * Gets the contents of a directory using a single pass over the directory entries.
+ * @remark Symbolic links to directories are skipped so that a link back to a parent directory cannot cause a
+ * recursive search to loop forever.
+ * @param       path    The directory path.
+ * @param [out] entries The name of each entry and whether it is a directory (sorted by name).
+ * @return True if it succeeds, false if it fails.
+ */
+static bool listDirectory(const string& path, vector<pair<string, bool>>& entries)
+{
+    error_code ec;
+    filesystem::directory_iterator entry(path.empty() ? "." : path, ec);
+    if (ec) {
+        return false;
+    }
+    // The entry type is returned along with the name so no additional stat is needed for each entry
+    for (; !ec && (entry != filesystem::directory_iterator()); entry.increment(ec)) {
+        error_code typeError;
+        const bool isDirectory = entry->is_directory(typeError);
+        if (isDirectory && entry->is_symlink(typeError)) {
+            continue;
+        }
+        entries.emplace_back(entry->path().filename().string(), isDirectory);
+    }
+    sort(entries.begin(), entries.end());
+    return true;
+}
+#endif
+
+/**
+ * Adds all files within a directory and any of its non-hidden sub-directories to the file index.
+ * @param path The normalised directory path.
+ */
+static void scanIndexDirectory(const string& path)
+{
+    IndexDirectory& directory = s_fileIndex[getIndexKey(path)];
+    directory.path = path;
+#ifdef _WIN32
+    WIN32_FIND_DATA searchFile;
+    const string search = path + '*';
+    const HANDLE searchHandle = FindFirstFileA(search.c_str(), &searchFile);
+    if (searchHandle == INVALID_HANDLE_VALUE) {
+        return;
+    }
+    do {
+        const string name = searchFile.cFileName;
+        if (searchFile.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+            // Skip the current and parent directories as well as any hidden directories
+            if ((name != ".") && (name != "..") && !isHiddenDirectory(name)) {
+                scanIndexDirectory(path + name + '/');
+            }
+        } else {
+            addIndexFile(directory, name);
+        }
+    } while (FindNextFileA(searchHandle, &searchFile) != 0);
+    FindClose(searchHandle);
+#else
+    vector<pair<string, bool>> entries;
+    listDirectory(path, entries);
+    for (const auto& i : entries) {
+        if (i.second) {
+            if (!isHiddenDirectory(i.first)) {
+                scanIndexDirectory(path + i.first + '/');
+            }
+        } else {
+            addIndexFile(directory, i.first);
+        }
+    }
+#endif
+}
+
+/**
+ * Checks whether a file name matches a search term containing wildcards ('*' and '?').
+ * @param fileName The file name to check.
+ * @param search   The search term.
+ * @return True if the file name matches, false if not.
+ */
+static bool matchWildcard(const string_view fileName, const string_view search)
+{
+    size_t pos = 0, searchPos = 0;
+    size_t starPos = string::npos, starMatch = 0;
+    while (pos < fileName.length()) {
+        if ((searchPos < search.length()) && ((search[searchPos] == '?') || (search[searchPos] == fileName[pos]))) {
+            ++pos;
+            ++searchPos;
+        } else if ((searchPos < search.length()) && (search[searchPos] == '*')) {
+            starPos = searchPos++;
+            starMatch = pos;
+        } else if (starPos != string::npos) {
+            // Extend the last wildcard by another character and try again
+            searchPos = starPos + 1;
+            pos = ++starMatch;
+        } else {
+            return false;
+        }
+    }
+    while ((searchPos < search.length()) && (search[searchPos] == '*')) {
+        ++searchPos;
+    }
+    return searchPos == search.length();
+}
+
+#ifndef _WIN32
+/**
+ * Searches a directory for files or folders by name (supports wildcards).
+ * @param          path       The directory path.
+ * @param          searchTerm The file name to search for.
+ * @param [in,out] retFiles   The returned list of found files.
+ * @param          recursive  True to process any sub-directories.
+ * @param          folders    True to only return folders.
+ */
+static void searchDirectory(
+    const string& path, const string& searchTerm, vector<string>& retFiles, const bool recursive, const bool folders)
+{
+    vector<pair<string, bool>> entries;
+    if (!listDirectory(path, entries)) {
+        return;
+    }
+    for (const auto& i : entries) {
+        if ((!folders || i.second) && matchWildcard(i.first, searchTerm)) {
+            retFiles.push_back(path + i.first);
+        }
+    }
+    // Search all sub directories using the already found entries
+    if (recursive) {
+        for (const auto& i : entries) {
+            if (i.second) {
+                searchDirectory(path + i.first + '/', searchTerm, retFiles, recursive, folders);
+            }
+        }
+    }
+}
+#endif
+
+/**
+ * Searches a single directory within the file index for files by name (supports wildcards).
+ * @param          directory The index directory.
+ * @param          path      The directory path used by the search.
+ * @param          search    The index key of the file name to search for.
+ * @param [in,out] retFiles  The returned list of found files.
+ */
+static void searchIndexDirectory(
+    const IndexDirectory& directory, const string& path, const string& search, vector<string>& retFiles)
+{
+    // Return files using the same path as the search
+    const string directoryPath = path + directory.path.substr(getNormalisedPath(path).length());
+    if (search.find_first_of("*?") == string::npos) {
+        const auto files = directory.files.find(search.substr(0, search.rfind('.')));
+        if (files != directory.files.end()) {
+            for (const auto& i : files->second) {
+                if (getIndexKey(i) == search) {
+                    retFiles.push_back(directoryPath + i);
+                }
+            }
+        }
+    } else {
+        for (const auto& i : directory.files) {
+            for (const auto& j : i.second) {
+                if (matchWildcard(getIndexKey(j), search)) {
+                    retFiles.push_back(directoryPath + j);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Checks whether a character in an index key is ordered before another so that directory separators come first.
+ * @param a The first character.
+ * @param b The second character.
+ * @return True if the first character is ordered first, false if not.
+ */
+static bool isIndexCharacterBefore(const char a, const char b)
+{
+    if (a == '/') {
+        return b != '/';
+    }
+    return (b != '/') && (static_cast<unsigned char>(a) < static_cast<unsigned char>(b));
+}
+
+/**
+ * Checks whether an index directory is ordered before another. Each directory is directly followed by its own
+ * sub-directories (in name order) which is the same order used by a recursive search of the file system.
+ * @param a The index key of the first directory.
+ * @param b The index key of the second directory.
+ * @return True if the first directory is ordered first, false if not.
+ */
+static bool isIndexDirectoryBefore(const string& a, const string& b)
+{
+    return lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(), isIndexCharacterBefore);
+}
+
+/**
+ * Searches the file index for files by name (supports wildcards).
+ * @param          fileSearch The file name to search for.
+ * @param [in,out] retFiles   The returned list of found files.
+ * @param          recursive  True to process any sub-directories.
+ * @return True if the search is contained within the file index, false if the file system must be searched instead.
+ */
+static bool searchFileIndex(const string& fileSearch, vector<string>& retFiles, const bool recursive)
+{
+    // Split the search into its directory and file name
+    size_t pos = fileSearch.find_last_of("/\\");
+    pos = (pos == string::npos) ? 0 : pos + 1;
+    const string path = fileSearch.substr(0, pos);
+    const string key = getIndexKey(getNormalisedPath(path));
+    if (!isIndexedDirectory(key)) {
+        return false;
+    }
+    const string search = getIndexKey(fileSearch.substr(pos));
+    vector<string> directories;
+    if (!recursive) {
+        // Only the requested directory is needed so it can be found directly
+        directories.push_back(key);
+    } else {
+        for (const auto& i : s_fileIndex) {
+            if (isSubDirectory(i.first, key)) {
+                directories.push_back(i.first);
+            }
+        }
+        sort(directories.begin(), directories.end(), isIndexDirectoryBefore);
+    }
+    // Files within each directory are returned before those in any of its sub-directories
+    for (const auto& i : directories) {
+        const auto directory = s_fileIndex.find(i);
+        if (directory != s_fileIndex.end()) {
+            const size_t startSize = retFiles.size();
+            searchIndexDirectory(directory->second, path, search, retFiles);
+            sort(retFiles.begin() + startSize, retFiles.end());
+        }
+    }
+    return true;
+}
+
+/**
+ * Updates the file index after a file has been created or deleted.
+ * @param fileName The file name.
+ * @param exists   True if the file has been created, false if it has been deleted.
+ */
+static void updateFileIndex(const string& fileName, const bool exists)
+{
+    lock_guard<shared_mutex> lock(s_fileIndexMutex);
+    if (s_fileIndexRoots.empty()) {
+        return;
+    }
+    size_t pos = fileName.find_last_of("/\\");
+    pos = (pos == string::npos) ? 0 : pos + 1;
+    const string path = getNormalisedPath(fileName.substr(0, pos));
+    const string key = getIndexKey(path);
+    if (!isIndexedDirectory(key)) {
+        return;
+    }
+    const string name = fileName.substr(pos);
+    if (exists) {
+        IndexDirectory& directory = s_fileIndex[key];
+        directory.path = path;
+        addIndexFile(directory, name);
+        return;
+    }
+    const auto directory = s_fileIndex.find(key);
+    if (directory != s_fileIndex.end()) {
+        const string nameKey = getIndexKey(name);
+        const auto files = directory->second.files.find(nameKey.substr(0, nameKey.rfind('.')));
+        if (files != directory->second.files.end()) {
+            for (auto i = files->second.begin(); i < files->second.end(); ++i) {
+                if (getIndexKey(*i) == nameKey) {
+                    files->second.erase(i);
+                    break;
+                }
+            }
+            if (files->second.empty()) {
+                directory->second.files.erase(files);
+            }
+        }
+    }
+}
+
+/**
+ * Gets the absolute path of a file within the list of output files.
+ * @param fileName The file name.
+ * @return The absolute path.
+ */
+static string getWrittenFilePath(const string& fileName)
+{
+    size_t pos = fileName.find_last_of("/\\");
+    pos = (pos == string::npos) ? 0 : pos + 1;
+    return getAbsolutePath(fileName.substr(0, pos)) + fileName.substr(pos);
+}
+
+/**
+ * Gets the key used to identify a file within the list of output files.
+ * @param fileName The file name.
+ * @return The key.
+ */
+static string getWrittenFileKey(const string& fileName)
+{
+    return getIndexKey(getWrittenFilePath(fileName));
+}
+
+/**
+ * Adds a file to the list of files output during the current run.
+ * @param fileName The file name.
+ */
+static void addWrittenFile(const string& fileName)
+{
+    const string path = getWrittenFilePath(fileName);
+    const string key = getIndexKey(path);
+    lock_guard<mutex> lock(s_writtenFilesMutex);
+    s_writtenFiles.emplace(key, path);
+}
+
+/**
+ * Replaces a file with another (the source file is removed).
+ * @param sourceFile      The file to move.
+ * @param destinationFile The file to replace.
+ * @return True if it succeeds, false if it fails.
+ */
+static bool replaceFile(const string& sourceFile, const string& destinationFile)
+{
+#ifdef _WIN32
+    return (MoveFileExA(sourceFile.c_str(), destinationFile.c_str(), MOVEFILE_REPLACE_EXISTING) != 0);
+#else
+    return (rename(sourceFile.c_str(), destinationFile.c_str()) == 0);
+#endif
+}
+
+/**
+ * Removes a directory and any of its sub-directories from the file index.
+ * @param folder The directory path.
+ */
+static void removeFileIndexFolder(const string& folder)
+{
+    lock_guard<shared_mutex> lock(s_fileIndexMutex);
+    const string key = getIndexKey(getNormalisedPath(folder));
+    if (!isIndexedDirectory(key)) {
+        return;
+    }
+    for (auto i = s_fileIndex.begin(); i != s_fileIndex.end();) {
+        if (isSubDirectory(i->first, key)) {
+            i = s_fileIndex.erase(i);
+        } else {
+            ++i;
+        }
+    }
+}
+
 namespace project_generate {
 bool loadFromFile(const string& fileName, string& retString, const bool binary, const bool outError)
 {
@@ -85,17 +646,113 @@ bool loadFromFile(const string& fileName, string& retString, const bool binary,
 
     // Load whole file into internal string
     inputFile.seekg(0, std::ifstream::end);
-    const uint bufferSize = static_cast<uint>(inputFile.tellg());
+    const size_t bufferSize = static_cast<size_t>(inputFile.tellg());
     inputFile.seekg(0, std::ifstream::beg);
     retString.resize(bufferSize);
     inputFile.read(&retString[0], bufferSize);
-    if (bufferSize != static_cast<uint>(inputFile.gcount())) {
-        retString.resize(static_cast<uint>(inputFile.gcount()));
+    if (bufferSize != static_cast<size_t>(inputFile.gcount())) {
+        retString.resize(static_cast<size_t>(inputFile.gcount()));
     }
     inputFile.close();
     return true;
 }
 
+struct MappedFile::Mapping
+{
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#else
+    int file = -1;
+#endif
+    const char* data = nullptr;
+    size_t size = 0;
+
+    Mapping() = default;
+    Mapping(const Mapping&) = delete;
+    Mapping& operator=(const Mapping&) = delete;
+
+    ~Mapping()
+    {
+        if (data != nullptr) {
+#ifdef _WIN32
+            UnmapViewOfFile(data);
+#else
+            munmap(const_cast<char*>(data), size);
+#endif
+        }
+#ifdef _WIN32
+        if (mapping != nullptr) {
+            CloseHandle(mapping);
+        }
+        if (file != INVALID_HANDLE_VALUE) {
+            CloseHandle(file);
+        }
+#else
+        if (file >= 0) {
+            close(file);
+        }
+#endif
+    }
+};
+
+bool MappedFile::open(const string& fileName, const bool outError)
+{
+    m_mapping.reset();
+    m_view = string_view();
+    auto mapping = make_shared<Mapping>();
+#ifdef _WIN32
+    mapping->file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    LARGE_INTEGER fileSize;
+    if ((mapping->file == INVALID_HANDLE_VALUE) || !GetFileSizeEx(mapping->file, &fileSize)) {
+        if (outError) {
+            outputError("Failed opening file (" + fileName + ")");
+        }
+        return false;
+    }
+    mapping->size = static_cast<size_t>(fileSize.QuadPart);
+    if (mapping->size > 0) {
+        // Empty files cannot be mapped
+        mapping->mapping = CreateFileMappingA(mapping->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping->mapping != nullptr) {
+            mapping->data = static_cast<const char*>(MapViewOfFile(mapping->mapping, FILE_MAP_READ, 0, 0, 0));
+        }
+    }
+#else
+    mapping->file = ::open(fileName.c_str(), O_RDONLY);
+    struct stat fileStat;
+    if ((mapping->file < 0) || (fstat(mapping->file, &fileStat) != 0)) {
+        if (outError) {
+            outputError("Failed opening file (" + fileName + ")");
+        }
+        return false;
+    }
+    mapping->size = static_cast<size_t>(fileStat.st_size);
+    if (mapping->size > 0) {
+        // Empty files cannot be mapped
+        void* data = mmap(nullptr, mapping->size, PROT_READ, MAP_PRIVATE, mapping->file, 0);
+        if (data != MAP_FAILED) {
+            mapping->data = static_cast<const char*>(data);
+        }
+    }
+#endif
+    if ((mapping->size > 0) && (mapping->data == nullptr)) {
+        if (outError) {
+            outputError("Failed mapping file (" + fileName + ")");
+        }
+        return false;
+    }
+    m_view = string_view(mapping->data, mapping->size);
+    m_mapping = mapping;
+    return true;
+}
+
+string_view MappedFile::view() const
+{
+    return m_view;
+}
+
 bool loadFromResourceFile(const int resourceID, string& retString)
 {
 #ifdef _WIN32
@@ -118,38 +775,69 @@ bool loadFromResourceFile(const int resourceID, string& retString)
     // Requires text file to be converted into a binary using either:
     // ld -r -b binary -o resource.file.o resource.file (creates _binary_resource_file_start)
     // objcopy -B i386 -I binary -O elf32-i386 resource.file resource.file.o
-    uint size = (uint)(&pp_cEndArray[resourceID - 100] - &pp_cStartArray[resourceID - 100]);
-    retString.reserve(size);
-    retString.resize(size);
-    memcpy(const_cast<char*>(retString.data()), pp_cStartArray[resourceID - 100], size);
-    return false;
+    const int resource = resourceID - g_firstResourceID;
+    retString.assign(pp_cStartArray[resource], pp_cEndArray[resource] - pp_cStartArray[resource]);
+    return true;
 #endif
 }
 
 bool writeToFile(const string& fileName, const string& inString, const bool binary)
 {
-    // Check for subdirectories
-    const uint dirPos = fileName.rfind('/');
-    if (dirPos != string::npos) {
-        const string cs = fileName.substr(0, dirPos);
-        if (!makeDirectory(cs)) {
-            outputError("Failed creating local " + cs + " directory");
+    // Check if the file already contains the exact same contents so that unchanged files are not touched
+    string existing;
+    if (!loadFromFile(fileName, existing, binary, false) || (existing != inString)) {
+        // Check for subdirectories
+        const size_t dirPos = fileName.rfind('/');
+        if (dirPos != string::npos) {
+            const string cs = fileName.substr(0, dirPos);
+            if (!makeDirectory(cs)) {
+                outputError("Failed creating local " + cs + " directory");
+                return false;
+            }
+        }
+        // Open temporary output file
+        const string tempFileName = fileName + ".tmp";
+        ofstream ofOutputFile(tempFileName, (binary) ? ios_base::out | ios_base::binary : ios_base::out);
+        if (!ofOutputFile.is_open()) {
+            outputError("Failed opening output file (" + fileName + ")");
             return false;
         }
-    }
-    // Open output file
-    ofstream ofOutputFile(fileName, (binary) ? ios_base::out | ios_base::binary : ios_base::out);
-    if (!ofOutputFile.is_open()) {
-        outputError("Failed opening output file (" + fileName + ")");
-        return false;
-    }
 
-    // Output inString to file and close
-    ofOutputFile << inString;
-    ofOutputFile.close();
+        // Output inString to file and close
+        ofOutputFile << inString;
+        ofOutputFile.close();
+
+        // Replace any existing file with the completed output
+        if (ofOutputFile.fail() || !replaceFile(tempFileName, fileName)) {
+            outputError("Failed writing output file (" + fileName + ")");
+            deleteFile(tempFileName);
+            return false;
+        }
+        updateFileIndex(fileName, true);
+    }
+    addWrittenFile(fileName);
     return true;
 }
 
+bool isFileWritten(const string& fileName)
+{
+    lock_guard<mutex> lock(s_writtenFilesMutex);
+    return s_writtenFiles.find(getWrittenFileKey(fileName)) != s_writtenFiles.end();
+}
+
+void getWrittenFiles(const string& directory, vector<string>& retFiles)
+{
+    const string path = getAbsolutePath(directory);
+    const string key = getIndexKey(path);
+    lock_guard<mutex> lock(s_writtenFilesMutex);
+    for (const auto& i : s_writtenFiles) {
+        if (i.first.compare(0, key.length(), key) == 0) {
+            retFiles.push_back(i.second.substr(path.length()));
+        }
+    }
+    sort(retFiles.begin(), retFiles.end());
+}
+
 bool copyResourceFile(const int resourceID, const string& destinationFile, const bool binary)
 {
 #ifdef _WIN32
@@ -172,23 +860,27 @@ bool copyResourceFile(const int resourceID, const string& destinationFile, const
         return false;
     }
     dest.close();
+    updateFileIndex(destinationFile, true);
+    addWrittenFile(destinationFile);
 
     // Close Resource
     FreeResource(hMem);
     return true;
 #else
-    uint size = (uint)(&pp_cEndArray[resourceID - 100] - &pp_cStartArray[resourceID - 100]);
+    const int resource = resourceID - g_firstResourceID;
     // Copy across the file
     ofstream dest(destinationFile, (binary) ? ios_base::out | ios_base::binary : ios_base::out);
     if (!dest.is_open()) {
         return false;
     }
-    if (!dest.write(pp_cStartArray[resourceID - 100], size)) {
+    if (!dest.write(pp_cStartArray[resource], pp_cEndArray[resource] - pp_cStartArray[resource])) {
         dest.close();
         return false;
     }
     dest.close();
-    return false;
+    updateFileIndex(destinationFile, true);
+    addWrittenFile(destinationFile);
+    return true;
 #endif
 }
 
@@ -199,6 +891,7 @@ void deleteFile(const string& destinationFile)
 #else
     remove(destinationFile.c_str());
 #endif
+    updateFileIndex(destinationFile, false);
 }
 
 void deleteFolder(const string& destinationFolder)
@@ -208,39 +901,10 @@ void deleteFolder(const string& destinationFolder)
     SHFILEOPSTRUCT file_op = {NULL, FO_DELETE, delFolder.c_str(), "", FOF_NO_UI, false, 0, ""};
     SHFileOperationA(&file_op);
 #else
-    DIR* p_Dir = opendir(destinationFolder.c_str());
-    size_t path_len = strlen(destinationFolder.c_str());
-
-    if (p_Dir) {
-        struct dirent* p_Dirent;
-        int iRet = 0;
-        while (!iRet && (p_Dirent = readdir(p_Dir))) {
-            /* Skip the names "." and ".." as we don't want to recurse on them. */
-            if (!strcmp(p_Dirent->d_name, ".") || !strcmp(p_Dirent->d_name, "..")) {
-                continue;
-            }
-            size_t diPathLength = path_len + strlen(p_Dirent->d_name) + 2;
-            char* p_cBuffer = malloc(diPathLength);
-
-            int iRet2 = -1;
-            if (p_cBuffer) {
-                struct stat statbuf;
-                snprintf(p_cBuffer, diPathLength, "%s/%s", destinationFolder.c_str(), p_Dirent->d_name);
-                if (!stat(p_cBuffer, &statbuf)) {
-                    if (S_ISDIR(statbuf.st_mode)) {
-                        iRet2 = remove_directory(p_cBuffer);
-                    } else {
-                        iRet2 = unlink(p_cBuffer);
-                    }
-                }
-                free(p_cBuffer);
-            }
-            iRet = iRet2;
-        }
-        closedir(p_Dir);
-    }
-    rmdir(destinationFolder.c_str());
+    error_code ec;
+    filesystem::remove_all(destinationFolder, ec);
 #endif
+    removeFileIndexFolder(destinationFolder);
 }
 
 bool isFolderEmpty(const string& folder)
@@ -268,28 +932,56 @@ bool isFolderEmpty(const string& folder)
 bool copyFile(const string& sourceFolder, const string& destinationFolder)
 {
 #ifdef _WIN32
-    return (CopyFileA(sourceFolder.c_str(), destinationFolder.c_str(), false) != 0);
+    if (CopyFileA(sourceFolder.c_str(), destinationFolder.c_str(), false) == 0) {
+        return false;
+    }
 #else
-    FILE* p_Source = fopen(sourceFolder.c_str(), "rb");
-    if (p_Source == NULL)
+    const int source = ::open(sourceFolder.c_str(), O_RDONLY);
+    if (source < 0) {
         return false;
-    FILE* p_Dest = fopen(destinationFolder.c_str(), "wb");
-    if (p_Dest == NULL) {
-        fclose(p_Source);
+    }
+    struct stat fileStat;
+    const int dest = (fstat(source, &fileStat) == 0) ?
+        ::open(destinationFolder.c_str(), O_WRONLY | O_CREAT | O_TRUNC, fileStat.st_mode & 0777) :
+        -1;
+    if (dest < 0) {
+        close(source);
         return false;
     }
-    size_t size;
-    char p_cBuffer[BUFSIZ];
-    while (size = fread(p_cBuffer, sizeof(char), sizeof(p_cBuffer), p_Source)) {
-        if (fwrite(p_cBuffer, sizeof(char), size, p_Dest) != size) {
-            fclose(p_Source);
-            fclose(p_Dest);
-            return false;
+    bool ret = true;
+#    ifdef __linux__
+    // Copy within the kernel where supported (any remaining data is then copied below)
+    off_t remaining = fileStat.st_size;
+    while (remaining > 0) {
+        const ssize_t copied = copy_file_range(source, nullptr, dest, nullptr, remaining, 0);
+        if (copied <= 0) {
+            break;
         }
+        remaining -= copied;
+    }
+#    endif
+    char buffer[65536];
+    ssize_t size;
+    while (ret && ((size = read(source, buffer, sizeof(buffer))) > 0)) {
+        for (ssize_t written = 0; written < size;) {
+            const ssize_t ret2 = write(dest, buffer + written, size - written);
+            if (ret2 < 0) {
+                ret = false;
+                break;
+            }
+            written += ret2;
+        }
+    }
+    ret = ret && (size == 0);
+    close(source);
+    close(dest);
+    if (!ret) {
+        return false;
     }
-    fclose(p_Source);
-    fclose(p_Dest);
 #endif
+    updateFileIndex(destinationFolder, true);
+    addWrittenFile(destinationFolder);
+    return true;
 }
 
 string getCopywriteHeader(const string& decription)
@@ -321,14 +1013,14 @@ bool makeDirectory(const string& directory)
 #ifdef _WIN32
     const int ret = _mkdir(directory.c_str());
 #else
-    const int ret = mkdir(directory.c_str());
+    const int ret = mkdir(directory.c_str(), 0777);
 #endif
     if ((ret == 0) || (errno == EEXIST)) {
         return true;
     }
     if (errno == ENOENT) {
         // The parent directory doesnt exist
-        uint pos = directory.find_last_of('/');
+        size_t pos = directory.find_last_of('/');
 #if defined(_WIN32)
         if (pos == string::npos) {
             pos = directory.find_last_of('\\');
@@ -360,12 +1052,27 @@ bool findFile(const string& fileName, string& retFileName)
     }
     return false;
 #else
-    glob_t glob_result;
-    if (glob(fileName.c_str(), GLOB_TILDEE | GLOB_NOSORT | GLOB_NOESCAPE, NULL, &glob_result) == 0) {
-        retFileName = string(glob_result.gl_pathv[0]);
-        globfree(&glob_result);
+    size_t pos = fileName.rfind('/');
+    pos = (pos == string::npos) ? 0 : pos + 1;
+    if (fileName.find_first_of("*?", pos) == string::npos) {
+        // Without wildcards the file can be checked directly
+        error_code ec;
+        if (!filesystem::exists(fileName, ec)) {
+            return false;
+        }
+        retFileName = fileName.substr(pos);
         return true;
     }
+    vector<pair<string, bool>> entries;
+    if (listDirectory(fileName.substr(0, pos), entries)) {
+        for (const auto& i : entries) {
+            if (matchWildcard(i.first, string_view(fileName).substr(pos))) {
+                // Update the return filename
+                retFileName = i.first;
+                return true;
+            }
+        }
+    }
     return false;
 #endif
 }
@@ -374,10 +1081,10 @@ bool findFiles(const string& fileSearch, vector<string>& retFiles, const bool re
 {
 #ifdef _WIN32
     WIN32_FIND_DATA searchFile;
-    const uint startSize = retFiles.size();
+    const size_t startSize = retFiles.size();
     string path;
     string searchTerm = fileSearch;
-    uint pos = searchTerm.rfind('/');
+    size_t pos = searchTerm.rfind('/');
     if (pos != string::npos) {
         ++pos;
         path = fileSearch.substr(0, pos);
@@ -414,15 +1121,11 @@ bool findFiles(const string& fileSearch, vector<string>& retFiles, const bool re
     }
     return (retFiles.size() - startSize) > 0;
 #else
-    glob_t glob_result;
-    if (glob(sFileName.c_str(), GLOB_TILDEE | GLOB_NOSORT | GLOB_NOESCAPE, NULL, &glob_result) == 0) {
-        for (unsigned int i = 0; i < glob_result.gl_pathc; ++i) {
-            retFiles.push_back(string(glob_result.gl_pathv[i]));
-        }
-        globfree(&glob_result);
-        return (retFiles.size() - uiStartSize) > 0;
-    }
-    return false;
+    const size_t startSize = retFiles.size();
+    size_t pos = fileSearch.rfind('/');
+    pos = (pos == string::npos) ? 0 : pos + 1;
+    searchDirectory(fileSearch.substr(0, pos), fileSearch.substr(pos), retFiles, recursive, false);
+    return (retFiles.size() - startSize) > 0;
 #endif
 }
 
@@ -430,10 +1133,10 @@ bool findFolders(const string& folderSearch, vector<string>& retFolders, const b
 {
 #ifdef _WIN32
     WIN32_FIND_DATA searchFile;
-    const uint startSize = retFolders.size();
+    const size_t startSize = retFolders.size();
     string path;
     string searchTerm = folderSearch;
-    uint pos = searchTerm.rfind('/');
+    size_t pos = searchTerm.rfind('/');
     if (pos == (searchTerm.length() - 1)) {
         pos = searchTerm.find_last_not_of('/');
         pos = searchTerm.rfind('/', pos - 1);
@@ -476,71 +1179,99 @@ bool findFolders(const string& folderSearch, vector<string>& retFolders, const b
     }
     return (retFolders.size() - startSize) > 0;
 #else
-    glob_t glob_result;
-    if (glob(sFileName.c_str(), GLOB_TILDE | GLOB_NOSORT | GLOB_NOESCAPE | GLOB_ONLYDIR, NULL, &glob_result) == 0) {
-        for (unsigned int i = 0; i < glob_result.gl_pathc; ++i) {
-            vRetFiles.push_back(string(glob_result.gl_pathv[i]));
-        }
-        globfree(&glob_result);
-        return (vRetFiles.size() - uiStartSize) > 0;
+    const size_t startSize = retFolders.size();
+    const size_t end = folderSearch.find_last_not_of('/');
+    if (end == string::npos) {
+        return false;
     }
-    return false;
+    size_t pos = folderSearch.rfind('/', end);
+    pos = (pos == string::npos) ? 0 : pos + 1;
+    searchDirectory(folderSearch.substr(0, pos), folderSearch.substr(pos, end + 1 - pos), retFolders, recursive, true);
+    return (retFolders.size() - startSize) > 0;
 #endif
 }
 
+void indexFiles(const string& directory)
+{
+    lock_guard<shared_mutex> lock(s_fileIndexMutex);
+    const string path = getNormalisedPath(directory);
+    const string key = getIndexKey(path);
+    if (isIndexedDirectory(key)) {
+        return;
+    }
+    s_fileIndexRoots.push_back(key);
+    scanIndexDirectory(path);
+}
+
+bool findIndexedFile(const string& fileName, string& retFileName)
+{
+    vector<string> files;
+    {
+        shared_lock<shared_mutex> lock(s_fileIndexMutex);
+        if (searchFileIndex(fileName, files, false)) {
+            if (files.empty()) {
+                return false;
+            }
+            // Update the return filename
+            retFileName = files.front().substr(files.front().find_last_of("/\\") + 1);
+            return true;
+        }
+    }
+    return findFile(fileName, retFileName);
+}
+
+bool findIndexedFiles(const string& fileSearch, vector<string>& retFiles, const bool recursive)
+{
+    {
+        shared_lock<shared_mutex> lock(s_fileIndexMutex);
+        const size_t startSize = retFiles.size();
+        if (searchFileIndex(fileSearch, retFiles, recursive)) {
+            return (retFiles.size() - startSize) > 0;
+        }
+    }
+    return findFiles(fileSearch, retFiles, recursive);
+}
+
+bool isSameDirectory(const string& directory, const string& directory2)
+{
+    return getIndexKey(getAbsolutePath(directory)) == getIndexKey(getAbsolutePath(directory2));
+}
+
 void makePathsRelative(const string& path, const string& makeRelativeTo, string& retPath)
 {
-#ifdef _WIN32
-    retPath.reserve(MAX_PATH);
-    retPath.resize(MAX_PATH);
-    string fromT, toT;
-    fromT.reserve(MAX_PATH);
-    toT.reserve(MAX_PATH);
-    if (path.length() > 0) {
-        GetFullPathNameA(path.c_str(), MAX_PATH, const_cast<char*>(fromT.data()), NULL);
-    } else {
-        GetFullPathNameA("./", MAX_PATH, const_cast<char*>(fromT.data()), NULL);
+    // Compare the normalised absolute paths so that no file system access is needed
+    const string from = getAbsolutePath(makeRelativeTo);
+    const string to = getAbsolutePath(path);
+    const bool directory = path.empty() || (path.back() == '/') || (path.back() == '\\');
+
+    // Find the last directory common to both paths
+    size_t common = 0;
+    const size_t length = min(from.length(), to.length());
+    for (size_t i = 0; (i < length) && isSamePathCharacter(from[i], to[i]); ++i) {
+        if (from[i] == '/') {
+            common = i + 1;
+        }
     }
-    if (makeRelativeTo.length() > 0) {
-        GetFullPathNameA(makeRelativeTo.c_str(), MAX_PATH, const_cast<char*>(toT.data()), NULL);
-    } else {
-        GetFullPathNameA("./", MAX_PATH, const_cast<char*>(toT.data()), NULL);
+    if (common == 0) {
+        // The paths have no common root (e.g. different drives) so the absolute path must be used
+        retPath = (directory) ? to : to.substr(0, to.length() - 1);
+        return;
     }
-    PathRelativePathToA(
-        const_cast<char*>(retPath.data()), toT.c_str(), FILE_ATTRIBUTE_DIRECTORY, fromT.c_str(), FILE_ATTRIBUTE_NORMAL);
-    retPath.resize(strlen(retPath.c_str()));
-    replace(retPath.begin(), retPath.end(), '\\', '/');
-#else
-    retPath.reserve(MAX_PATH);
-    retPath.resize(MAX_PATH);
-    string sFromT, sToT;
-    sFromT.reserve(MAX_PATH);
-    sToT.reserve(MAX_PATH);
-    realpath(path.c_str(), const_cast<char*>(sFromT.data()));
-    realpath(makeRelativeTo.c_str(), const_cast<char*>(sToT.data()));
-    retPath.at(0) = '\0';
-    int iPos;
-    int iSizeA = strlen(path.c_str()) + 1;
-    int iSizeR = strlen(makeRelativeTo.c_str()) + 1;
-    for (iPos = 0; iPos < iSizeA && iPos < iSizeR; iPos += strlen(path.c_str() + iPos) + 1) {
-        const char* p_PosA = strchr(path.c_str() + iPos, '/');
-        const char* p_PosR = strchr(makeRelativeTo.c_str() + iPos, '/');
-        if (p_PosA)
-            const_cast<char*>(p_PosA)[0] = '\0';
-        if (p_PosR)
-            const_cast<char*>(p_PosR)[0] = '\0';
-        if (strcmp(path.c_str() + iPos, makeRelativeTo.c_str() + iPos) != 0)
-            break;
+    string relative;
+    if (common == from.length()) {
+        relative = "./";
+    } else {
+        for (size_t i = common; i < from.length(); ++i) {
+            if (from[i] == '/') {
+                relative += "../";
+            }
+        }
     }
-    for (int iPos2 = iPos; iPos2 < iSizeR; iPos2 += strlen(makeRelativeTo.c_str() + iPos2) + 1) {
-        strcat(const_cast<char*>(retPath.data()), "../");
-        if (!strchr(retPath.c_str() + iPos2, '/'))
-            break;
+    relative.append(to, common, string::npos);
+    if (!directory) {
+        relative.pop_back();
     }
-    if (iPos < iSizeA)
-        strcat(const_cast<char*>(retPath.data()), path.c_str() + iPos);
-    retPath.resize(strlen(retPath.c_str()));
-#endif
+    retPath = relative;
 }
 
 void removeWhiteSpace(string& inputString)
@@ -558,19 +1289,28 @@ void removeWhiteSpace(string& inputString)
 
 void findAndReplace(string& inString, const string& search, const string& replace)
 {
-    uint uiPos = 0;
+    size_t uiPos = 0;
     while ((uiPos = inString.find(search, uiPos)) != std::string::npos) {
         inString.replace(uiPos, search.length(), replace);
         uiPos += replace.length();
     }
 }
 
+uint64_t hashString(const string_view inString, uint64_t seed)
+{
+    for (const auto& i : inString) {
+        seed ^= static_cast<unsigned char>(i);
+        seed *= 1099511628211ULL;
+    }
+    return seed;
+}
+
 bool findEnvironmentVariable(const string& envVar)
 {
 #ifdef _WIN32
     return (GetEnvironmentVariableA(envVar.c_str(), NULL, 0) > 0);
 #else
-    return false;
+    return (getenv(envVar.c_str()) != NULL);
 #endif
 }
 
@@ -579,17 +1319,20 @@ void pressKeyToContinue()
 #if _WIN32
     system("pause");
 #else
-    system("read -rsn 1 -p \"Press any key to continue...\"");
+    cout << "Press enter to continue..." << flush;
+    cin.get();
 #endif
 }
 
 void outputLine(const string& message)
 {
+    lock_guard<mutex> lock(s_outputMutex);
     cout << message << endl;
 }
 
 void outputInfo(const string& message, const bool header)
 {
+    lock_guard<mutex> lock(s_outputMutex);
 #if _WIN32
     const HANDLE hstdout = GetStdHandle(STD_OUTPUT_HANDLE);
     CONSOLE_SCREEN_BUFFER_INFO csbi;
@@ -611,6 +1354,7 @@ void outputInfo(const string& message, const bool header)
 
 void outputWarning(const string& message, const bool header)
 {
+    lock_guard<mutex> lock(s_outputMutex);
 #if _WIN32
     const HANDLE hstdout = GetStdHandle(STD_OUTPUT_HANDLE);
     CONSOLE_SCREEN_BUFFER_INFO csbi;
@@ -632,6 +1376,7 @@ void outputWarning(const string& message, const bool header)
 
 void outputError(const string& message, const bool header)
 {
+    lock_guard<mutex> lock(s_outputMutex);
 #if _WIN32
     const HANDLE hstdout = GetStdHandle(STD_OUTPUT_HANDLE);
     CONSOLE_SCREEN_BUFFER_INFO csbi;
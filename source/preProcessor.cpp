@@ -0,0 +1,796 @@
+/*
+ * copyright (c) 2017 Matthew Oliver
+ *
+ * This file is part of ShiftMediaProject.
+ *
+ * ShiftMediaProject is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * ShiftMediaProject is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with ShiftMediaProject; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "preProcessor.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <deque>
+#include <iterator>
+
+// Include recursion is stopped at the same depth as gcc
+static const size_t g_maxIncludeDepth = 200;
+
+/**
+ * Removes any '.' or '..' directories from a path.
+ * @param path The path.
+ * @return The normalised path.
+ */
+static string normalisePath(const string& path)
+{
+    vector<string> parts;
+    size_t startPos = 0;
+    while (startPos <= path.length()) {
+        size_t endPos = path.find_first_of("/\\", startPos);
+        endPos = (endPos == string::npos) ? path.length() : endPos;
+        const string part = path.substr(startPos, endPos - startPos);
+        // Keep any leading '/' used by absolute paths
+        if ((part == ".") || (part.empty() && (startPos > 0))) {
+            // Skip current directory references
+        } else if ((part == "..") && !parts.empty() && (parts.back() != "..") && !parts.back().empty() &&
+            (parts.back().back() != ':')) {
+            parts.pop_back();
+        } else {
+            parts.push_back(part);
+        }
+        startPos = endPos + 1;
+    }
+    string ret;
+    for (size_t i = 0; i < parts.size(); ++i) {
+        ret += (i > 0) ? '/' + parts[i] : parts[i];
+    }
+    return (ret.empty()) ? "." : ret;
+}
+
+/**
+ * Gets the precedence of a binary operator used in a conditional expression.
+ * @param op The operator.
+ * @return The precedence (higher values bind more tightly), 0 if not a binary operator.
+ */
+static int getOperatorPrecedence(const string& op)
+{
+    static const string operators[][4] = {{"||"}, {"&&"}, {"|"}, {"^"}, {"&"}, {"==", "!="}, {"<", ">", "<=", ">="},
+        {"<<", ">>"}, {"+", "-"}, {"*", "/", "%"}};
+    for (int i = 0; i < static_cast<int>(sizeof(operators) / sizeof(operators[0])); ++i) {
+        if (find(begin(operators[i]), end(operators[i]), op) != end(operators[i])) {
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+void PreProcessor::addIncludeDirectory(const string& directory)
+{
+    const string includeDir = normalisePath(directory) + '/';
+    if (find(m_includeDirs.begin(), m_includeDirs.end(), includeDir) == m_includeDirs.end()) {
+        m_includeDirs.push_back(includeDir);
+    }
+}
+
+void PreProcessor::addDefine(const string& name, const string& value)
+{
+    TokenList tokens;
+    tokenize(name + ' ' + value, tokens);
+    defineMacro(tokens);
+    m_defines[name] = std::move(m_macros[name]);
+    m_macros.erase(name);
+}
+
+bool PreProcessor::process(const string& fileName, const string& file, string& retOutput)
+{
+    // Each file starts with only the initial defines
+    m_macros = m_defines;
+    m_onceFiles.clear();
+    m_hideSets.assign(1, set<string>());
+    m_hideSetAdds.clear();
+    m_hideSetMerges.clear();
+    m_hideSetCommons.clear();
+    m_depth = 0;
+    TokenList tokens;
+    tokenize(file, tokens);
+    retOutput.clear();
+    return processTokens(normalisePath(fileName), tokens, retOutput);
+}
+
+void PreProcessor::tokenize(const string_view text, TokenList& retTokens)
+{
+    static const string punctuators[] = {"...", "<<=", ">>=", "->", "++", "--", "<<", ">>", "<=", ">=", "==", "!=",
+        "&&", "||", "*=", "/=", "%=", "+=", "-=", "&=", "^=", "|=", "##"};
+    const size_t length = text.length();
+    bool space = false;
+    size_t pos = 0;
+    while (pos < length) {
+        const char current = text[pos];
+        const char next = (pos + 1 < length) ? text[pos + 1] : '\0';
+        // Join any lines ending in a backslash
+        if ((current == '\\') &&
+            ((next == '\n') || ((next == '\r') && (pos + 2 < length) && (text[pos + 2] == '\n')))) {
+            pos += (next == '\n') ? 2 : 3;
+            continue;
+        }
+        if (current == '\n') {
+            retTokens.push_back({TokenType::NewLine, "\n", false});
+            space = false;
+            ++pos;
+            continue;
+        }
+        if ((current == ' ') || (current == '\t') || (current == '\r') || (current == '\v') || (current == '\f')) {
+            space = true;
+            ++pos;
+            continue;
+        }
+        // Comments are replaced with a single space
+        if ((current == '/') && (next == '/')) {
+            while ((pos < length) && (text[pos] != '\n')) {
+                pos += ((text[pos] == '\\') && (pos + 1 < length) && (text[pos + 1] == '\n')) ? 2 : 1;
+            }
+            space = true;
+            continue;
+        }
+        if ((current == '/') && (next == '*')) {
+            pos = text.find("*/", pos + 2);
+            pos = (pos == string::npos) ? length : pos + 2;
+            space = true;
+            continue;
+        }
+        size_t endPos = pos + 1;
+        TokenType type = TokenType::Punctuator;
+        if ((isalpha(static_cast<unsigned char>(current)) != 0) || (current == '_')) {
+            type = TokenType::Identifier;
+            while ((endPos < length) &&
+                ((isalnum(static_cast<unsigned char>(text[endPos])) != 0) || (text[endPos] == '_'))) {
+                ++endPos;
+            }
+            // Check for prefixed string/character literals
+            const string_view prefix = text.substr(pos, endPos - pos);
+            if ((endPos < length) && ((text[endPos] == '"') || (text[endPos] == '\'')) &&
+                ((prefix == "L") || (prefix == "u") || (prefix == "U") || (prefix == "u8"))) {
+                type = TokenType::Literal;
+            }
+        } else if ((isdigit(static_cast<unsigned char>(current)) != 0) ||
+            ((current == '.') && (isdigit(static_cast<unsigned char>(next)) != 0))) {
+            type = TokenType::Number;
+            while (endPos < length) {
+                const char number = text[endPos];
+                if ((isalnum(static_cast<unsigned char>(number)) != 0) || (number == '_') || (number == '.') ||
+                    (((number == '+') || (number == '-')) && (string("eEpP").find(text[endPos - 1]) != string::npos))) {
+                    ++endPos;
+                } else {
+                    break;
+                }
+            }
+        } else if ((current == '"') || (current == '\'')) {
+            type = TokenType::Literal;
+            endPos = pos;
+        } else {
+            for (const auto& i : punctuators) {
+                if (text.compare(pos, i.length(), i) == 0) {
+                    endPos = pos + i.length();
+                    break;
+                }
+            }
+        }
+        if (type == TokenType::Literal) {
+            // Find the end of the literal (unterminated literals end at the end of the line)
+            const char quote = text[endPos];
+            ++endPos;
+            while ((endPos < length) && (text[endPos] != quote) && (text[endPos] != '\n')) {
+                endPos += ((text[endPos] == '\\') && (endPos + 1 < length)) ? 2 : 1;
+            }
+            endPos = ((endPos < length) && (text[endPos] == quote)) ? endPos + 1 : min(endPos, length);
+        }
+        retTokens.push_back({type, string(text.substr(pos, endPos - pos)), space});
+        space = false;
+        pos = endPos;
+    }
+}
+
+void PreProcessor::outputTokens(const TokenList& tokens, string& retOutput)
+{
+    for (const auto& i : tokens) {
+        if (i.type == TokenType::NewLine) {
+            // Empty lines are not output
+            if (!retOutput.empty() && (retOutput.back() != '\n')) {
+                retOutput += '\n';
+            }
+        } else if (i.type != TokenType::PlaceMarker) {
+            if (i.space && !retOutput.empty() && (retOutput.back() != '\n')) {
+                retOutput += ' ';
+            }
+            retOutput += i.text;
+        }
+    }
+}
+
+bool PreProcessor::processTokens(const string& fileName, const TokenList& tokens, string& retOutput)
+{
+    const size_t dirPos = fileName.rfind('/');
+    const string directory = (dirPos != string::npos) ? fileName.substr(0, dirPos + 1) : "./";
+    vector<Conditional> conditionals;
+    TokenList text;
+    size_t pos = 0;
+    while (pos < tokens.size()) {
+        // Get the end of the current line
+        size_t endPos = pos;
+        while ((endPos < tokens.size()) && (tokens[endPos].type != TokenType::NewLine)) {
+            ++endPos;
+        }
+        const bool active = conditionals.empty() || conditionals.back().active;
+        if ((pos < endPos) && (tokens[pos].type == TokenType::Punctuator) && (tokens[pos].text == "#")) {
+            // Any text before the directive must be expanded using the current macros
+            if (!text.empty()) {
+                TokenList expanded;
+                expandTokens(text, expanded);
+                outputTokens(expanded, retOutput);
+                text.clear();
+            }
+            string directive;
+            TokenList params;
+            if ((pos + 1 < endPos) && (tokens[pos + 1].type == TokenType::Identifier)) {
+                directive = tokens[pos + 1].text;
+                params.assign(tokens.begin() + pos + 2, tokens.begin() + endPos);
+            }
+            if ((directive == "if") || (directive == "ifdef") || (directive == "ifndef")) {
+                bool met = false;
+                if (active && (directive == "if")) {
+                    met = evaluateCondition(params);
+                } else if (active && !params.empty()) {
+                    met = (m_macros.find(params[0].text) != m_macros.end()) == (directive == "ifdef");
+                }
+                conditionals.push_back({met, met, active});
+            } else if ((directive == "elif") || (directive == "else")) {
+                if (!conditionals.empty()) {
+                    Conditional& conditional = conditionals.back();
+                    conditional.active = conditional.parentActive && !conditional.taken &&
+                        ((directive == "else") || evaluateCondition(params));
+                    conditional.taken = conditional.taken || conditional.active;
+                }
+            } else if (directive == "endif") {
+                if (!conditionals.empty()) {
+                    conditionals.pop_back();
+                }
+            } else if (active) {
+                if (directive == "include") {
+                    if (!processInclude(directory, params, retOutput)) {
+                        return false;
+                    }
+                } else if (directive == "define") {
+                    defineMacro(params);
+                } else if (directive == "undef") {
+                    if (!params.empty()) {
+                        m_macros.erase(params[0].text);
+                    }
+                } else if ((directive == "pragma") && !params.empty() && (params[0].text == "once")) {
+                    m_onceFiles.insert(fileName);
+                }
+            }
+        } else if (active) {
+            text.insert(text.end(), tokens.begin() + pos, tokens.begin() + min(endPos + 1, tokens.size()));
+        }
+        pos = endPos + 1;
+    }
+    if (!text.empty()) {
+        TokenList expanded;
+        expandTokens(text, expanded);
+        outputTokens(expanded, retOutput);
+    }
+    if (!retOutput.empty() && (retOutput.back() != '\n')) {
+        retOutput += '\n';
+    }
+    return true;
+}
+
+bool PreProcessor::processInclude(const string& directory, const TokenList& tokens, string& retOutput)
+{
+    // The included file name may be given using a macro
+    TokenList expanded;
+    if (!tokens.empty() && (tokens[0].type == TokenType::Identifier)) {
+        expandTokens(tokens, expanded);
+    }
+    const TokenList& include = (expanded.empty()) ? tokens : expanded;
+    if (include.empty()) {
+        return true;
+    }
+    string name;
+    string searchDir;
+    if ((include[0].type == TokenType::Literal) && (include[0].text[0] == '"') && (include[0].text.length() >= 2)) {
+        name = include[0].text.substr(1, include[0].text.length() - 2);
+        searchDir = directory;
+    } else if (include[0].text == "<") {
+        for (size_t i = 1; (i < include.size()) && (include[i].text != ">"); ++i) {
+            name += ((include[i].space && (i > 1)) ? " " : "") + include[i].text;
+        }
+    } else {
+        return true;
+    }
+    string fileName;
+    if (!findInclude(name, searchDir, fileName) || (m_onceFiles.find(fileName) != m_onceFiles.end()) ||
+        (m_depth >= g_maxIncludeDepth)) {
+        return true;
+    }
+    auto file = m_files.find(fileName);
+    if (file == m_files.end()) {
+        string contents;
+        if (!loadFromFile(fileName, contents)) {
+            return false;
+        }
+        file = m_files.emplace(fileName, TokenList()).first;
+        tokenize(contents, file->second);
+    }
+    m_includedFiles.insert(fileName);
+    ++m_depth;
+    const bool ret = processTokens(fileName, file->second, retOutput);
+    --m_depth;
+    return ret;
+}
+
+bool PreProcessor::findInclude(const string& name, const string& directory, string& retFileName)
+{
+    const string key = directory + '\n' + name;
+    const auto found = m_includes.find(key);
+    if (found != m_includes.end()) {
+        retFileName = found->second;
+        return !retFileName.empty();
+    }
+    // Files are searched for relative to the current file first and then in each include directory
+    vector<string> searchDirs = m_includeDirs;
+    if (!directory.empty()) {
+        searchDirs.insert(searchDirs.begin(), directory);
+    }
+    retFileName.clear();
+    for (const auto& i : searchDirs) {
+        const string fileName = normalisePath(i + name);
+        string foundName;
+        if (findIndexedFile(fileName, foundName)) {
+            retFileName = fileName;
+            break;
+        }
+    }
+    m_includes[key] = retFileName;
+    // Only files included using quotes are expected to be found (system headers are always skipped)
+    if (retFileName.empty() && !directory.empty()) {
+        outputInfo("Pre-processor could not find included file (" + name + "), skipping");
+    }
+    return !retFileName.empty();
+}
+
+size_t PreProcessor::findMacroParam(const Macro& macro, const Token& token)
+{
+    if (token.type != TokenType::Identifier) {
+        return string::npos;
+    }
+    const auto param = find(macro.params.begin(), macro.params.end(), token.text);
+    return (param == macro.params.end()) ? string::npos : param - macro.params.begin();
+}
+
+void PreProcessor::defineMacro(const TokenList& tokens)
+{
+    if (tokens.empty() || (tokens[0].type != TokenType::Identifier)) {
+        return;
+    }
+    Macro macro;
+    size_t pos = 1;
+    // Function like macros must have the parameter list directly after the name
+    if ((pos < tokens.size()) && (tokens[pos].text == "(") && !tokens[pos].space) {
+        macro.function = true;
+        for (++pos; (pos < tokens.size()) && (tokens[pos].text != ")"); ++pos) {
+            if (tokens[pos].type == TokenType::Identifier) {
+                macro.params.push_back(tokens[pos].text);
+            } else if (tokens[pos].text == "...") {
+                macro.variadic = true;
+                // Unnamed variable arguments are accessed using __VA_ARGS__
+                if (tokens[pos - 1].type != TokenType::Identifier) {
+                    macro.params.emplace_back("__VA_ARGS__");
+                }
+            }
+        }
+        ++pos;
+    }
+    if (pos < tokens.size()) {
+        macro.body.assign(tokens.begin() + pos, tokens.end());
+        macro.body[0].space = false;
+    }
+    m_macros[tokens[0].text] = std::move(macro);
+}
+
+void PreProcessor::expandTokens(const TokenList& tokens, TokenList& retTokens)
+{
+    deque<Token> input(tokens.begin(), tokens.end());
+    while (!input.empty()) {
+        Token token = std::move(input.front());
+        input.pop_front();
+        const auto macro = (token.type == TokenType::Identifier) ? m_macros.find(token.text) : m_macros.end();
+        const set<string>& hidden = m_hideSets[token.hideSet];
+        if ((macro == m_macros.end()) || (hidden.find(token.text) != hidden.end())) {
+            retTokens.push_back(std::move(token));
+            continue;
+        }
+        TokenList replaced;
+        if (!macro->second.function) {
+            substituteMacro(macro->second, vector<TokenList>(), addHideSet(token.hideSet, token.text), replaced);
+        } else {
+            // Function like macros are only expanded when followed by an argument list
+            size_t pos = 0;
+            while ((pos < input.size()) && (input[pos].type == TokenType::NewLine)) {
+                ++pos;
+            }
+            if ((pos == input.size()) || (input[pos].type != TokenType::Punctuator) || (input[pos].text != "(")) {
+                retTokens.push_back(std::move(token));
+                continue;
+            }
+            // Split the arguments at each top level comma
+            vector<TokenList> args(1);
+            size_t depth = 0;
+            bool space = false;
+            for (++pos; pos < input.size(); ++pos) {
+                const Token& arg = input[pos];
+                if (arg.type == TokenType::NewLine) {
+                    space = true;
+                    continue;
+                }
+                if (arg.type == TokenType::Punctuator) {
+                    if (arg.text == "(") {
+                        ++depth;
+                    } else if (arg.text == ")") {
+                        if (depth == 0) {
+                            break;
+                        }
+                        --depth;
+                    } else if ((arg.text == ",") && (depth == 0)) {
+                        args.emplace_back();
+                        continue;
+                    }
+                }
+                args.back().push_back(arg);
+                args.back().back().space = args.back().back().space || space;
+                space = false;
+            }
+            if (pos == input.size()) {
+                // Incomplete argument lists are left unchanged
+                retTokens.push_back(std::move(token));
+                continue;
+            }
+            const size_t hideSet = addHideSet(commonHideSets(token.hideSet, input[pos].hideSet), token.text);
+            input.erase(input.begin(), input.begin() + pos + 1);
+            substituteMacro(macro->second, args, hideSet, replaced);
+        }
+        // The replacement is scanned again along with the rest of the input
+        if (!replaced.empty()) {
+            replaced[0].space = token.space;
+        }
+        input.insert(input.begin(), replaced.begin(), replaced.end());
+    }
+}
+
+void PreProcessor::substituteMacro(
+    const Macro& macro, const vector<TokenList>& args, const size_t hideSet, TokenList& retTokens)
+{
+    vector<TokenList> params = args;
+    if (macro.function) {
+        if (macro.params.empty() && (params.size() == 1) && params[0].empty()) {
+            params.clear();
+        }
+        // Combine any variable arguments into the last parameter
+        if (macro.variadic && !macro.params.empty() && (params.size() > macro.params.size())) {
+            TokenList& last = params[macro.params.size() - 1];
+            for (size_t i = macro.params.size(); i < params.size(); ++i) {
+                last.push_back({TokenType::Punctuator, ",", false});
+                last.insert(last.end(), params[i].begin(), params[i].end());
+            }
+        }
+        params.resize(macro.params.size());
+    }
+    vector<TokenList> expandedParams(params.size());
+    vector<bool> expanded(params.size(), false);
+    TokenList tokens;
+    const TokenList& body = macro.body;
+    for (size_t i = 0; i < body.size(); ++i) {
+        const Token& token = body[i];
+        const size_t param = findMacroParam(macro, token);
+        const bool isPunctuator = (token.type == TokenType::Punctuator);
+        if (macro.function && isPunctuator && (token.text == "#") && (i + 1 < body.size()) &&
+            (findMacroParam(macro, body[i + 1]) != string::npos)) {
+            // Convert the argument to a string literal
+            string text = "\"";
+            for (const auto& j : params[findMacroParam(macro, body[++i])]) {
+                if (j.space && (text.length() > 1)) {
+                    text += ' ';
+                }
+                for (const auto& k : j.text) {
+                    if ((j.type == TokenType::Literal) && ((k == '"') || (k == '\\'))) {
+                        text += '\\';
+                    }
+                    text += k;
+                }
+            }
+            tokens.push_back({TokenType::Literal, text + '"', token.space});
+        } else if (isPunctuator && (token.text == "##") && !tokens.empty() && (i + 1 < body.size())) {
+            // Paste the previous token with the next one
+            const Token& next = body[++i];
+            const size_t nextParam = findMacroParam(macro, next);
+            TokenList right;
+            if (nextParam == string::npos) {
+                right.push_back(next);
+            } else {
+                right = params[nextParam];
+            }
+            if (right.empty()) {
+                // Remove the comma before empty variable arguments (supported by both msvc and gcc)
+                if (macro.variadic && (nextParam == macro.params.size() - 1) && (tokens.back().text == ",")) {
+                    tokens.pop_back();
+                }
+                continue;
+            }
+            const Token left = std::move(tokens.back());
+            tokens.pop_back();
+            if (left.type == TokenType::PlaceMarker) {
+                right[0].space = left.space;
+                tokens.insert(tokens.end(), right.begin(), right.end());
+            } else {
+                TokenList pasted;
+                tokenize(left.text + right[0].text, pasted);
+                if (!pasted.empty()) {
+                    pasted[0].space = left.space;
+                }
+                tokens.insert(tokens.end(), pasted.begin(), pasted.end());
+                tokens.insert(tokens.end(), right.begin() + 1, right.end());
+            }
+        } else if (param != string::npos) {
+            const size_t start = tokens.size();
+            if ((i + 1 < body.size()) && (body[i + 1].type == TokenType::Punctuator) && (body[i + 1].text == "##")) {
+                // Arguments used with '##' are not expanded
+                if (params[param].empty()) {
+                    tokens.push_back({TokenType::PlaceMarker, "", false});
+                }
+                tokens.insert(tokens.end(), params[param].begin(), params[param].end());
+            } else {
+                if (!expanded[param]) {
+                    expandTokens(params[param], expandedParams[param]);
+                    expanded[param] = true;
+                }
+                tokens.insert(tokens.end(), expandedParams[param].begin(), expandedParams[param].end());
+            }
+            if (tokens.size() > start) {
+                tokens[start].space = token.space;
+            }
+        } else {
+            tokens.push_back(token);
+        }
+    }
+    // Prevent the macro from being expanded again within its own replacement
+    retTokens.reserve(tokens.size());
+    for (auto& i : tokens) {
+        if (i.type != TokenType::PlaceMarker) {
+            i.hideSet = mergeHideSets(i.hideSet, hideSet);
+            retTokens.push_back(std::move(i));
+        }
+    }
+}
+
+bool PreProcessor::evaluateCondition(const TokenList& tokens)
+{
+    // Replace any 'defined' operators first so that their operands are not expanded
+    TokenList replaced;
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        if ((tokens[i].type == TokenType::Identifier) && (tokens[i].text == "defined")) {
+            size_t pos = i + 1;
+            const bool parenthesis = (pos < tokens.size()) && (tokens[pos].text == "(");
+            pos += (parenthesis) ? 1 : 0;
+            if ((pos < tokens.size()) && (tokens[pos].type == TokenType::Identifier)) {
+                const bool defined = (m_macros.find(tokens[pos].text) != m_macros.end());
+                replaced.push_back({TokenType::Number, (defined) ? "1" : "0", tokens[i].space});
+                i = (parenthesis && (pos + 1 < tokens.size()) && (tokens[pos + 1].text == ")")) ? pos + 1 : pos;
+                continue;
+            }
+        }
+        replaced.push_back(tokens[i]);
+    }
+    TokenList expanded;
+    expandTokens(replaced, expanded);
+    size_t pos = 0;
+    return evaluateTernary(expanded, pos) != 0;
+}
+
+int64_t PreProcessor::evaluateTernary(const TokenList& tokens, size_t& pos) const
+{
+    const int64_t value = evaluateBinary(tokens, pos, 1);
+    if ((pos < tokens.size()) && (tokens[pos].text == "?")) {
+        ++pos;
+        const int64_t value2 = evaluateTernary(tokens, pos);
+        if ((pos < tokens.size()) && (tokens[pos].text == ":")) {
+            ++pos;
+        }
+        const int64_t value3 = evaluateTernary(tokens, pos);
+        return (value != 0) ? value2 : value3;
+    }
+    return value;
+}
+
+int64_t PreProcessor::evaluateBinary(const TokenList& tokens, size_t& pos, const int minPrecedence) const
+{
+    int64_t value = evaluateUnary(tokens, pos);
+    while (pos < tokens.size()) {
+        const string& op = tokens[pos].text;
+        const int precedence = (tokens[pos].type == TokenType::Punctuator) ? getOperatorPrecedence(op) : 0;
+        if ((precedence == 0) || (precedence < minPrecedence)) {
+            break;
+        }
+        ++pos;
+        const int64_t value2 = evaluateBinary(tokens, pos, precedence + 1);
+        if (op == "||") {
+            value = ((value != 0) || (value2 != 0)) ? 1 : 0;
+        } else if (op == "&&") {
+            value = ((value != 0) && (value2 != 0)) ? 1 : 0;
+        } else if (op == "|") {
+            value |= value2;
+        } else if (op == "^") {
+            value ^= value2;
+        } else if (op == "&") {
+            value &= value2;
+        } else if (op == "==") {
+            value = (value == value2) ? 1 : 0;
+        } else if (op == "!=") {
+            value = (value != value2) ? 1 : 0;
+        } else if (op == "<") {
+            value = (value < value2) ? 1 : 0;
+        } else if (op == ">") {
+            value = (value > value2) ? 1 : 0;
+        } else if (op == "<=") {
+            value = (value <= value2) ? 1 : 0;
+        } else if (op == ">=") {
+            value = (value >= value2) ? 1 : 0;
+        } else if (op == "<<") {
+            value = static_cast<int64_t>(static_cast<uint64_t>(value) << (value2 & 63));
+        } else if (op == ">>") {
+            value >>= (value2 & 63);
+        } else if (op == "+") {
+            value += value2;
+        } else if (op == "-") {
+            value -= value2;
+        } else if (op == "*") {
+            value *= value2;
+        } else if (op == "/") {
+            value = (value2 != 0) ? value / value2 : 0;
+        } else if (op == "%") {
+            value = (value2 != 0) ? value % value2 : 0;
+        }
+    }
+    return value;
+}
+
+int64_t PreProcessor::evaluateUnary(const TokenList& tokens, size_t& pos) const
+{
+    if (pos >= tokens.size()) {
+        return 0;
+    }
+    const Token& token = tokens[pos++];
+    if (token.type == TokenType::Punctuator) {
+        if (token.text == "(") {
+            const int64_t value = evaluateTernary(tokens, pos);
+            if ((pos < tokens.size()) && (tokens[pos].text == ")")) {
+                ++pos;
+            }
+            return value;
+        }
+        if (token.text == "!") {
+            return (evaluateUnary(tokens, pos) == 0) ? 1 : 0;
+        }
+        if (token.text == "~") {
+            return ~evaluateUnary(tokens, pos);
+        }
+        if (token.text == "-") {
+            return -evaluateUnary(tokens, pos);
+        }
+        if (token.text == "+") {
+            return evaluateUnary(tokens, pos);
+        }
+    } else if (token.type == TokenType::Number) {
+        // Remove any integer suffix
+        const string number = token.text.substr(0, token.text.find_last_not_of("uUlL") + 1);
+        return static_cast<int64_t>(strtoull(number.c_str(), nullptr, 0));
+    } else if ((token.type == TokenType::Literal) && (token.text[0] == '\'') && (token.text.length() >= 3)) {
+        if (token.text[1] != '\\') {
+            return static_cast<unsigned char>(token.text[1]);
+        }
+        static const string escapes = "ntr0";
+        static const char escapeValues[] = {'\n', '\t', '\r', '\0'};
+        const size_t escape = escapes.find(token.text[2]);
+        return (escape != string::npos) ? escapeValues[escape] : static_cast<unsigned char>(token.text[2]);
+    } else if ((token.type == TokenType::Identifier) && (token.text == "defined")) {
+        // Handles any 'defined' operators created by macro expansion
+        const bool parenthesis = (pos < tokens.size()) && (tokens[pos].text == "(");
+        pos += (parenthesis) ? 1 : 0;
+        const bool defined = (pos < tokens.size()) && (m_macros.find(tokens[pos].text) != m_macros.end());
+        ++pos;
+        if (parenthesis && (pos < tokens.size()) && (tokens[pos].text == ")")) {
+            ++pos;
+        }
+        return (defined) ? 1 : 0;
+    }
+    // Any remaining identifiers are replaced with 0
+    return 0;
+}
+
+size_t PreProcessor::addHideSet(const size_t hideSet, const string& name)
+{
+    if (m_hideSets[hideSet].find(name) != m_hideSets[hideSet].end()) {
+        return hideSet;
+    }
+    const auto found = m_hideSetAdds.find({hideSet, name});
+    if (found != m_hideSetAdds.end()) {
+        return found->second;
+    }
+    set<string> newSet = m_hideSets[hideSet];
+    newSet.insert(name);
+    m_hideSets.push_back(std::move(newSet));
+    m_hideSetAdds[{hideSet, name}] = m_hideSets.size() - 1;
+    return m_hideSets.size() - 1;
+}
+
+size_t PreProcessor::mergeHideSets(const size_t hideSet, const size_t hideSet2)
+{
+    if ((hideSet == hideSet2) || (hideSet2 == 0)) {
+        return hideSet;
+    }
+    if (hideSet == 0) {
+        return hideSet2;
+    }
+    const auto found = m_hideSetMerges.find({hideSet, hideSet2});
+    if (found != m_hideSetMerges.end()) {
+        return found->second;
+    }
+    set<string> newSet = m_hideSets[hideSet];
+    newSet.insert(m_hideSets[hideSet2].begin(), m_hideSets[hideSet2].end());
+    size_t ret = hideSet;
+    if (newSet.size() == m_hideSets[hideSet2].size()) {
+        ret = hideSet2;
+    } else if (newSet.size() != m_hideSets[hideSet].size()) {
+        m_hideSets.push_back(std::move(newSet));
+        ret = m_hideSets.size() - 1;
+    }
+    m_hideSetMerges[{hideSet, hideSet2}] = ret;
+    return ret;
+}
+
+size_t PreProcessor::commonHideSets(const size_t hideSet, const size_t hideSet2)
+{
+    if ((hideSet == hideSet2) || (hideSet == 0) || (hideSet2 == 0)) {
+        return (hideSet == hideSet2) ? hideSet : 0;
+    }
+    const auto found = m_hideSetCommons.find({hideSet, hideSet2});
+    if (found != m_hideSetCommons.end()) {
+        return found->second;
+    }
+    set<string> newSet;
+    set_intersection(m_hideSets[hideSet].begin(), m_hideSets[hideSet].end(), m_hideSets[hideSet2].begin(),
+        m_hideSets[hideSet2].end(), inserter(newSet, newSet.begin()));
+    size_t ret = 0;
+    if (newSet.size() == m_hideSets[hideSet].size()) {
+        ret = hideSet;
+    } else if (newSet.size() == m_hideSets[hideSet2].size()) {
+        ret = hideSet2;
+    } else if (!newSet.empty()) {
+        m_hideSets.push_back(std::move(newSet));
+        ret = m_hideSets.size() - 1;
+    }
+    m_hideSetCommons[{hideSet, hideSet2}] = ret;
+    return ret;
+}
@@ -21,6 +21,7 @@
 #include "projectGenerator.h"
 
 #include <algorithm>
+#include <cctype>
 #include <iomanip>
 #include <utility>
 
@@ -36,8 +37,17 @@
 #define TEMPLATE_FILE_PROPS_ID 110
 #define TEMPLATE_SLN_NOWINRT_ID 111
 
+ProjectGenerator::ProjectGenerator(const ConfigGenerator& configHelper, const string& tempDirectory)
+    : m_tempDirectory(tempDirectory)
+    , m_configHelper(configHelper)
+{}
+
 bool ProjectGenerator::passAllMake()
 {
+    // Index the source and solution directories so that searching for source files doesn't need to access the disk
+    indexFiles(m_configHelper.m_rootDirectory);
+    indexFiles(m_configHelper.m_solutionDirectory);
+
     // Copy the required props files to output directory
     string propsFile, propsFileWinRT;
     if (!loadFromResourceFile(TEMPLATE_PROPS_ID, propsFile) ||
@@ -60,42 +70,86 @@ bool ProjectGenerator::passAllMake()
         return false;
     }
 
-    // Loop through each library make file
+    // Create a separate project for each library make file
     vector<string> libraries;
     m_configHelper.getConfigList("LIBRARY_LIST", libraries);
+    vector<ProjectGenerator> projects;
+    projects.reserve(libraries.size());
     for (const auto& i : libraries) {
         // Check if library is enabled
         if (m_configHelper.isConfigOptionEnabled(i)) {
-            m_projectDir = m_configHelper.m_rootDirectory + "lib" + i + "/";
-            const uint pos = m_projectDir.rfind('/', m_projectDir.length() - 2) + 1;
-            m_projectName = m_projectDir.substr(pos, m_projectDir.length() - 1 - pos);
+            projects.emplace_back(m_configHelper, m_tempDirectory);
+            ProjectGenerator& project = projects.back();
+            project.m_projectDir = m_configHelper.m_rootDirectory + "lib" + i + "/";
+            const size_t pos = project.m_projectDir.rfind('/', project.m_projectDir.length() - 2) + 1;
+            project.m_projectName = project.m_projectDir.substr(pos, project.m_projectDir.length() - 1 - pos);
             // Locate the project dir for specified library
             string retFileName;
-            if (!findFile(m_projectDir + "MakeFile", retFileName)) {
+            if (!findFile(project.m_projectDir + "MakeFile", retFileName)) {
                 outputError("Could not locate directory for library (" + i + ")");
                 return false;
             }
-            // Run passMake on default Makefile
-            if (!passMake()) {
-                return false;
+        }
+    }
+
+    // Get the other libraries that each project depends on
+    vector<vector<size_t>> dependencies(projects.size());
+    for (size_t i = 0; i < projects.size(); ++i) {
+        StaticList libs;
+        projects[i].buildInterDependencies(libs);
+        for (size_t j = 0; j < projects.size(); ++j) {
+            if ((j != i) && (find(libs.begin(), libs.end(), projects[j].m_projectName) != libs.end())) {
+                dependencies[i].push_back(j);
             }
-            // Check for any sub directories
-            m_projectDir += "x86/";
-            if (findFile(m_projectDir + "MakeFile", retFileName)) {
-                // Pass the sub directory
-                if (!passMake()) {
-                    return false;
+        }
+    }
+
+    // Start each project once all the projects it depends on have been started
+    vector<shared_future<bool>> results(projects.size());
+    vector<bool> started(projects.size(), false);
+    size_t remaining = projects.size();
+    bool ret = true;
+    while (remaining > 0) {
+        bool found = false;
+        for (size_t i = 0; i < projects.size(); ++i) {
+            if (started[i]) {
+                continue;
+            }
+            vector<shared_future<bool>> waits;
+            for (const auto& j : dependencies[i]) {
+                if (!started[j]) {
+                    break;
                 }
+                waits.push_back(results[j]);
             }
-            // Reset project dir so it does not include additions
-            m_projectDir.resize(m_projectDir.length() - 4);
-            // Output the project
-            if (!outputProject()) {
-                return false;
+            if (waits.size() == dependencies[i].size()) {
+                results[i] = async(launch::async, &ProjectGenerator::passProject, &projects[i], waits).share();
+                started[i] = true;
+                --remaining;
+                found = true;
             }
-            outputProjectCleanup();
+        }
+        if (!found) {
+            outputError("Circular dependency detected between libraries");
+            ret = false;
+            break;
+        }
+    }
+
+    // Wait for all projects to complete
+    for (size_t i = 0; i < projects.size(); ++i) {
+        if (started[i]) {
+            ret = results[i].get() && ret;
         }
     }
+    if (!ret) {
+        return false;
+    }
+
+    // Keep each projects dependencies for use in the solution
+    for (const auto& i : projects) {
+        m_projectLibs.insert(i.m_projectLibs.begin(), i.m_projectLibs.end());
+    }
 
     // Output the solution file
     if (!outputSolution()) {
@@ -109,81 +163,198 @@ bool ProjectGenerator::passAllMake()
     return true;
 }
 
-void ProjectGenerator::deleteCreatedFiles()
+void ProjectGenerator::deleteCreatedFiles(const bool staleOnly)
 {
     // Get list of libraries and programs
     vector<string> libraries;
     m_configHelper.getConfigList("LIBRARY_LIST", libraries);
+    for (auto& i : libraries) {
+        i = "lib" + i;
+    }
     vector<string> programs;
     m_configHelper.getConfigList("PROGRAM_LIST", programs);
 
-    // Delete any previously generated files
+    // Get any previously generated files from the manifest written by the last run
     vector<string> existingFiles;
-    findFiles(m_configHelper.m_solutionDirectory + "ffmpeg.sln", existingFiles, false);
-    findFiles(m_configHelper.m_solutionDirectory + "libav.sln", existingFiles, false);
-    findFiles(m_configHelper.m_solutionDirectory + "ffmpeg_with_latest_sdk.bat", existingFiles, false);
-    findFiles(m_configHelper.m_solutionDirectory + "libav_with_latest_sdk.bat", existingFiles, false);
-    findFiles(m_configHelper.m_solutionDirectory + "smp_deps.props", existingFiles, false);
-    findFiles(m_configHelper.m_solutionDirectory + "smp_winrt_deps.props", existingFiles, false);
-    for (auto& i : libraries) {
-        i = "lib" + i;
-        findFiles(m_configHelper.m_solutionDirectory + i + ".vcxproj", existingFiles, false);
-        findFiles(m_configHelper.m_solutionDirectory + i + ".vcxproj.filters", existingFiles, false);
-        findFiles(m_configHelper.m_solutionDirectory + i + "_winrt.vcxproj", existingFiles, false);
-        findFiles(m_configHelper.m_solutionDirectory + i + "_winrt.vcxproj.filters", existingFiles, false);
-        findFiles(m_configHelper.m_solutionDirectory + i + ".def", existingFiles, false);
-        findFiles(m_configHelper.m_solutionDirectory + i + "_files.props", existingFiles, false);
+    const string manifestFile = m_configHelper.m_solutionDirectory + "ffvs_manifest.txt";
+    string manifest;
+    if (loadFromFile(manifestFile, manifest, false, false)) {
+        size_t pos = 0;
+        while (pos < manifest.length()) {
+            size_t end = manifest.find('\n', pos);
+            end = (end == string::npos) ? manifest.length() : end;
+            string fileName = manifest.substr(pos, end - pos);
+            if (!fileName.empty() && (fileName.back() == '\r')) {
+                fileName.pop_back();
+            }
+            // Only files that could have been generated are deleted in case the manifest has been modified
+            if (!fileName.empty() && isCreatedFile(fileName, libraries, programs)) {
+                existingFiles.push_back(m_configHelper.m_solutionDirectory + fileName);
+            }
+            pos = end + 1;
+        }
+    } else {
+        // Without a manifest each location that files are generated in must be searched instead
+        vector<string> foundFiles;
+        findIndexedFiles(m_configHelper.m_solutionDirectory + "*", foundFiles, false);
+        for (const auto& i : libraries) {
+            findIndexedFiles(m_configHelper.m_solutionDirectory + i + "/*", foundFiles, false);
+        }
+        for (const auto& i : programs) {
+            findIndexedFiles(m_configHelper.m_solutionDirectory + i + "/*", foundFiles, false);
+        }
+        for (const auto& i : foundFiles) {
+            if (isCreatedFile(i.substr(m_configHelper.m_solutionDirectory.length()), libraries, programs)) {
+                existingFiles.push_back(i);
+            }
+        }
     }
-    for (const auto& i : programs) {
-        findFiles(m_configHelper.m_solutionDirectory + i + ".vcxproj", existingFiles, false);
-        findFiles(m_configHelper.m_solutionDirectory + i + ".vcxproj.filters", existingFiles, false);
-        findFiles(m_configHelper.m_solutionDirectory + i + ".def", existingFiles, false);
+
+    // Get any files generated during the current run
+    vector<string> writtenFiles;
+    getWrittenFiles(m_configHelper.m_solutionDirectory, writtenFiles);
+    if (!staleOnly) {
+        for (const auto& i : writtenFiles) {
+            if (isCreatedFile(i, libraries, programs)) {
+                existingFiles.push_back(m_configHelper.m_solutionDirectory + i);
+            }
+        }
     }
+
+    // Delete any previously generated files
     for (const auto& i : existingFiles) {
-        deleteFile(i);
+        if (!staleOnly || !isFileWritten(i)) {
+            deleteFile(i);
+        }
     }
 
-    // Check for any created folders
-    vector<string> existingFolders;
+    // Check if any created directories are now empty and delete if they are
     for (const auto& i : libraries) {
-        findFolders(m_configHelper.m_solutionDirectory + i, existingFolders, false);
+        if (isFolderEmpty(m_configHelper.m_solutionDirectory + i)) {
+            deleteFolder(m_configHelper.m_solutionDirectory + i);
+        }
     }
     for (const auto& i : programs) {
-        findFolders(m_configHelper.m_solutionDirectory + i, existingFolders, false);
-    }
-    for (const auto& i : existingFolders) {
-        // Search for any generated files in the directories
-        existingFiles.resize(0);
-        findFiles(i + "/dce_defs.c", existingFiles, false);
-        findFiles(i + "/*_wrap.c", existingFiles, false);
-        if (!m_configHelper.m_usingExistingConfig) {
-            findFiles(i + "/*_list.c", existingFiles, false);
+        if (isFolderEmpty(m_configHelper.m_solutionDirectory + i)) {
+            deleteFolder(m_configHelper.m_solutionDirectory + i);
         }
-        for (auto& j : existingFiles) {
-            deleteFile(j);
+    }
+
+    if (staleOnly) {
+        // Write a new manifest containing all the generated files that still exist
+        manifest.clear();
+        for (const auto& i : writtenFiles) {
+            string found;
+            if (isCreatedFile(i, libraries, programs) &&
+                findIndexedFile(m_configHelper.m_solutionDirectory + i, found)) {
+                manifest += i + '\n';
+            }
         }
-        // Check if the directory is now empty and delete if it is
-        if (isFolderEmpty(i)) {
-            deleteFolder(i);
+        writeToFile(manifestFile, manifest);
+    } else {
+        deleteFile(manifestFile);
+    }
+}
+
+bool ProjectGenerator::isCreatedFile(
+    const string& fileName, const vector<string>& libraries, const vector<string>& programs) const
+{
+    const size_t pos = fileName.find_first_of("/\\");
+    if (pos == string::npos) {
+        // Check for any files generated in the solution directory
+        static const string solutionFiles[] = {"ffmpeg.sln", "libav.sln", "ffmpeg_with_latest_sdk.bat",
+            "libav_with_latest_sdk.bat", "smp_deps.props", "smp_winrt_deps.props"};
+        static const string libraryExtensions[] = {
+            ".vcxproj", ".vcxproj.filters", "_winrt.vcxproj", "_winrt.vcxproj.filters", ".def", "_files.props"};
+        static const string programExtensions[] = {".vcxproj", ".vcxproj.filters", ".def"};
+        if (find(begin(solutionFiles), end(solutionFiles), fileName) != end(solutionFiles)) {
+            return true;
+        }
+        for (const auto& i : libraries) {
+            if (fileName.compare(0, i.length(), i) == 0 &&
+                find(begin(libraryExtensions), end(libraryExtensions), fileName.substr(i.length())) !=
+                    end(libraryExtensions)) {
+                return true;
+            }
         }
+        for (const auto& i : programs) {
+            if (fileName.compare(0, i.length(), i) == 0 &&
+                find(begin(programExtensions), end(programExtensions), fileName.substr(i.length())) !=
+                    end(programExtensions)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Check for any source files generated directly within a project directory
+    const string folder = fileName.substr(0, pos);
+    const string name = fileName.substr(pos + 1);
+    if ((name.find_first_of("/\\") != string::npos) ||
+        ((find(libraries.begin(), libraries.end(), folder) == libraries.end()) &&
+            (find(programs.begin(), programs.end(), folder) == programs.end()))) {
+        return false;
+    }
+    if (name == "dce_defs.c") {
+        return true;
+    }
+    const string wrapSuffix = "_wrap.c";
+    if ((name.length() > wrapSuffix.length()) &&
+        (name.compare(name.length() - wrapSuffix.length(), wrapSuffix.length(), wrapSuffix) == 0)) {
+        return true;
     }
+    const string listSuffix = "_list.c";
+    return !m_configHelper.m_usingExistingConfig && (name.length() > listSuffix.length()) &&
+        (name.compare(name.length() - listSuffix.length(), listSuffix.length(), listSuffix) == 0);
 }
 
 void ProjectGenerator::errorFunc(const bool cleanupFiles)
 {
     if (cleanupFiles) {
-        // Cleanup any partially created files
-        m_configHelper.deleteCreatedFiles();
-        deleteCreatedFiles();
-
-        // Delete any temporary file leftovers
-        deleteFolder(m_tempDirectory);
+        cleanupCreatedFiles();
     }
 
     pressKeyToContinue();
     exit(1);
 }
 
+void ProjectGenerator::cleanupCreatedFiles()
+{
+    // Cleanup any partially created files
+    m_configHelper.deleteCreatedFiles();
+    deleteCreatedFiles();
+
+    // Delete any temporary file leftovers
+    deleteFolder(m_tempDirectory);
+}
+
+bool ProjectGenerator::passProject(const vector<shared_future<bool>>& dependencies)
+{
+    // Wait for any libraries that this one depends on
+    for (const auto& i : dependencies) {
+        if (!i.get()) {
+            return false;
+        }
+    }
+    // Run passMake on default Makefile
+    if (!passMake()) {
+        return false;
+    }
+    // Check for any sub directories
+    m_projectDir += "x86/";
+    string retFileName;
+    if (findFile(m_projectDir + "MakeFile", retFileName)) {
+        // Pass the sub directory
+        if (!passMake()) {
+            return false;
+        }
+    }
+    // Reset project dir so it does not include additions
+    m_projectDir.resize(m_projectDir.length() - 4);
+    // Output the project
+    return outputProject();
+}
+
 bool ProjectGenerator::outputProject()
 {
     // Check all files are correctly located
@@ -413,7 +584,6 @@ bool ProjectGenerator::outputProgramProject(const string& destinationFile, const
 void ProjectGenerator::outputProjectCleanup()
 {
     // Reset all internal values
-    m_inLine.clear();
     m_includes.clear();
     m_replaceIncludes.clear();
     m_includesCPP.clear();
@@ -453,7 +623,7 @@ bool ProjectGenerator::outputSolution()
     // Next add the projects
     for (const auto& i : programList) {
         // Check if program is enabled
-        if (m_configHelper.getConfigOptionPrefixed(i.second)->m_value.compare("1") == 0) {
+        if (m_configHelper.isConfigValueEnabled(m_configHelper.getConfigOptionPrefixed(i.second))) {
             m_projectDir = m_configHelper.m_rootDirectory;
             // Create project files for program
             m_projectName = i.first;
@@ -506,11 +676,11 @@ bool ProjectGenerator::outputSolution()
 
     // Find the start of the file
     const string fileStart = "Project";
-    uint pos = solutionFile.find(fileStart) - 2;
+    size_t pos = solutionFile.find(fileStart) - 2;
     for (const auto& i : m_projectLibs) {
         // Check if this is a library or a program
         if (programList.find(i.first) == programList.end()) {
-            for (uint winrt = 0; winrt < (winrtEnabled ? 2U : 1U); ++winrt) {
+            for (size_t winrt = 0; winrt < (winrtEnabled ? 2U : 1U); ++winrt) {
                 string name = i.first;
                 if (winrt > 0) {
                     name += "_winrt";
@@ -569,7 +739,7 @@ bool ProjectGenerator::outputSolution()
     vector<string> addedPrograms;
     for (const auto& i : programList) {
         // Check if program is enabled
-        if (m_configHelper.getConfigOptionPrefixed(i.second)->m_value.compare("1") == 0) {
+        if (m_configHelper.isConfigValueEnabled(m_configHelper.getConfigOptionPrefixed(i.second))) {
             // Add the program to the solution
             projectAdd += project;
             projectAdd += solutionKey;
@@ -641,11 +811,11 @@ bool ProjectGenerator::outputSolution()
     // Add the lib keys
     for (const auto& i : addedKeys) {
         // loop over build configs
-        for (uint j = 0; j < buildConfigs.size(); j++) {
+        for (size_t j = 0; j < buildConfigs.size(); j++) {
             // loop over build archs
-            for (uint k = 0; k < sizeof(buildArchsSol) / sizeof(buildArchsSol[0]); k++) {
+            for (size_t k = 0; k < sizeof(buildArchsSol) / sizeof(buildArchsSol[0]); k++) {
                 // loop over build types
-                for (uint l = 0; l < sizeof(buildTypes) / sizeof(buildTypes[0]); l++) {
+                for (size_t l = 0; l < sizeof(buildTypes) / sizeof(buildTypes[0]); l++) {
                     auto config = !i.second ? buildConfigsNoWinRT[j] : buildConfigsWinRT[j];
                     // Don't build if project config doesn't match solution config
                     if (l == 0 || buildConfigs[j] == config) {
@@ -668,11 +838,11 @@ bool ProjectGenerator::outputSolution()
     // Add the program keys
     for (const auto& i : addedPrograms) {
         // Loop over build configs
-        for (uint j = 0; j < buildConfigs.size(); j++) {
+        for (size_t j = 0; j < buildConfigs.size(); j++) {
             // Loop over build archs
-            for (uint k = 0; k < sizeof(buildArchsSol) / sizeof(buildArchsSol[0]); k++) {
+            for (size_t k = 0; k < sizeof(buildArchsSol) / sizeof(buildArchsSol[0]); k++) {
                 // Loop over build types
-                for (uint m = 0; m < sizeof(buildTypes) / sizeof(buildTypes[0]); m++) {
+                for (size_t m = 0; m < sizeof(buildTypes) / sizeof(buildTypes[0]); m++) {
                     if ((m == 1) && (j != 4)) {
                         // We don't build programs by default except for Release config
                         continue;
@@ -697,7 +867,7 @@ bool ProjectGenerator::outputSolution()
     // Add any programs to the nested projects
     if (addedPrograms.size() > 0) {
         string nestedStart = "GlobalSection(NestedProjects) = preSolution";
-        uint pos2 = solutionFile.find(nestedStart) + nestedStart.length();
+        size_t pos2 = solutionFile.find(nestedStart) + nestedStart.length();
         string nest = "\r\n		{";
         string nest2 = "} = {";
         string nestEnd = "}";
@@ -715,7 +885,7 @@ bool ProjectGenerator::outputSolution()
 
     // Write output solution
     string projectName = m_configHelper.m_projectName;
-    transform(projectName.begin(), projectName.end(), projectName.begin(), tolower);
+    transform(projectName.begin(), projectName.end(), projectName.begin(), ::tolower);
     const string outSolutionFile = m_configHelper.m_solutionDirectory + projectName + ".sln";
     if (!writeToFile(outSolutionFile, solutionFile, true)) {
         return false;
@@ -730,7 +900,7 @@ bool ProjectGenerator::outputSolution()
 
     // Change all occurrences of template_in with solution name
     const string searchTag = "template_in";
-    uint findPos = batFile.find(searchTag);
+    size_t findPos = batFile.find(searchTag);
     while (findPos != string::npos) {
         // Replace
         batFile.replace(findPos, searchTag.length(), projectName);
@@ -751,7 +921,7 @@ void ProjectGenerator::outputTemplateTags(string& projectTemplate, const bool wi
 {
     // Change all occurrences of template_in with project name
     const string searchTag = "template_in";
-    uint findPos = projectTemplate.find(searchTag);
+    size_t findPos = projectTemplate.find(searchTag);
     while (findPos != string::npos) {
         // Replace
         projectTemplate.replace(findPos, searchTag.length(), m_projectName);
@@ -824,7 +994,7 @@ void ProjectGenerator::outputPropsTags(string& projectTemplate) const
         outDir = "$(ProjectDir)" + outDir; // Make any relative paths based on project dir
     }
     const string outSearchTag = R"($(ProjectDir)..\..\..\msvc\)";
-    uint findPos = projectTemplate.find(outSearchTag);
+    size_t findPos = projectTemplate.find(outSearchTag);
     while (findPos != string::npos) {
         // Replace
         projectTemplate.replace(findPos, outSearchTag.length(), outDir);
@@ -833,8 +1003,8 @@ void ProjectGenerator::outputPropsTags(string& projectTemplate) const
     }
 }
 
-void ProjectGenerator::outputSourceFileType(StaticList& fileList, const string& type, const string& filterType,
-    string& projectTemplate, string& filterTemplate, StaticList& foundObjects, set<string>& foundFilters,
+void ProjectGenerator::outputSourceFileType(const UniqueList& fileList, const string& type, const string& filterType,
+    string& projectTemplate, string& filterTemplate, UniqueList& foundObjects, set<string>& foundFilters,
     bool checkExisting, bool staticOnly, bool sharedOnly, bool bit32Only, bool bit64Only) const
 {
     // Declare constant strings used in output files
@@ -861,6 +1031,8 @@ void ProjectGenerator::outputSourceFileType(StaticList& fileList, const string&
         string typeFilesFilt = itemGroup;
         string typeFilesTemp, typeFilesFiltTemp;
         vector<pair<string, string>> tempObjects;
+        string sourceDir;
+        m_configHelper.makeFileProjectRelative(m_configHelper.m_rootDirectory, sourceDir);
 
         for (const auto& i : fileList) {
             // Output objects
@@ -874,19 +1046,17 @@ void ProjectGenerator::outputSourceFileType(StaticList& fileList, const string&
             typeFilesFiltTemp += file;
 
             // Get object name without path or extension
-            uint pos = i.rfind('/') + 1;
+            size_t pos = i.rfind('/') + 1;
             string objectName = i.substr(pos);
-            uint pos2 = objectName.rfind('.');
+            size_t pos2 = objectName.rfind('.');
             objectName.resize(pos2);
 
             // Add the filters Filter
-            string sourceDir;
-            m_configHelper.makeFileProjectRelative(m_configHelper.m_rootDirectory, sourceDir);
             pos = i.rfind(sourceDir);
             pos = (pos == string::npos) ? 0 : pos + sourceDir.length();
             typeFilesFiltTemp += includeClose;
             typeFilesFiltTemp += filterSource;
-            uint folderLength = i.rfind('/') - pos;
+            size_t folderLength = i.rfind('/') - pos;
             if (static_cast<int>(folderLength) != -1) {
                 string folderName = file.substr(pos, folderLength);
                 folderName = '\\' + folderName;
@@ -902,7 +1072,7 @@ void ProjectGenerator::outputSourceFileType(StaticList& fileList, const string&
                 typeFilesTemp += includeClose;
                 closed = true;
                 const string* buildConfig = nullptr;
-                uint configs = 0;
+                size_t configs = 0;
                 if (staticOnly) {
                     buildConfig = buildConfigsShared;
                     configs = sizeof(buildConfigsShared) / sizeof(buildConfigsShared[0]);
@@ -910,7 +1080,7 @@ void ProjectGenerator::outputSourceFileType(StaticList& fileList, const string&
                     buildConfig = buildConfigsStatic;
                     configs = sizeof(buildConfigsStatic) / sizeof(buildConfigsStatic[0]);
                 }
-                for (uint j = 0; j < configs; j++) {
+                for (size_t j = 0; j < configs; j++) {
                     typeFilesTemp += excludeConfig;
                     typeFilesTemp += buildConfig[j];
                     typeFilesTemp += excludeConfigEnd;
@@ -929,7 +1099,7 @@ void ProjectGenerator::outputSourceFileType(StaticList& fileList, const string&
 
             // Several input source files have the same name so we need to explicitly specify an output object file
             // otherwise they will clash
-            if (checkExisting && (find(foundObjects.begin(), foundObjects.end(), objectName) != foundObjects.end())) {
+            if (checkExisting && foundObjects.contains(objectName)) {
                 objectName = i.substr(pos);
                 replace(objectName.begin(), objectName.end(), '/', '_');
                 // Replace the extension with obj
@@ -972,9 +1142,9 @@ void ProjectGenerator::outputSourceFileType(StaticList& fileList, const string&
         // After </ItemGroup> add the item groups for each of the include types
         string endTag =
             "</ItemGroup>"; // Uses independent string to sItemGroupEnd to avoid line ending errors due to \r\n
-        uint findPos = projectTemplate.rfind(endTag);
+        size_t findPos = projectTemplate.rfind(endTag);
         findPos += endTag.length();
-        uint findPosFilt = filterTemplate.rfind(endTag);
+        size_t findPosFilt = filterTemplate.rfind(endTag);
         findPosFilt += endTag.length();
 
         // Insert into output file
@@ -986,15 +1156,13 @@ void ProjectGenerator::outputSourceFileType(StaticList& fileList, const string&
 void ProjectGenerator::outputSourceFiles(string& projectTemplate, string& filterTemplate)
 {
     set<string> foundFilters;
-    StaticList foundObjects;
+    UniqueList foundObjects;
 
     // Check if there is a resource file
     string resourceFile;
     if (findSourceFile(m_projectName.substr(3) + "res", ".rc", resourceFile)) {
         m_configHelper.makeFileProjectRelative(resourceFile, resourceFile);
-        if (find(m_includesRC.begin(), m_includesRC.end(), resourceFile) == m_includesRC.end()) {
-            m_includesRC.push_back(resourceFile);
-        }
+        m_includesRC.push_back(resourceFile);
     }
 
     // Output RC files
@@ -1012,10 +1180,10 @@ void ProjectGenerator::outputSourceFiles(string& projectTemplate, string& filter
     }
     if (!m_includesConditionalASM.empty()) {
         if (m_configHelper.isASMEnabled()) {
-            StaticList fileList;
+            UniqueList fileList;
             for (auto& i : m_includesConditionalASM) {
                 fileList.clear();
-                fileList.emplace_back(i.first);
+                fileList.push_back(i.first);
                 outputSourceFileType(fileList, (m_configHelper.m_useNASM) ? "NASM" : "YASM", "Source", projectTemplate,
                     filterTemplate, foundObjects, foundFilters, false, i.second.isStatic, i.second.isShared,
                     i.second.is32, i.second.is64);
@@ -1028,10 +1196,10 @@ void ProjectGenerator::outputSourceFiles(string& projectTemplate, string& filter
     // Output C files
     outputSourceFileType(
         m_includesC, "ClCompile", "Source", projectTemplate, filterTemplate, foundObjects, foundFilters, true);
-    StaticList fileList;
+    UniqueList fileList;
     for (auto& i : m_includesConditionalC) {
         fileList.clear();
-        fileList.emplace_back(i.first);
+        fileList.push_back(i.first);
         outputSourceFileType(fileList, "ClCompile", "Source", projectTemplate, filterTemplate, foundObjects,
             foundFilters, true, i.second.isStatic, i.second.isShared, i.second.is32, i.second.is64);
     }
@@ -1041,7 +1209,7 @@ void ProjectGenerator::outputSourceFiles(string& projectTemplate, string& filter
         m_includesCPP, "ClCompile", "Source", projectTemplate, filterTemplate, foundObjects, foundFilters, true);
     for (auto& i : m_includesConditionalCPP) {
         fileList.clear();
-        fileList.emplace_back(i.first);
+        fileList.push_back(i.first);
         outputSourceFileType(fileList, "ClCompile", "Source", projectTemplate, filterTemplate, foundObjects,
             foundFilters, true, i.second.isStatic, i.second.isShared, i.second.is32, i.second.is64);
     }
@@ -1104,10 +1272,10 @@ void ProjectGenerator::outputSourceFiles(string& projectTemplate, string& filter
         "60d9e8db-aa53-43bc-852b-44f83e68a787", "63a40443-4e21-4bd2-9e25-595f5d5857c9"};
 
     // get start position in file
-    uint findPosFilt = filterTemplate.find("</ItemGroup>");
+    size_t findPosFilt = filterTemplate.find("</ItemGroup>");
     findPosFilt = filterTemplate.find_last_not_of(g_whiteSpace, findPosFilt - 1) +
         1; // handle potential differences in line endings
-    uint currentKey = 0;
+    size_t currentKey = 0;
     string addFilters;
     for (const auto& i : foundFilters) {
         addFilters += filterAdd;
@@ -1135,11 +1303,11 @@ bool ProjectGenerator::findExportsList(StaticList& exportPrefixes) const
 
     // Search for start of global tag
     const string global = "global:";
-    uint findPos = exportsFile.find(global);
+    size_t findPos = exportsFile.find(global);
     if (findPos != string::npos) {
         // Remove everything outside the global section
         findPos += global.length();
-        uint findPos2 = exportsFile.find("local:", findPos);
+        size_t findPos2 = exportsFile.find("local:", findPos);
         exportsFile = exportsFile.substr(findPos, findPos2 - findPos);
 
         // Remove any comments
@@ -1152,7 +1320,7 @@ bool ProjectGenerator::findExportsList(StaticList& exportPrefixes) const
         }
 
         // Clean any remaining white space out
-        exportsFile.erase(remove_if(exportsFile.begin(), exportsFile.end(), isspace), exportsFile.end());
+        exportsFile.erase(remove_if(exportsFile.begin(), exportsFile.end(), ::isspace), exportsFile.end());
 
         // Get any export strings
         findPos = 0;
@@ -1180,17 +1348,17 @@ bool ProjectGenerator::outputProjectExports(const StaticList& includeDirs) const
     // Split each source file into different directories to avoid name clashes
     map<string, StaticList> directoryObjects;
     for (const auto& i : m_includesC) {
-        uint pos = i.rfind('/');
+        size_t pos = i.rfind('/');
         string folderName = i.substr(0, pos);
         directoryObjects[folderName].push_back(i);
     }
     for (const auto& i : m_includesCPP) {
-        uint pos = i.rfind('/');
+        size_t pos = i.rfind('/');
         string folderName = i.substr(0, pos);
         directoryObjects[folderName].push_back(i);
     }
 
-    if (!runCompiler(includeDirs, directoryObjects, 0)) {
+    if (!runCompiler(includeDirs, directoryObjects)) {
         return false;
     }
 
@@ -1225,7 +1393,7 @@ bool ProjectGenerator::outputProjectExports(const StaticList& includeDirs) const
             // ID is a 2 or 3 character sequence used to uniquely identify the object
 
             // Check if it is a wild card search
-            uint findPos = j.find('*');
+            size_t findPos = j.find('*');
             if (findPos != string::npos) {
                 // Strip the wild card (Note: assumes wild card is at the end!)
                 string search = j.substr(0, findPos);
@@ -1234,19 +1402,19 @@ bool ProjectGenerator::outputProjectExports(const StaticList& includeDirs) const
                 findPos = fileSBR.find(search);
                 while (findPos != string::npos) {
                     // Find end of name signalled by NULL character
-                    uint findPos2 = fileSBR.find(static_cast<char>(0x00), findPos + 1);
+                    size_t findPos2 = fileSBR.find(static_cast<char>(0x00), findPos + 1);
                     if (findPos2 == string::npos) {
                         findPos = findPos2;
                         break;
                     }
 
                     // Check if this is a define
-                    uint findPos3 = fileSBR.rfind(static_cast<char>(0x00), findPos - 3);
+                    size_t findPos3 = fileSBR.rfind(static_cast<char>(0x00), findPos - 3);
                     while (fileSBR.at(findPos3 - 1) == static_cast<char>(0x00)) {
                         // Skip if there was a NULL in ID
                         --findPos3;
                     }
-                    uint findPosDiff = findPos - findPos3;
+                    size_t findPosDiff = findPos - findPos3;
                     if ((fileSBR.at(findPos3 - 1) == '@') &&
                         (((findPosDiff == 3) && (fileSBR.at(findPos3 - 3) == static_cast<char>(0x03))) ||
                             ((findPosDiff == 4) && (fileSBR.at(findPos3 - 3) == 'C')))) {
@@ -1272,7 +1440,7 @@ bool ProjectGenerator::outputProjectExports(const StaticList& includeDirs) const
             } else {
                 findPos = fileSBR.find(j);
                 // Make sure the match is an exact one
-                uint findPos3;
+                size_t findPos3;
                 while ((findPos != string::npos)) {
                     if (fileSBR.at(findPos + j.length()) == static_cast<char>(0x00)) {
                         findPos3 = fileSBR.rfind(static_cast<char>(0x00), findPos - 3);
@@ -1280,7 +1448,7 @@ bool ProjectGenerator::outputProjectExports(const StaticList& includeDirs) const
                             // Skip if there was a NULL in ID
                             --findPos3;
                         }
-                        uint findPosDiff = findPos - findPos3;
+                        size_t findPosDiff = findPos - findPos3;
                         if ((fileSBR.at(findPos3 - 1) == '@') &&
                             (((findPosDiff == 3) && (fileSBR.at(findPos3 - 3) == static_cast<char>(0x03))) ||
                                 ((findPosDiff == 4) && (fileSBR.at(findPos3 - 3) == 'C')))) {
@@ -1318,7 +1486,7 @@ bool ProjectGenerator::outputProjectExports(const StaticList& includeDirs) const
         // Search through file for module exports
         for (const auto& j : exportStrings) {
             // Check if it is a wild card search
-            uint findPos = j.find('*');
+            size_t findPos = j.find('*');
             const string invalidChars = ",.(){}[]`'\"+-*/!@#$%^&*<>|;\\= \r\n\t";
             if (findPos != string::npos) {
                 // Strip the wild card (Note: assumes wild card is at the end!)
@@ -1327,7 +1495,7 @@ bool ProjectGenerator::outputProjectExports(const StaticList& includeDirs) const
                 findPos = fileASM.find(search);
                 while ((findPos != string::npos) && (findPos > 0)) {
                     // Find end of name signaled by first non valid character
-                    uint findPos2 = fileASM.find_first_of(invalidChars, findPos + 1);
+                    size_t findPos2 = fileASM.find_first_of(invalidChars, findPos + 1);
                     // Check this is valid function definition
                     if ((fileASM.at(findPos2) == '(') && (invalidChars.find(fileASM.at(findPos - 1)) == string::npos)) {
                         string foundName = fileASM.substr(findPos, findPos2 - findPos);
@@ -1388,7 +1556,7 @@ mkdir \"$(OutBaseDir)\"\\include\\";
     const string copyEnd = " \"$(OutBaseDir)\"\\include\\";
     const string license = "\r\nmkdir \"$(OutBaseDir)\"\\licenses";
     string licenseName = m_configHelper.m_projectName;
-    transform(licenseName.begin(), licenseName.end(), licenseName.begin(), tolower);
+    transform(licenseName.begin(), licenseName.end(), licenseName.begin(), ::tolower);
     const string licenseEnd = " \"$(OutBaseDir)\"\\licenses\\" + licenseName + ".txt";
     const string prebuild = "\r\n    <PreBuildEvent>\r\n\
       <Command>if exist template_rootdirconfig.h (\r\n\
@@ -1437,7 +1605,7 @@ cd $(ProjectDir)\r\n\
     if (m_includesH.size() > 0) {
         additional += include;
         additional += m_projectName;
-        for (auto& i : m_includesH) {
+        for (const auto& i : m_includesH) {
             additional += copy;
             string header = i;
             replace(header.begin(), header.end(), '/', '\\');
@@ -1460,7 +1628,7 @@ cd $(ProjectDir)\r\n\
     additional += prebuildClose;
 
     for (const auto& i : libLink) {
-        uint findPos = projectTemplate.find(i);
+        size_t findPos = projectTemplate.find(i);
         while (findPos != string::npos) {
             findPos += i.length();
             // Add to output
@@ -1477,8 +1645,8 @@ void ProjectGenerator::outputIncludeDirs(const StaticList& includeDirs, string&
     if (!includeDirs.empty()) {
         // Check if already an AdditionalIncludeDirectories tag
         string search = "<ClCompile>";
-        uint findPos = projectTemplate.find(search);
-        const uint findPos2 = projectTemplate.find("</ClCompile>", findPos + search.length());
+        size_t findPos = projectTemplate.find(search);
+        const size_t findPos2 = projectTemplate.find("</ClCompile>", findPos + search.length());
         bool existing = false;
         if (projectTemplate.find("<AdditionalIncludeDirectories>", findPos + search.length()) < findPos2) {
             search = "<AdditionalIncludeDirectories>";
@@ -1525,9 +1693,9 @@ void ProjectGenerator::outputLibDirs(const StaticList& lib32Dirs, const StaticLi
             i += "%(AdditionalLibraryDirectories)</AdditionalLibraryDirectories>";
         }
         const string search[] = {"<Link>", "<Lib>"};
-        for (uint i = 0; i < 2; ++i) {
-            uint arch32Or64 = 0; // start with 32 (assumes projects are ordered 32 then 64 recursive)
-            uint findPos = projectTemplate.find(search[i]);
+        for (size_t i = 0; i < 2; ++i) {
+            size_t arch32Or64 = 0; // start with 32 (assumes projects are ordered 32 then 64 recursive)
+            size_t findPos = projectTemplate.find(search[i]);
             while (findPos != string::npos) {
                 // Add to output
                 findPos += search[i].length();
@@ -1559,9 +1727,9 @@ void ProjectGenerator::outputDefines(
         // programs:
         // Debug x2, DebugDLL x2, Release x2, ReleaseDLL x2
         const string addDefines = "<PreprocessorDefinitions>";
-        uint findPos = projectTemplate.find(addDefines);
-        uint count = 0;
-        const uint check = (!program) ? 4 : 2;
+        size_t findPos = projectTemplate.find(addDefines);
+        size_t count = 0;
+        const size_t check = (!program) ? 4 : 2;
         while (findPos != string::npos) {
             // Add to output
             findPos += addDefines.length();
@@ -1611,7 +1779,7 @@ void ProjectGenerator::outputASMTools(string& projectTemplate) const
 
         // Add NASM defines
         const string endPreBuild = "</PreBuildEvent>";
-        uint findPos = projectTemplate.find(endPreBuild);
+        size_t findPos = projectTemplate.find(endPreBuild);
         while (findPos != string::npos) {
             findPos += endPreBuild.length();
             // Add to output
@@ -1641,17 +1809,16 @@ void ProjectGenerator::outputCUDATools(string& projectTemplate) const
 bool ProjectGenerator::outputDependencyLibs(string& projectTemplate, const bool winrt, const bool program)
 {
     // Check current libs list for valid lib names
-    for (auto& i : m_libs) {
+    StaticList projectLibs;
+    for (const auto& i : m_libs) {
         // prepend lib if needed
-        if (i.find("lib") != 0) {
-            i = "lib" + i;
-        }
+        projectLibs.push_back((i.find("lib") != 0) ? "lib" + i : i);
     }
 
     // Add additional dependencies based on current config to Libs list
-    buildInterDependencies(m_libs);
-    m_projectLibs[m_projectName] = m_libs; // Backup up current libs for solution
-    StaticList addLibs, libs = m_libs;
+    buildInterDependencies(projectLibs);
+    m_projectLibs[m_projectName] = projectLibs; // Backup up current libs for solution
+    StaticList addLibs, libs = projectLibs;
     buildDependencies(libs, addLibs, winrt);
 
     if ((libs.size() > 0) || (addLibs.size() > 0)) {
@@ -1687,11 +1854,11 @@ bool ProjectGenerator::outputDependencyLibs(string& projectTemplate, const bool
         }
         // Add to Additional Dependencies
         const string libLink2[2] = {"<Link>", "<Lib>"};
-        for (uint linkLib = 0; linkLib < (!program ? 2U : 1U); linkLib++) {
+        for (size_t linkLib = 0; linkLib < (!program ? 2U : 1U); linkLib++) {
             // loop over each debug/release sequence
-            uint findPos = 0;
-            for (uint debugRelease = 0; debugRelease < 2; debugRelease++) {
-                const uint max = !program ? (((debugRelease == 1) && (linkLib == 0)) ? 2 : 1) : 2;
+            size_t findPos = 0;
+            for (size_t debugRelease = 0; debugRelease < 2; debugRelease++) {
+                const size_t max = !program ? (((debugRelease == 1) && (linkLib == 0)) ? 2 : 1) : 2;
                 // Libs have:
                 // link:
                 //  DebugDLL|Win32, DebugDLL|x64,
@@ -1706,9 +1873,9 @@ bool ProjectGenerator::outputDependencyLibs(string& projectTemplate, const bool
                 //  DebugDLL|Win32, DebugDLL|x64,
                 //  Release|Win32, Release|x64,
                 //  ReleaseDLL|Win32, ReleaseDLL|x64,
-                for (uint conf = 0; conf < max; conf++) {
+                for (size_t conf = 0; conf < max; conf++) {
                     // Loop over x32/x64
-                    for (uint arch = 0; arch < 2; arch++) {
+                    for (size_t arch = 0; arch < 2; arch++) {
                         findPos = projectTemplate.find(libLink2[linkLib], findPos);
                         if (findPos == string::npos) {
                             outputError("Failed finding " + libLink2[linkLib] + " in template.");
@@ -1716,7 +1883,7 @@ bool ProjectGenerator::outputDependencyLibs(string& projectTemplate, const bool
                         }
                         findPos += libLink2[linkLib].length();
                         // Add in ffmpeg inter-dependencies
-                        uint addIndex = debugRelease;
+                        size_t addIndex = debugRelease;
                         if ((linkLib == 0) && (!program || (conf % 2 != 0))) {
                             // Use DLL libs
                             addIndex += 2;
@@ -21,6 +21,7 @@
 #include "projectGenerator.h"
 
 #include <algorithm>
+#include <cctype>
 
 void ProjectGenerator::buildInterDependenciesHelper(
     const StaticList& configOptions, const StaticList& addDeps, StaticList& libs) const
@@ -102,10 +103,11 @@ void ProjectGenerator::buildDependencies(StaticList& libs, StaticList& addLibs,
                 // Convert to full config value
                 const auto name =
                     m_configHelper.getConfigOption(i)->m_prefix + m_configHelper.getConfigOption(i)->m_option;
-                if (m_configHelper.m_replaceList.find(name) != m_configHelper.m_replaceList.end()) {
+                const auto replace = m_configHelper.m_replaceList.find(name);
+                if (replace != m_configHelper.m_replaceList.end()) {
                     // Skip this option
-                    if (m_configHelper.m_replaceList[name].find("!HAVE_WINRT") != string::npos ||
-                        m_configHelper.m_replaceList[name].find("!HAVE_UWP") != string::npos) {
+                    if (replace->second.find("!HAVE_WINRT") != string::npos ||
+                        replace->second.find("!HAVE_UWP") != string::npos) {
                         continue;
                     }
                 }
@@ -261,14 +263,14 @@ void ProjectGenerator::buildDependencyValues(StaticList& includeDirs, StaticList
     string dep;
     if (findFile(atomicCompatFile, dep)) {
         m_configHelper.makeFileProjectRelative(atomicCompatFile, atomicCompatFile);
-        uint pos = atomicCompatFile.rfind('/'); // Get path only
+        size_t pos = atomicCompatFile.rfind('/'); // Get path only
         atomicCompatFile = atomicCompatFile.substr(0, ++pos);
         includeDirs.push_back("$(ProjectDir)/" + atomicCompatFile);
     }
     string bitCompatFile = m_configHelper.m_rootDirectory + "compat/stdbit/stdbit.h";
     if (findFile(bitCompatFile, dep)) {
         m_configHelper.makeFileProjectRelative(bitCompatFile, bitCompatFile);
-        uint pos = bitCompatFile.rfind('/'); // Get path only
+        size_t pos = bitCompatFile.rfind('/'); // Get path only
         bitCompatFile = bitCompatFile.substr(0, ++pos);
         includeDirs.push_back("$(ProjectDir)/" + bitCompatFile);
     }
@@ -615,11 +617,11 @@ void ProjectGenerator::buildProjectDCEs(map<string, DCEParams>&, map<string, DCE
         StaticList ret;
         StaticList retExterns;
         string list = i.m_list;
-        transform(list.begin(), list.end(), list.begin(), toupper);
+        transform(list.begin(), list.end(), list.begin(), ::toupper);
         m_configHelper.passFindThings(i.m_list, i.m_search, i.m_file, ret, &retExterns);
         for (auto itRet = ret.begin(), itRet2 = retExterns.begin(); itRet < ret.end(); ++itRet, ++itRet2) {
             string sType = *itRet2;
-            transform(itRet->begin(), itRet->end(), itRet->begin(), toupper);
+            transform(itRet->begin(), itRet->end(), itRet->begin(), ::toupper);
             variablesDCE[sType] = {"CONFIG_" + *itRet, i.m_header};
         }
     }
@@ -21,47 +21,80 @@
 #include "projectGenerator.h"
 
 #include <algorithm>
+#include <cmath>
+#include <mutex>
 #include <utility>
 
+// The compiler is run from the current directory using fixed script/log names so only 1 run can occur at a time
+static mutex g_compilerMutex;
+
 bool ProjectGenerator::runCompiler(
-    const vector<string>& includeDirs, map<string, vector<string>>& directoryObjects, const int runType) const
+    const vector<string>& includeDirs, map<string, vector<string>>& directoryObjects) const
 {
 #ifdef _MSC_VER
+    lock_guard<mutex> lock(g_compilerMutex);
     // If compiled by msvc then only msvc builds are supported
-    return runMSVC(includeDirs, directoryObjects, runType);
+    return runMSVC(includeDirs, directoryObjects);
 #else
-    // Otherwise only gcc and mingw are supported
-    return runGCC(includeDirs, directoryObjects, runType);
+    (void)includeDirs;
+    (void)directoryObjects;
+    // Browse information can only be generated using msvc
+    outputError("Generation of definitions is not supported using gcc.");
+    return false;
 #endif
 }
 
-bool ProjectGenerator::runMSVC(
-    const vector<string>& includeDirs, map<string, vector<string>>& directoryObjects, int runType) const
+void ProjectGenerator::buildCompilerIncludeDirs(const StaticList& includeDirs, StaticList& retIncludeDirs) const
 {
-    // Create a test file to read in definitions
     string outDir = m_configHelper.m_outDirectory;
     m_configHelper.makeFileGeneratorRelative(outDir, outDir);
     string projectDir = m_configHelper.m_solutionDirectory;
     m_configHelper.makeFileGeneratorRelative(projectDir, projectDir);
-    vector<string> includeDirs2 = includeDirs;
-    includeDirs2.insert(includeDirs2.begin(), outDir + "include/");
-    includeDirs2.insert(includeDirs2.begin(), m_configHelper.m_solutionDirectory);
-    includeDirs2.insert(includeDirs2.begin(), m_configHelper.m_rootDirectory);
+    retIncludeDirs = includeDirs;
+    retIncludeDirs.insert(retIncludeDirs.begin(), outDir + "include/");
+    retIncludeDirs.insert(retIncludeDirs.begin(), m_configHelper.m_solutionDirectory);
+    retIncludeDirs.insert(retIncludeDirs.begin(), m_configHelper.m_rootDirectory);
+    for (auto& i : retIncludeDirs) {
+        findAndReplace(i, "$(OutDir)", outDir);
+        findAndReplace(i, "$(OutBaseDir)", outDir);
+        findAndReplace(i, "$(ProjectDir)", projectDir);
+    }
+}
+
+void ProjectGenerator::buildPreProcessor(const StaticList& includeDirs, PreProcessor& preProcessor) const
+{
+    StaticList includeDirs2;
+    buildCompilerIncludeDirs(includeDirs, includeDirs2);
+    for (const auto& i : includeDirs2) {
+        // Directories using environment variables are only available from within the compiler environment
+        if (i.find("$(") == string::npos) {
+            preProcessor.addIncludeDirectory(i);
+        }
+    }
+
+    // Use the same defines as the x64 debug build performed by runMSVC. When built by msvc the generator is assumed to
+    // be built with the same toolset as is used by runMSVC, otherwise the oldest supported version (VS2022) is used.
+#ifdef _MSC_VER
+    const string msvcVersion = to_string(_MSC_VER);
+#else
+    const string msvcVersion = "1930";
+#endif
+    const string defines[][2] = {{"_WIN32", "1"}, {"_WIN64", "1"}, {"_M_X64", "100"}, {"_M_AMD64", "100"},
+        {"_MSC_VER", msvcVersion}, {"_DEBUG", "1"}, {"WIN32", "1"}, {"_WINDOWS", "1"}, {"HAVE_AV_CONFIG_H", "1"},
+        {"_USE_MATH_DEFINES", "1"}, {"_UCRT_NOISY_NAN", "1"}};
+    for (const auto& i : defines) {
+        preProcessor.addDefine(i[0], i[1]);
+    }
+}
+
+bool ProjectGenerator::runMSVC(const vector<string>& includeDirs, map<string, vector<string>>& directoryObjects) const
+{
+    // Create a test file to read in definitions
+    vector<string> includeDirs2;
+    buildCompilerIncludeDirs(includeDirs, includeDirs2);
     string extraCl;
     for (auto& i : includeDirs2) {
-        uint findPos2 = i.find("$(OutDir)");
-        if (findPos2 != string::npos) {
-            i.replace(findPos2, 9, outDir);
-        }
-        findPos2 = i.find("$(OutBaseDir)");
-        if (findPos2 != string::npos) {
-            i.replace(findPos2, 13, outDir);
-        }
-        findPos2 = i.find("$(ProjectDir)");
-        if (findPos2 != string::npos) {
-            i.replace(findPos2, 13, projectDir);
-        }
-        findPos2 = i.find("$(");
+        size_t findPos2 = i.find("$(");
         if (findPos2 != string::npos) {
             i.replace(findPos2, 2, "%");
         }
@@ -85,7 +118,7 @@ bool ProjectGenerator::runMSVC(
         findPos2 = i.find("/../");
         while (findPos2 != string::npos) {
             // Get the previous '/'
-            uint findPos3 = i.rfind('/', findPos2 - 1);
+            size_t findPos3 = i.rfind('/', findPos2 - 1);
             findPos3 = (findPos3 != string::npos) ? findPos3 : 0;
             if (i.find_first_not_of('.', findPos3 + 1) < findPos2) {
                 i.erase(findPos3, findPos2 - findPos3 + 3);
@@ -163,34 +196,28 @@ popd\n";
     launchBat += "mkdir \"" + m_tempDirectory + "\" > nul 2>&1\n";
     launchBat += "mkdir \"" + tempFolder + "\" > nul 2>&1\n";
     for (auto& j : directoryObjects) {
-        const uint rowSize = 32;
-        uint numClCalls = static_cast<uint>(ceilf(static_cast<float>(j.second.size()) / static_cast<float>(rowSize)));
-        uint totalPos = 0;
+        const size_t rowSize = 32;
+        size_t numClCalls =
+            static_cast<size_t>(ceilf(static_cast<float>(j.second.size()) / static_cast<float>(rowSize)));
+        size_t totalPos = 0;
         string dirName = tempFolder + "/" + j.first;
         if (j.first.length() > 0) {
             // Need to make output directory so compile doesn't fail outputting
             launchBat += "mkdir \"" + dirName + "\" > nul 2>&1\n";
         }
-        string runCommands;
-        // Check type of compiler call
-        if (runType == 0) {
-            runCommands = "/FR\"" + dirName + "/\"" + " /Fo\"" + dirName + "/\"";
-        } else if (runType == 1) {
-            runCommands = "/EP /P";
-        }
+        // Output browse information for each file
+        const string runCommands = "/FR\"" + dirName + "/\"" + " /Fo\"" + dirName + "/\"";
 
         // Split calls into groups of `rowSize` to prevent batch file length limit
-        for (uint i = 0; i < numClCalls; i++) {
-            uint uiStartPos = totalPos;
+        for (size_t i = 0; i < numClCalls; i++) {
+            size_t uiStartPos = totalPos;
             // Create list of files for this batch
             vector<string> compileFiles;
             vector<string> extraIncludeDirs;
             compileFiles.reserve(rowSize);
             string extraExtraCl;
             for (; totalPos < min(uiStartPos + rowSize, j.second.size()); totalPos++) {
-                if (runType == 0) {
-                    m_configHelper.makeFileGeneratorRelative(j.second[totalPos], j.second[totalPos]);
-                }
+                m_configHelper.makeFileGeneratorRelative(j.second[totalPos], j.second[totalPos]);
                 compileFiles.push_back(j.second[totalPos]);
                 // Add any additional include dirs based on file paths (this is required for 'wrap' files)
                 const auto dirPos = j.second[totalPos].rfind('/');
@@ -216,18 +243,10 @@ popd\n";
             }
             launchBat += " > ffvs_log.txt 2>&1\nif %errorlevel% neq 0 goto exitFail\n";
         }
-        if (runType == 1) {
-            launchBat += "move *.i " + dirName + "/ >nul 2>&1\n";
-        }
-    }
-    if (runType == 0) {
-        launchBat += "del /F /S /Q *.obj >nul 2>&1\n";
     }
+    launchBat += "del /F /S /Q *.obj >nul 2>&1\n";
     launchBat += "del ffvs_log.txt >nul 2>&1\n";
     launchBat += "exit /b 0\n:exitFail\n";
-    if (runType == 1) {
-        launchBat += "del /F /S /Q *.i >nul 2>&1\n";
-    }
     launchBat += "rmdir /S /Q " + m_tempDirectory + "\nexit /b 1";
     if (!writeToFile("ffvs_compile.bat", launchBat)) {
         return false;
@@ -241,10 +260,10 @@ popd\n";
             bool error = false;
             bool missingVs = false;
             bool missingDeps = false;
-            uint findPos = testOutput.find(" error ");
+            size_t findPos = testOutput.find(" error ");
             while (findPos != string::npos) {
                 // find end of line
-                uint findPos2 = testOutput.find_first_of("\n(", findPos + 1);
+                size_t findPos2 = testOutput.find_first_of("\n(", findPos + 1);
                 string temp = testOutput.substr(findPos + 1, findPos2 - findPos - 1);
                 outputError(temp, false);
                 findPos = testOutput.find(" error ", findPos2 + 1);
@@ -259,7 +278,7 @@ popd\n";
             }
             findPos = testOutput.find("internal or external command");
             if (findPos != string::npos) {
-                uint findPos2 = testOutput.find('\n', findPos + 1);
+                size_t findPos2 = testOutput.find('\n', findPos + 1);
                 findPos = testOutput.rfind('\n', findPos);
                 findPos = (findPos == string::npos) ? 0 : findPos;
                 outputError(testOutput.substr(findPos, findPos2 - findPos), false);
@@ -298,135 +317,3 @@ popd\n";
     deleteFile("ffvs_compile.bat");
     return true;
 }
-
-bool ProjectGenerator::runGCC(
-    const vector<string>& includeDirs, map<string, vector<string>>& directoryObjects, int runType) const
-{
-    // Create a test file to read in definitions
-    string outDir = m_configHelper.m_outDirectory;
-    m_configHelper.makeFileGeneratorRelative(outDir, outDir);
-    string projectDir = m_configHelper.m_solutionDirectory;
-    m_configHelper.makeFileGeneratorRelative(projectDir, projectDir);
-    vector<string> includeDirs2 = includeDirs;
-    includeDirs2.insert(includeDirs2.begin(), outDir + "include/");
-    includeDirs2.insert(includeDirs2.begin(), m_configHelper.m_solutionDirectory);
-    includeDirs2.insert(includeDirs2.begin(), m_configHelper.m_rootDirectory);
-    string extraCl;
-    for (auto& i : includeDirs2) {
-        uint findPos2 = i.find("$(OutDir)");
-        if (findPos2 != string::npos) {
-            i.replace(findPos2, 9, outDir);
-        }
-        findPos2 = i.find("$(OutBaseDir)");
-        if (findPos2 != string::npos) {
-            i.replace(findPos2, 13, outDir);
-        }
-        findPos2 = i.find("$(ProjectDir)");
-        if (findPos2 != string::npos) {
-            i.replace(findPos2, 13, projectDir);
-        }
-        findPos2 = i.find("$(");
-        if (findPos2 != string::npos) {
-            i.replace(findPos2, 2, "%");
-        }
-        findPos2 = i.find(')');
-        if (findPos2 != string::npos) {
-            i.replace(findPos2, 1, "%");
-        }
-        if (i.length() == 0) {
-            i = "./";
-        } else if ((i.find(':') == string::npos) && (i.find_first_of("./%") != 0)) {
-            i.insert(0, "./");
-        }
-        // Clean duplicate '//'
-        findPos2 = i.find("//");
-        while (findPos2 != string::npos) {
-            i.erase(findPos2, 1);
-            // get next
-            findPos2 = i.find("//");
-        }
-        // Remove ../ not at start of path
-        findPos2 = i.find("/../");
-        while (findPos2 != string::npos) {
-            // Get the previous '/'
-            uint findPos3 = i.rfind('/', findPos2 - 1);
-            findPos3 = (findPos3 != string::npos) ? findPos3 : 0;
-            if (i.find_first_not_of('.', findPos3 + 1) < findPos2) {
-                i.erase(findPos3, findPos2 - findPos3 + 3);
-                // get next
-                findPos2 = i.find("/../", findPos3);
-            } else {
-                // get next
-                findPos2 = i.find("/../", findPos2 + 1);
-            }
-        }
-        extraCl += " /I\"" + i + '\"';
-    }
-    string tempFolder = m_tempDirectory + m_projectName;
-
-    // Use GNU compiler to pass the test file and retrieve declarations
-    string launchBat = "#!/bin/bash\n";
-    launchBat += "exitFail() {\n";
-    if (runType == 1) {
-        launchBat += "rm -rf *.i > /dev/null 2>&1\n";
-    }
-    launchBat += "rm -rf " + m_tempDirectory + " > /dev/null 2>&1\nexit 1\n}\n";
-    launchBat += "mkdir \"" + m_tempDirectory + "\" > /dev/null 2>&1\n";
-    launchBat += "mkdir \"" + tempFolder + "\" > /dev/null 2>&1\n";
-    for (auto& i : directoryObjects) {
-        string dirName = tempFolder + "/" + i.first;
-        if (i.first.length() > 0) {
-            // Need to make output directory so compile doesn't fail outputting
-            launchBat += "mkdir \"" + dirName + "\" > /dev/null 2>&1\n";
-        }
-        string runCommands;
-        // Check type of compiler call
-        if (runType == 0) {
-            outputError("Generation of definitions is not supported using gcc.");
-            return false;
-        }
-        if (runType == 1) {
-            runCommands = "-E -P";
-        }
-        // Check if gcc or mingw
-#ifdef _WIN32
-        extraCl += R"(-D"WIN32" -D"_WINDOWS")";
-#endif
-
-        // Split calls as gcc outputs a single file at a time
-        for (auto& j : i.second) {
-            launchBat += "gcc ";
-            launchBat += extraCl + " -D_DEBUG " + runCommands + " -c -w";
-            if (runType == 0) {
-                m_configHelper.makeFileGeneratorRelative(j, j);
-            }
-            launchBat += " \"" + j + "\"";
-            if (runType == 0) {
-                launchBat += " -o " + j + ".o";
-            } else if (runType == 1) {
-                launchBat += " -o " + j + ".i";
-            }
-            launchBat += " > ffvs_log.txt 2>&1\nif (( $? )); then\nexitFail\nfi\n";
-        }
-    }
-    if (runType == 0) {
-        launchBat += "rm -rf *.o > /dev/null 2>&1\n";
-    }
-    launchBat += "rm ffvs_log.txt > /dev/null 2>&1\n";
-    launchBat += "exit 0\n";
-    if (!writeToFile("ffvs_compile.sh", launchBat)) {
-        return false;
-    }
-    if (0 != system("ffvs_compile.sh")) {
-        outputError("Errors detected during compilation :-");
-        outputError("Unknown error detected. See ffvs_log.txt for further details.", false);
-        // Remove the compilation files
-        deleteFile("ffvs_compile.sh");
-        deleteFolder(m_tempDirectory);
-        return false;
-    }
-
-    // Remove the compilation objects
-    deleteFile("ffvs_compile.sh");
-    return true;
-}
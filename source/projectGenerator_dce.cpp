@@ -20,21 +20,202 @@
 #include "projectGenerator.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
 #include <iterator>
+#include <mutex>
 #include <sstream>
+#include <thread>
 #include <utility>
 
 // This can be used to force all detected DCE values to be output to file
 // whether they are enabled in current configuration or not
 #define FORCEALLDCE 0
+
+// Additional threads used to scan files are shared between all projects (and variants) being generated at once so
+// that the total number of scanning threads does not exceed the number of available cores
+static mutex s_scanWorkersMutex;
+static size_t s_scanWorkers = 0;
 static const string g_tagsDCE[] = {"ARCH_", "HAVE_", "CONFIG_", "EXTERNAL_", "INTERNAL_", "INLINE_"};
+static const size_t g_numTagsDCE = sizeof(g_tagsDCE) / sizeof(string);
+static const size_t g_numConditionsDCE = 4; // "if (", "if(", "if ((" and "if(("
+// Version of the DCE snapshot format and scanning. This must be incremented whenever a change to the generator changes
+// the DCE results found from the same input so that any existing snapshots are no longer used.
+static const size_t g_snapshotVersionDCE = 1;
+
+/**
+ * Gets the DCE tag found at a position within a file.
+ * @param file The file to check.
+ * @param pos  The position within the file.
+ * @return The index of the tag within g_tagsDCE, string::npos if there is no tag at the position.
+ */
+static size_t getDCETag(const string_view file, const size_t pos)
+{
+    if (pos >= file.length()) {
+        return string::npos;
+    }
+    for (size_t i = 0; i < g_numTagsDCE; ++i) {
+        if (file.substr(pos, g_tagsDCE[i].length()) == g_tagsDCE[i]) {
+            return i;
+        }
+    }
+    return string::npos;
+}
+
+/**
+ * Finds every DCE condition within a file in a single pass (i.e. "if (CONFIG_", "if((HAVE_" etc.).
+ * @param       file       The file to search.
+ * @param [out] conditions The position of each found condition. Positions are grouped by tag and then by type of
+ *                         condition (i.e. conditions[tag * g_numConditionsDCE + type]) and are in ascending order.
+ */
+static void findDCEConditions(const string_view file, vector<vector<size_t>>& conditions)
+{
+    conditions.assign(g_numTagsDCE * g_numConditionsDCE, vector<size_t>());
+    size_t findPos = file.find("if");
+    while (findPos != string::npos) {
+        size_t pos = findPos + 2;
+        size_t type = 1;
+        if ((pos < file.length()) && (file[pos] == ' ')) {
+            ++pos;
+            type = 0;
+        }
+        if ((pos < file.length()) && (file[pos] == '(')) {
+            ++pos;
+            if ((pos < file.length()) && (file[pos] == '(')) {
+                ++pos;
+                type += 2;
+            }
+            const size_t tag = getDCETag(file, pos);
+            if (tag != string::npos) {
+                conditions[tag * g_numConditionsDCE + type].push_back(findPos);
+            }
+        }
+        findPos = file.find("if", findPos + 2);
+    }
+}
+
+/**
+ * Inserts a marker in front of each DCE tag used in a condition (i.e. "if (", "if(", "&", "& ", "|" or "| ") so that
+ * the conditions are still valid after pre-processing.
+ * @param [in,out] file The file to update.
+ */
+static void insertDCEMarkers(string& file)
+{
+    string output;
+    output.reserve(file.length() + (file.length() / 64));
+    size_t last = 0;
+    size_t findPos = file.find_first_of("&|(");
+    while (findPos != string::npos) {
+        size_t tagPos = string::npos;
+        if (file[findPos] == '(') {
+            if (((findPos >= 2) && (file.compare(findPos - 2, 2, "if") == 0)) ||
+                ((findPos >= 3) && (file.compare(findPos - 3, 3, "if ") == 0))) {
+                tagPos = findPos + 1;
+            }
+        } else {
+            tagPos = ((findPos + 1 < file.length()) && (file[findPos + 1] == ' ')) ? findPos + 2 : findPos + 1;
+        }
+        if ((tagPos != string::npos) && (getDCETag(file, tagPos) != string::npos)) {
+            output.append(file, last, tagPos - last);
+            output += "XXX";
+            last = tagPos;
+        }
+        findPos = file.find_first_of("&|(", findPos + 1);
+    }
+    if (last > 0) {
+        output.append(file, last, string::npos);
+        file = std::move(output);
+    }
+}
+
+/**
+ * Removes any markers added by insertDCEMarkers.
+ * @param [in,out] file The file to update.
+ */
+static void removeDCEMarkers(string& file)
+{
+    string output;
+    output.reserve(file.length());
+    size_t last = 0;
+    size_t findPos = file.find("XXX");
+    while (findPos != string::npos) {
+        if ((getDCETag(file, findPos + 3) != string::npos) &&
+            (((findPos >= 1) && ((file[findPos - 1] == '&') || (file[findPos - 1] == '|'))) ||
+                ((findPos >= 2) && (file[findPos - 1] == ' ') &&
+                    ((file[findPos - 2] == '&') || (file[findPos - 2] == '|'))) ||
+                ((findPos >= 3) && (file.compare(findPos - 3, 3, "if(") == 0)) ||
+                ((findPos >= 4) && (file.compare(findPos - 4, 4, "if (") == 0)))) {
+            output.append(file, last, findPos - last);
+            last = findPos + 3;
+        }
+        findPos = file.find("XXX", findPos + 3);
+    }
+    if (last > 0) {
+        output.append(file, last, string::npos);
+        file = std::move(output);
+    }
+}
+
+/**
+ * Reserves additional threads for scanning files from the shared worker budget.
+ * @param wanted The number of additional threads wanted.
+ * @return The number of additional threads that have been reserved (may be 0).
+ */
+static size_t acquireScanWorkers(const size_t wanted)
+{
+    // The calling thread also scans files so it is counted as already using 1 core
+    size_t maxWorkers = thread::hardware_concurrency();
+    maxWorkers = (maxWorkers > 1) ? maxWorkers - 1 : 0;
+    lock_guard<mutex> lock(s_scanWorkersMutex);
+    const size_t available = (s_scanWorkers < maxWorkers) ? maxWorkers - s_scanWorkers : 0;
+    const size_t reserved = (wanted < available) ? wanted : available;
+    s_scanWorkers += reserved;
+    return reserved;
+}
+
+/**
+ * Returns previously reserved threads to the shared worker budget.
+ * @param reserved The number of reserved threads.
+ */
+static void releaseScanWorkers(const size_t reserved)
+{
+    lock_guard<mutex> lock(s_scanWorkersMutex);
+    s_scanWorkers -= reserved;
+}
+
+/**
+ * Checks whether a value can be stored in a DCE snapshot file.
+ * @param value The value to check.
+ * @return True if the value contains no tab or new line characters, false if not.
+ */
+static bool isDCESnapshotValue(const string& value)
+{
+    return value.find_first_of("\t\n") == string::npos;
+}
+
+/**
+ * Gets a number stored in a DCE snapshot.
+ * @param       value     The snapshot value.
+ * @param [out] retNumber The number.
+ * @return True if it succeeds, false if the value is not a valid number.
+ */
+static bool getDCESnapshotNumber(const string& value, uint64_t& retNumber)
+{
+    if (value.empty() || (value[0] < '0') || (value[0] > '9')) {
+        return false;
+    }
+    char* end = nullptr;
+    retNumber = strtoull(value.c_str(), &end, 10);
+    return *end == '\0';
+}
 
 bool ProjectGenerator::outputProjectDCE(const StaticList& includeDirs)
 {
     outputLine("  Generating missing DCE symbols (" + m_projectName + ")...");
     // Create list of source files to scan
 #if !FORCEALLDCE
-    StaticList searchFiles = m_includesC;
+    StaticList searchFiles(m_includesC.begin(), m_includesC.end());
     searchFiles.insert(searchFiles.end(), m_includesCPP.begin(), m_includesCPP.end());
     searchFiles.insert(searchFiles.end(), m_includesH.begin(), m_includesH.end());
 #else
@@ -47,6 +228,11 @@ bool ProjectGenerator::outputProjectDCE(const StaticList& includeDirs)
     // Ensure we can add extra items to the list without needing reallocs
     searchFiles.reserve(((searchFiles.size() + m_includesH.size()) * 3) + 500);
 
+    // Load the results of any previous run so that unchanged files do not need to be scanned again
+    DCESnapshot snapshot;
+    loadDCESnapshot(snapshot);
+    DCESnapshot newSnapshot;
+
     // Check for DCE constructs
     map<string, DCEParams> foundDCEUsage;
     set<string> nonDCEUsage;
@@ -57,94 +243,64 @@ bool ProjectGenerator::outputProjectDCE(const StaticList& includeDirs)
             *itFile = itFile->substr(2);
         }
     }
-    // Search through each included file
-    for (auto itFile = searchFiles.cbegin(); itFile < searchFiles.cend(); ++itFile) {
-        // Open the input file
-        string file;
-        if (!loadFromFile(*itFile, file)) {
-            return false;
+    // Scan each file in parallel. Any new files found while scanning are then scanned in the next pass. The results of
+    // each file are merged in order so that the output is the same as scanning each file in turn.
+    size_t firstFile = 0;
+    while (firstFile < searchFiles.size()) {
+        const size_t lastFile = searchFiles.size();
+        vector<DCEScanResult> results(lastFile - firstFile);
+        atomic<size_t> nextFile(firstFile);
+        // The current thread always scans so progress is made even if no additional threads are available
+        const size_t numWorkers = acquireScanWorkers(results.size() - 1);
+        vector<future<void>> workers;
+        workers.reserve(numWorkers);
+        for (size_t i = 0; i < numWorkers; ++i) {
+            workers.push_back(async(launch::async, &ProjectGenerator::outputProjectDCEScanFiles, this,
+                cref(searchFiles), firstFile, ref(nextFile), ref(results), cref(snapshot)));
         }
-
-        // Check if this file includes additional source files
-        vector<string> extensions = {".c\"", ".h\""};
-        for (auto& ext : extensions) {
-            uint findPos = file.find(ext);
-            while (findPos != string::npos) {
-                // Check if this is an include
-                uint findPos3 = file.rfind("#include", findPos);
-                if (findPos3 != string::npos) {
-                    uint findPos2 = file.find_first_not_of(g_whiteSpace, findPos3 + 8);
-                    if (findPos2 != string::npos && file[findPos2] == '\"' &&
-                        file.find_first_of("\".", findPos2 + 2) == findPos) {
-                        // Get the name of the file
-                        ++findPos2;
-                        findPos += 2;
-                        string templateFile = file.substr(findPos2, findPos - findPos2);
-                        // Split filename from any directory structures
-                        replace(templateFile.begin(), templateFile.end(), '\\', '/');
-                        uint projName = templateFile.rfind(m_projectName + '/');
-                        if (projName != string::npos) {
-                            templateFile = templateFile.substr(projName + 1 + m_projectName.length());
-                        }
-                        if (templateFile.length() >= 3) {
-                            string found;
-                            string back = templateFile;
-                            templateFile = m_projectDir + back;
-                            if (!findFile(templateFile, found)) {
-                                templateFile = (m_configHelper.m_rootDirectory.length() > 0) ?
-                                    m_configHelper.m_rootDirectory + back :
-                                    back;
-                                if (!findFile(templateFile, found)) {
-                                    templateFile = m_configHelper.m_solutionDirectory + m_projectName + '/' + back;
-                                    if (!findFile(templateFile, found)) {
-                                        templateFile = itFile->substr(0, itFile->rfind('/') + 1) + back;
-                                        if (!findFile(templateFile, found)) {
-                                            templateFile = m_configHelper.m_solutionDirectory + back;
-                                            if (!findFile(templateFile, found)) {
-                                                // Fail only if this is a c file
-                                                if (ext == extensions[0]) {
-                                                    outputError("Failed to find included file " + back);
-                                                    return false;
-                                                }
-                                                templateFile = "";
-                                            }
-                                        }
-                                    }
-                                }
-                            }
-                            // Add the file to the list
-                            if (templateFile.length() >= 3) {
-                                if (templateFile.find("./") == 0) {
-                                    templateFile = templateFile.substr(2);
-                                }
-                                if (ext == extensions[0]) {
-                                    // If it's a source file then insert directly into existing file so we can find any
-                                    // nested DCE between files
-                                    string file2;
-                                    if (!loadFromFile(templateFile, file2, false, false)) {
-                                        outputError("Failed to open included file " + templateFile);
-                                        return false;
-                                    }
-                                    file.replace(findPos3, findPos + 1, file2);
-                                    findPos += file2.length();
-                                } else if (find(searchFiles.begin(), searchFiles.end(), templateFile) ==
-                                    searchFiles.end()) {
-                                    searchFiles.push_back(templateFile);
-                                }
-                            }
-                        }
-                    }
+        outputProjectDCEScanFiles(searchFiles, firstFile, nextFile, results, snapshot);
+        for (auto& i : workers) {
+            i.wait();
+        }
+        releaseScanWorkers(numWorkers);
+        for (size_t i = firstFile; i < lastFile; ++i) {
+            const DCEScanResult& result = results[i - firstFile];
+            if (!result.success) {
+                return false;
+            }
+            // Add any new files to the list
+            for (const auto& j : result.includedFiles) {
+                if (find(searchFiles.begin(), searchFiles.end(), j) == searchFiles.end()) {
+                    searchFiles.push_back(j);
+                }
+            }
+            if (result.requiresPreProcess) {
+                preProcFiles.push_back(searchFiles[i]);
+                continue;
+            }
+            // Any usage found outside of DCE overrides usage found within DCE in this or any previous file
+            for (const auto& j : result.nonDCEUsage) {
+                nonDCEUsage.insert(j);
+                foundDCEUsage.erase(j);
+            }
+            for (const auto& j : result.foundDCEUsage) {
+                if (nonDCEUsage.find(j.first) != nonDCEUsage.end()) {
+                    continue;
+                }
+                auto found = foundDCEUsage.find(j.first);
+                if (found == foundDCEUsage.end()) {
+                    foundDCEUsage[j.first] = j.second;
+                } else {
+                    string retDefine;
+                    outputProgramDCEsCombineDefine(found->second.define, j.second.define, retDefine);
+                    found->second.define = retDefine;
                 }
-                // Check for more
-                findPos = file.find(ext, findPos + 1);
             }
         }
-
-        bool requiresPreProcess = false;
-        outputProjectDCEFindFunctions(file, *itFile, foundDCEUsage, requiresPreProcess, nonDCEUsage);
-        if (requiresPreProcess) {
-            preProcFiles.push_back(*itFile);
+        for (size_t i = firstFile; i < lastFile; ++i) {
+            newSnapshot.files[searchFiles[i]] = std::move(results[i - firstFile]);
         }
+        firstFile = lastFile;
     }
 #if !FORCEALLDCE
     // Get a list of all files in current project directory (including subdirectories)
@@ -169,39 +325,68 @@ bool ProjectGenerator::outputProjectDCE(const StaticList& includeDirs)
     }
 #endif
 
+    // Reuse the DCE definitions of a previous run if none of the input used to create them has changed
+    const string outName = m_configHelper.m_solutionDirectory + '/' + m_projectName + '/' + "dce_defs.c";
+    newSnapshot.key = buildDCESnapshotKey(includeDirs, newSnapshot.files, searchFiles);
+    if ((newSnapshot.key == snapshot.key) && checkDCESnapshotDependencies(snapshot)) {
+        string finalDCEOutFile;
+        if (!snapshot.hasOutput ||
+            (loadFromFile(outName, finalDCEOutFile, false, false) &&
+                (hashString(finalDCEOutFile) == snapshot.outputHash))) {
+            newSnapshot.dependencies = snapshot.dependencies;
+            newSnapshot.hasOutput = snapshot.hasOutput;
+            newSnapshot.outputHash = snapshot.outputHash;
+            if (newSnapshot.hasOutput) {
+                // Write the unchanged file so that it is still marked as output by this run
+                writeToFile(outName, finalDCEOutFile);
+                string projectName;
+                m_configHelper.makeFileProjectRelative(outName, projectName);
+                m_includesC.push_back(projectName);
+            }
+            saveDCESnapshot(newSnapshot);
+            return true;
+        }
+    }
+
     // Now we need to find the declaration of each function
     map<string, DCEParams> foundDCEFunctions;
     map<string, DCEParams> foundDCEVariables;
     if (!foundDCEUsage.empty()) {
-        // Search through each included file
+        // Index the declarations in each file (headers are searched first so they take precedence over code files)
+        DCEDeclarations declarations;
         for (const auto& i : searchFiles) {
-            string file;
-            if (!loadFromFile(i, file)) {
+            // Get the declaration file
+            string fileName;
+            makePathsRelative(i, m_configHelper.m_rootDirectory, fileName);
+            if (fileName.at(0) == '.') {
+                fileName = fileName.substr(2);
+            }
+            shared_ptr<const DCEDeclarations> fileDeclarations;
+            if (!loadDCEDeclarations(i, fileName, fileDeclarations)) {
                 return false;
             }
-            for (auto itDCE = foundDCEUsage.begin(); itDCE != foundDCEUsage.end();) {
-                string return2;
-                bool isFunc;
-                if (outputProjectDCEsFindDeclarations(file, itDCE->first, i, return2, isFunc)) {
-                    // Get the declaration file
-                    string fileName;
-                    makePathsRelative(i, m_configHelper.m_rootDirectory, fileName);
-                    if (fileName.at(0) == '.') {
-                        fileName = fileName.substr(2);
-                    }
-                    if (isFunc) {
-                        foundDCEFunctions[return2] = {itDCE->second.define, fileName};
-                    } else {
-                        foundDCEVariables[return2] = {itDCE->second.define, fileName};
-                    }
-
-                    // Remove it from the list
-                    foundDCEUsage.erase(itDCE++);
+            // Any existing declaration takes precedence over one found in a later file
+            for (const auto& j : *fileDeclarations) {
+                declarations.emplace(j.first, j.second);
+            }
+        }
+        for (auto itDCE = foundDCEUsage.begin(); itDCE != foundDCEUsage.end();) {
+            string return2;
+            bool isFunc;
+            string fileName;
+            if (outputProjectDCEsFindDeclaration(declarations, itDCE->first, return2, isFunc, fileName)) {
+                if (isFunc) {
+                    foundDCEFunctions[return2] = {itDCE->second.define, fileName};
                 } else {
-                    // Only increment the iterator when nothing has been found
-                    // when we did find something we erased a value from the list so the iterator is still valid
-                    ++itDCE;
+                    foundDCEVariables[return2] = {itDCE->second.define, fileName};
                 }
+
+                // Remove it from the list
+                foundDCEUsage.erase(itDCE++);
+            } else {
+                // Only increment the iterator when nothing has been found
+                // when we did find something we erased a value from the list so the iterator is still valid
+                ++itDCE;
             }
         }
     }
@@ -213,104 +398,35 @@ bool ProjectGenerator::outputProjectDCE(const StaticList& includeDirs)
 
     // Check if we failed to find any functions
     if (!foundDCEUsage.empty()) {
-        vector<string> includeDirs2 = includeDirs;
-        string tempFolder = m_tempDirectory + m_projectName;
-        if (!makeDirectory(m_tempDirectory) || !makeDirectory(tempFolder)) {
-            outputError("Failed to create temporary working directory (" + tempFolder + ")");
-            return false;
-        }
         // Get all the files that include functions
         map<string, vector<DCEParams>> functionFiles;
-        // Remove project dir from start of file
-        string projectDirCut;
-        makePathsRelative(m_projectDir, m_configHelper.m_rootDirectory, projectDirCut);
-        projectDirCut = (projectDirCut.find('.') == 0) ? projectDirCut.substr(2) : projectDirCut;
         for (auto& i : foundDCEUsage) {
-            // Make source file relative to root
-            string file;
-            makePathsRelative(i.second.file, m_configHelper.m_rootDirectory, file);
-            file = (file.find('.') == 0) ? file.substr(2) : file;
-            uint pos = (projectDirCut.length() > 0) ? file.find(projectDirCut) : string::npos;
-            pos = (pos == string::npos) ? 0 : pos + projectDirCut.length();
-            file = tempFolder + '/' + file.substr(pos);
-            if (file.find('/', tempFolder.length() + 1) != string::npos) {
-                string sFolder = file.substr(0, file.rfind('/'));
-                if (!makeDirectory(sFolder)) {
-                    outputError("Failed to create temporary working sub-directory (" + sFolder + ")");
-                    return false;
-                }
-            }
-            // Copy file to local working directory
-            if (!copyFile(i.second.file, file)) {
-                outputError("Failed to copy dce file (" + i.second.file + ") to temporary directory (" + file + ")");
-                return false;
-            }
-            functionFiles[file].push_back({i.second.define, i.first});
-        }
-        map<string, vector<string>> directoryObjects;
-        const string tags2[] = {"if (", "if(", "& ", "&", "| ", "|"};
-        for (auto& i : functionFiles) {
-            // Get subdirectory
-            string subFolder;
-            if (i.first.find('/', tempFolder.length() + 1) != string::npos) {
-                subFolder = m_projectDir +
-                    i.first.substr(tempFolder.length() + 1, i.first.rfind('/') - tempFolder.length() - 1);
-                if (find(includeDirs2.begin(), includeDirs2.end(), subFolder) == includeDirs2.end()) {
-                    // Need to add subdirectory to include list
-                    includeDirs2.push_back(subFolder);
-                }
-                subFolder = subFolder.substr(m_projectDir.length());
-            }
-            directoryObjects[subFolder].push_back(i.first);
-            // Modify existing tags so that they are still valid after preprocessing
-            string file;
-            if (!loadFromFile(i.first, file)) {
-                return false;
-            }
-            for (const auto& j : g_tagsDCE) {
-                for (const auto& k : tags2) {
-                    const string search = k + j;
-                    // Search for all occurrences
-                    uint findPos = 0;
-                    string replace = k + "XXX" + j;
-                    while ((findPos = file.find(search, findPos)) != string::npos) {
-                        file.replace(findPos, search.length(), replace);
-                        findPos += replace.length() + 1;
-                    }
-                }
-            }
-            if (!writeToFile(i.first, file)) {
-                return false;
-            }
+            functionFiles[i.second.file].push_back({i.second.define, i.first});
         }
         // Add current directory to include list (must be done last to ensure correct include order)
+        vector<string> includeDirs2 = includeDirs;
         if (find(includeDirs2.begin(), includeDirs2.end(), m_projectDir) == includeDirs2.end()) {
             includeDirs2.push_back(m_projectDir);
         }
-        if (!runCompiler(includeDirs2, directoryObjects, 1)) {
-            return false;
-        }
+        PreProcessor preProcessor;
+        buildPreProcessor(includeDirs2, preProcessor);
         // Check the file that the function usage was found in to see if it was declared using macro expansion
         for (auto& i : functionFiles) {
-            string file = i.first;
-            file.at(file.length() - 1) = 'i';
-            if (!loadFromFile(file, file)) {
+            string file;
+            if (!loadFromFile(i.first, file)) {
                 return false;
             }
 
-            // Restore the initial macro names
-            for (const auto& j : g_tagsDCE) {
-                for (const auto& k : tags2) {
-                    const string search = k + j;
-                    // Search for all occurrences
-                    uint findPos = 0;
-                    string find = k + "XXX" + j;
-                    while ((findPos = file.find(find, findPos)) != string::npos) {
-                        file.replace(findPos, find.length(), search);
-                        findPos += search.length() + 1;
-                    }
-                }
+            // Modify existing tags so that they are still valid after preprocessing
+            insertDCEMarkers(file);
+            string preProcessedFile;
+            if (!preProcessor.process(i.first, file, preProcessedFile)) {
+                return false;
             }
+            file = std::move(preProcessedFile);
+
+            // Restore the initial macro names
+            removeDCEMarkers(file);
 
             // Check for any un-found function usage
             map<string, DCEParams> newDCEUsage;
@@ -336,26 +452,30 @@ bool ProjectGenerator::outputProjectDCE(const StaticList& includeDirs)
                 }
             }
 
+            // Get the declaration file
+            string fileName;
+            makePathsRelative(i.first, m_configHelper.m_rootDirectory, fileName);
+            if (fileName.at(0) == '.') {
+                fileName = fileName.substr(2);
+            }
+            DCEDeclarations declarations;
+            outputProjectDCEIndexDeclarations(file, fileName, declarations);
+
             // Search through each function in the current file
             for (const auto& j : i.second) {
                 if (j.define != "#") {
                     string return2;
                     bool isFunc;
-                    if (outputProjectDCEsFindDeclarations(file, j.file, i.first, return2, isFunc)) {
-                        // Get the declaration file
-                        string fileName;
-                        makePathsRelative(i.first, m_configHelper.m_rootDirectory, fileName);
-                        if (fileName.at(0) == '.') {
-                            fileName = fileName.substr(2);
-                        }
+                    string declarationFile;
+                    if (outputProjectDCEsFindDeclaration(declarations, j.file, return2, isFunc, declarationFile)) {
                         // Add the declaration (ensure not to stomp a function found before needing pre-processing)
                         if (isFunc) {
                             if (foundDCEFunctions.find(return2) == foundDCEFunctions.end()) {
-                                foundDCEFunctions[return2] = {j.define, fileName};
+                                foundDCEFunctions[return2] = {j.define, declarationFile};
                             }
                         } else {
                             if (foundDCEVariables.find(return2) == foundDCEVariables.end()) {
-                                foundDCEVariables[return2] = {j.define, fileName};
+                                foundDCEVariables[return2] = {j.define, declarationFile};
                             }
                         }
                         // Remove the function from list
@@ -368,8 +488,12 @@ bool ProjectGenerator::outputProjectDCE(const StaticList& includeDirs)
             }
         }
 
-        // Delete the created temp files
-        deleteFolder(m_tempDirectory);
+        // Store every included file so that the results can be reused while they are unchanged
+        for (const auto& i : preProcessor.getIncludedFiles()) {
+            // Files that can not be read are given a hash that will not match so that they are always re-checked
+            MappedFile mapping;
+            newSnapshot.dependencies.emplace_back(i, (mapping.open(i, false)) ? hashString(mapping.view()) : 0);
+        }
     }
 
     // Get any required hard coded values
@@ -451,11 +575,11 @@ bool ProjectGenerator::outputProjectDCE(const StaticList& includeDirs)
             }
             // Check to ensure the function correctly declares parameter names.
             string function = i.first;
-            uint pos = function.find('(');
-            uint count = 0;
+            size_t pos = function.find('(');
+            size_t count = 0;
             while (pos != string::npos) {
-                uint pos2 = function.find(',', pos + 1);
-                uint posBack = pos2;
+                size_t pos2 = function.find(',', pos + 1);
+                size_t posBack = pos2;
                 pos2 = (pos2 != string::npos) ? pos2 : function.rfind(')');
                 pos2 = function.find_last_not_of(g_whiteSpace, pos2 - 1);
                 if (pos2 == pos) {
@@ -493,7 +617,7 @@ bool ProjectGenerator::outputProjectDCE(const StaticList& includeDirs)
             }
             outFile += function + " {";
             // Need to check return type
-            uint ret2 = function.find_first_of(g_whiteSpace);
+            size_t ret2 = function.find_first_of(g_whiteSpace);
             string return2 = function.substr(0, ret2);
             // Check if space before '*'
             ret2 = function.find_first_not_of(g_whiteSpace, ret2 + 1);
@@ -538,7 +662,7 @@ bool ProjectGenerator::outputProjectDCE(const StaticList& includeDirs)
                 bool bReserved = (m_configHelper.m_replaceList.find(configOpt->m_prefix + configOpt->m_option) !=
                     m_configHelper.m_replaceList.end());
                 if (!bReserved) {
-                    enabled = (configOpt->m_value == "1");
+                    enabled = m_configHelper.isConfigValueEnabled(configOpt);
                 }
                 usePreProc = usePreProc || bReserved;
             }
@@ -585,15 +709,266 @@ bool ProjectGenerator::outputProjectDCE(const StaticList& includeDirs)
         finalDCEOutFile += '\n' + outFile;
 
         // Output the new file
-        string outName = m_configHelper.m_solutionDirectory + '/' + m_projectName + '/' + "dce_defs.c";
         writeToFile(outName, finalDCEOutFile);
-        m_configHelper.makeFileProjectRelative(outName, outName);
-        m_includesC.push_back(outName);
+        newSnapshot.hasOutput = true;
+        newSnapshot.outputHash = hashString(finalDCEOutFile);
+        string projectName;
+        m_configHelper.makeFileProjectRelative(outName, projectName);
+        m_includesC.push_back(projectName);
+    }
+    saveDCESnapshot(newSnapshot);
+    return true;
+}
+
+void ProjectGenerator::outputProjectDCEScanFiles(const StaticList& files, const size_t firstFile,
+    atomic<size_t>& nextFile, vector<DCEScanResult>& results, const DCESnapshot& snapshot) const
+{
+    size_t i;
+    while ((i = nextFile++) < firstFile + results.size()) {
+        results[i - firstFile].success = outputProjectDCEScanFile(files[i], results[i - firstFile], snapshot);
+    }
+}
+
+bool ProjectGenerator::outputProjectDCEScanFile(
+    const string& fileName, DCEScanResult& result, const DCESnapshot& snapshot) const
+{
+    // Open the input file
+    string file;
+    if (!loadFromFile(fileName, file)) {
+        return false;
+    }
+
+    // Check if this file includes additional source files
+    vector<string> extensions = {".c\"", ".h\""};
+    for (auto& ext : extensions) {
+        size_t findPos = file.find(ext);
+        while (findPos != string::npos) {
+            // Check if this is an include
+            size_t findPos3 = file.rfind("#include", findPos);
+            if (findPos3 != string::npos) {
+                size_t findPos2 = file.find_first_not_of(g_whiteSpace, findPos3 + 8);
+                if (findPos2 != string::npos && file[findPos2] == '\"' &&
+                    file.find_first_of("\".", findPos2 + 2) == findPos) {
+                    // Get the name of the file
+                    ++findPos2;
+                    findPos += 2;
+                    string templateFile = file.substr(findPos2, findPos - findPos2);
+                    // Split filename from any directory structures
+                    replace(templateFile.begin(), templateFile.end(), '\\', '/');
+                    size_t projName = templateFile.rfind(m_projectName + '/');
+                    if (projName != string::npos) {
+                        templateFile = templateFile.substr(projName + 1 + m_projectName.length());
+                    }
+                    if (templateFile.length() >= 3) {
+                        string found;
+                        string back = templateFile;
+                        templateFile = m_projectDir + back;
+                        if (!findIndexedFile(templateFile, found)) {
+                            templateFile = (m_configHelper.m_rootDirectory.length() > 0) ?
+                                m_configHelper.m_rootDirectory + back :
+                                back;
+                            if (!findIndexedFile(templateFile, found)) {
+                                templateFile = m_configHelper.m_solutionDirectory + m_projectName + '/' + back;
+                                if (!findIndexedFile(templateFile, found)) {
+                                    templateFile = fileName.substr(0, fileName.rfind('/') + 1) + back;
+                                    if (!findIndexedFile(templateFile, found)) {
+                                        templateFile = m_configHelper.m_solutionDirectory + back;
+                                        if (!findIndexedFile(templateFile, found)) {
+                                            // Fail only if this is a c file
+                                            if (ext == extensions[0]) {
+                                                outputError("Failed to find included file " + back);
+                                                return false;
+                                            }
+                                            templateFile = "";
+                                        }
+                                    }
+                                }
+                            }
+                        }
+                        // Add the file to the list
+                        if (templateFile.length() >= 3) {
+                            if (templateFile.find("./") == 0) {
+                                templateFile = templateFile.substr(2);
+                            }
+                            if (ext == extensions[0]) {
+                                // If it's a source file then insert directly into existing file so we can find any
+                                // nested DCE between files
+                                string file2;
+                                if (!loadFromFile(templateFile, file2, false, false)) {
+                                    outputError("Failed to open included file " + templateFile);
+                                    return false;
+                                }
+                                file.replace(findPos3, findPos + 1, file2);
+                                findPos += file2.length();
+                            } else if (find(result.includedFiles.begin(), result.includedFiles.end(),
+                                           templateFile) == result.includedFiles.end()) {
+                                result.includedFiles.push_back(templateFile);
+                            }
+                        }
+                    }
+                }
+            }
+            // Check for more
+            findPos = file.find(ext, findPos + 1);
+        }
+    }
+
+    // Reuse the results of a previous run if the file is unchanged
+    result.hash = hashString(file);
+    const auto previous = snapshot.files.find(fileName);
+    if ((previous != snapshot.files.end()) && (previous->second.hash == result.hash)) {
+        result.requiresPreProcess = previous->second.requiresPreProcess;
+        result.foundDCEUsage = previous->second.foundDCEUsage;
+        result.nonDCEUsage = previous->second.nonDCEUsage;
+        return true;
     }
+
+    outputProjectDCEFindSharedFunctions(file, fileName, result);
     return true;
 }
 
-void ProjectGenerator::outputProjectDCEFindFunctions(const string& file, const string& fileName,
+void ProjectGenerator::outputProjectDCEFindSharedFunctions(
+    const string_view file, const string& fileName, DCEScanResult& result) const
+{
+    // Source files are shared between each variant so they only need to be scanned once
+    static map<string, DCEScanResult> s_scanResults;
+    static mutex s_scanResultsMutex;
+    const string key = m_projectName + '\n' + fileName;
+    {
+        lock_guard<mutex> lock(s_scanResultsMutex);
+        const auto found = s_scanResults.find(key);
+        if ((found != s_scanResults.end()) && (found->second.hash == result.hash)) {
+            result.requiresPreProcess = found->second.requiresPreProcess;
+            result.foundDCEUsage = found->second.foundDCEUsage;
+            result.nonDCEUsage = found->second.nonDCEUsage;
+            return;
+        }
+    }
+    outputProjectDCEFindFunctions(file, fileName, result.foundDCEUsage, result.requiresPreProcess, result.nonDCEUsage);
+    lock_guard<mutex> lock(s_scanResultsMutex);
+    s_scanResults[key] = result;
+}
+
+uint64_t ProjectGenerator::buildDCESnapshotKey(const StaticList& includeDirs,
+    const map<string, DCEScanResult>& scannedFiles, const StaticList& projectFiles) const
+{
+    // The resolved config values determine which DCE blocks are used
+    uint64_t key = hashString(m_projectDir + '\n' + m_configHelper.m_rootDirectory + '\n');
+    for (auto i = m_configHelper.m_configValues.begin(); i < m_configHelper.m_configValues.end(); ++i) {
+        key = hashString(i->m_prefix + i->m_option + '=' + m_configHelper.getConfigValue(i) + '\n', key);
+    }
+    for (const auto& i : includeDirs) {
+        key = hashString(i + '\n', key);
+    }
+    for (const auto& i : scannedFiles) {
+        key = hashString(i.first + '=' + to_string(i.second.hash) + '\n', key);
+    }
+    // Declarations may be found in any file within the project
+    for (const auto& i : projectFiles) {
+        MappedFile mapping;
+        key = hashString(i + '\n', key);
+        if (mapping.open(i, false)) {
+            key = hashString(mapping.view(), key);
+        }
+    }
+    return key;
+}
+
+void ProjectGenerator::loadDCESnapshot(DCESnapshot& snapshot) const
+{
+    string file;
+    if (!loadFromFile(m_configHelper.m_solutionDirectory + m_projectName + "_dce.snapshot", file, false, false)) {
+        return;
+    }
+    // First line identifies the snapshot version and project
+    istringstream lines(file);
+    string line;
+    if (!getline(lines, line) || (line != "DCE snapshot " + to_string(g_snapshotVersionDCE) + ' ' + m_projectName)) {
+        return;
+    }
+    // Each following line starts with a type followed by tab separated values
+    DCEScanResult* current = nullptr;
+    while (getline(lines, line)) {
+        vector<string> values;
+        size_t startPos = 0;
+        size_t endPos = line.find('\t');
+        while (endPos != string::npos) {
+            values.push_back(line.substr(startPos, endPos - startPos));
+            startPos = endPos + 1;
+            endPos = line.find('\t', startPos);
+        }
+        values.push_back(line.substr(startPos));
+        uint64_t number;
+        if ((values[0] == "K") && (values.size() == 2) && getDCESnapshotNumber(values[1], number)) {
+            snapshot.key = number;
+        } else if ((values[0] == "O") && (values.size() == 2) && (values[1] == "-")) {
+            snapshot.hasOutput = false;
+            snapshot.outputHash = 0;
+        } else if ((values[0] == "O") && (values.size() == 2) && getDCESnapshotNumber(values[1], number)) {
+            snapshot.hasOutput = true;
+            snapshot.outputHash = number;
+        } else if ((values[0] == "D") && (values.size() == 3) && getDCESnapshotNumber(values[1], number)) {
+            snapshot.dependencies.emplace_back(values[2], number);
+        } else if ((values[0] == "F") && (values.size() == 3) && getDCESnapshotNumber(values[1], number)) {
+            current = &snapshot.files[values[2]];
+            current->hash = number;
+        } else if ((values[0] == "P") && (current != nullptr)) {
+            current->requiresPreProcess = true;
+        } else if ((values[0] == "U") && (values.size() == 4) && (current != nullptr)) {
+            current->foundDCEUsage[values[1]] = {values[2], values[3]};
+        } else if ((values[0] == "N") && (values.size() == 2) && (current != nullptr)) {
+            current->nonDCEUsage.insert(values[1]);
+        } else {
+            outputInfo("Ignoring invalid DCE snapshot (" + m_projectName + ")");
+            snapshot = DCESnapshot();
+            return;
+        }
+    }
+}
+
+void ProjectGenerator::saveDCESnapshot(const DCESnapshot& snapshot) const
+{
+    string file = "DCE snapshot " + to_string(g_snapshotVersionDCE) + ' ' + m_projectName + '\n';
+    file += "K\t" + to_string(snapshot.key) + '\n';
+    file += "O\t" + ((snapshot.hasOutput) ? to_string(snapshot.outputHash) : "-") + '\n';
+    for (const auto& i : snapshot.dependencies) {
+        file += "D\t" + to_string(i.second) + '\t' + i.first + '\n';
+    }
+    for (const auto& i : snapshot.files) {
+        // Files with values that cannot be stored on a single line are skipped and will just be scanned again
+        bool valid = isDCESnapshotValue(i.first);
+        string fileValues = "F\t" + to_string(i.second.hash) + '\t' + i.first + '\n';
+        if (i.second.requiresPreProcess) {
+            fileValues += "P\n";
+        }
+        for (const auto& j : i.second.foundDCEUsage) {
+            valid = valid && isDCESnapshotValue(j.first) && isDCESnapshotValue(j.second.define) &&
+                isDCESnapshotValue(j.second.file);
+            fileValues += "U\t" + j.first + '\t' + j.second.define + '\t' + j.second.file + '\n';
+        }
+        for (const auto& j : i.second.nonDCEUsage) {
+            valid = valid && isDCESnapshotValue(j);
+            fileValues += "N\t" + j + '\n';
+        }
+        if (valid) {
+            file += fileValues;
+        }
+    }
+    writeToFile(m_configHelper.m_solutionDirectory + m_projectName + "_dce.snapshot", file);
+}
+
+bool ProjectGenerator::checkDCESnapshotDependencies(const DCESnapshot& snapshot)
+{
+    for (const auto& i : snapshot.dependencies) {
+        MappedFile mapping;
+        if (!mapping.open(i.first, false) || (hashString(mapping.view()) != i.second)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ProjectGenerator::outputProjectDCEFindFunctions(const string_view file, const string& fileName,
     map<string, DCEParams>& foundDCEUsage, bool& requiresPreProcess, set<string>& nonDCEUsage) const
 {
     const string tags2[] = {"if (", "if(", "if ((", "if(("};
@@ -637,29 +1012,36 @@ void ProjectGenerator::outputProjectDCEFindFunctions(const string& file, const s
     struct InternalDCEParams
     {
         DCEParams m_params;
-        vector<uint> m_locations;
+        vector<size_t> m_locations;
     };
     map<string, InternalDCEParams> internalList;
-    for (const auto& i : g_tagsDCE) {
-        for (unsigned j = 0; j < sizeof(tags2) / sizeof(string); j++) {
-            const string sSearch = tags2[j] + i;
+    // Find all the conditions at once, they are still processed in the same order as searching for each one in turn
+    vector<vector<size_t>> conditions;
+    findDCEConditions(file, conditions);
+    for (size_t i = 0; i < g_numTagsDCE; ++i) {
+        for (unsigned j = 0; j < g_numConditionsDCE; j++) {
+            const string sSearch = tags2[j] + g_tagsDCE[i];
 
-            // Search for all occurrences
-            uint findPos = file.find(sSearch);
-            while (findPos != string::npos) {
+            // Check each occurrence (skipping any within the code wrapped by a previous occurrence)
+            size_t nextPos = 0;
+            for (const auto& condition : conditions[i * g_numConditionsDCE + j]) {
+                if (condition < nextPos) {
+                    continue;
+                }
+                size_t findPos = condition;
                 // Get the define tag
-                uint findPos2 = file.find(')', findPos + sSearch.length());
+                size_t findPos2 = file.find(')', findPos + sSearch.length());
                 findPos = findPos + tags2[j].length();
                 if (j >= 2) {
                     --findPos;
                 }
                 // Skip any '(' found within the parameters itself
-                uint findPos3 = file.find('(', findPos);
+                size_t findPos3 = file.find('(', findPos);
                 while ((findPos3 != string::npos) && (findPos3 < findPos2)) {
                     findPos3 = file.find('(', findPos3 + 1);
                     findPos2 = file.find(')', findPos2 + 1);
                 }
-                string define = file.substr(findPos, findPos2 - findPos);
+                string define(file.substr(findPos, findPos2 - findPos));
 
                 // Check if define contains pre-processor tags
                 if (define.find("##") != string::npos) {
@@ -669,13 +1051,13 @@ void ProjectGenerator::outputProjectDCEFindFunctions(const string& file, const s
                 outputProjectDCECleanDefine(define);
 
                 // Get the block of code being wrapped
-                string code;
+                string_view code;
                 findPos = file.find_first_not_of(g_whiteSpace, findPos2 + 1);
                 if (file.at(findPos) == '{') {
                     // Need to get the entire block of code being wrapped
                     findPos2 = file.find('}', findPos + 1);
                     // Skip any '{' found within the parameters itself
-                    uint findPos5 = file.find('{', findPos + 1);
+                    size_t findPos5 = file.find('{', findPos + 1);
                     while ((findPos5 != string::npos) && (findPos5 < findPos2)) {
                         findPos5 = file.find('{', findPos5 + 1);
                         findPos2 = file.find('}', findPos2 + 1);
@@ -687,7 +1069,7 @@ void ProjectGenerator::outputProjectDCEFindFunctions(const string& file, const s
                         ++findPos2; // must include the ;
                     } else {
                         // Must check if next line was also an if
-                        uint findPos5 = findPos;
+                        size_t findPos5 = findPos;
                         while ((file.at(findPos5) == 'i') && (file.at(findPos5 + 1) == 'f')) {
                             // Get the define tag
                             findPos5 = file.find('(', findPos5 + 2);
@@ -703,7 +1085,7 @@ void ProjectGenerator::outputProjectDCEFindFunctions(const string& file, const s
                                 // Need to get the entire block of code being wrapped
                                 findPos2 = file.find('}', findPos5 + 1);
                                 // Skip any '{' found within the parameters itself
-                                uint findPos6 = file.find('{', findPos5 + 1);
+                                size_t findPos6 = file.find('{', findPos5 + 1);
                                 while ((findPos6 != string::npos) && (findPos6 < findPos2)) {
                                     findPos6 = file.find('{', findPos6 + 1);
                                     findPos2 = file.find('}', findPos2 + 1);
@@ -720,7 +1102,7 @@ void ProjectGenerator::outputProjectDCEFindFunctions(const string& file, const s
                     }
                 }
                 code = file.substr(findPos, findPos2 - findPos);
-                uint findBack = findPos;
+                size_t findBack = findPos;
 
                 // Get name of any functions
                 for (const auto& k : funcIdents) {
@@ -728,9 +1110,9 @@ void ProjectGenerator::outputProjectDCEFindFunctions(const string& file, const s
                     while (findPos != string::npos) {
                         bool valid = false;
                         // Check if this is a valid function call
-                        uint findPos5 = code.find_first_of(g_nonName, findPos + 1);
+                        size_t findPos5 = code.find_first_of(g_nonName, findPos + 1);
                         if ((findPos5 != 0) && (findPos5 != string::npos)) {
-                            uint findPos4 = code.find_last_of(g_nonName, findPos5 - 1);
+                            size_t findPos4 = code.find_last_of(g_nonName, findPos5 - 1);
                             findPos4 = (findPos4 == string::npos) ? 0 : findPos4 + 1;
                             // Check if valid function
                             if (findPos4 == findPos) {
@@ -750,7 +1132,7 @@ void ProjectGenerator::outputProjectDCEFindFunctions(const string& file, const s
                             }
                         }
                         if (valid) {
-                            string add = code.substr(findPos, findPos5 - findPos);
+                            string add(code.substr(findPos, findPos5 - findPos));
                             // Check if there are any other DCE conditions
                             string funcDefine = define;
                             for (const auto& m : g_tagsDCE) {
@@ -758,31 +1140,31 @@ void ProjectGenerator::outputProjectDCEFindFunctions(const string& file, const s
                                     const string search2 = tags2[n] + m;
 
                                     // Search for all occurrences
-                                    uint findPos7 = code.rfind(search2, findPos);
+                                    size_t findPos7 = code.rfind(search2, findPos);
                                     while (findPos7 != string::npos) {
                                         // Get the define tag
-                                        uint findPos4 = code.find(')', findPos7 + sSearch.length());
-                                        uint findPos8 = findPos7 + tags2[n].length();
+                                        size_t findPos4 = code.find(')', findPos7 + sSearch.length());
+                                        size_t findPos8 = findPos7 + tags2[n].length();
                                         if (n >= 2) {
                                             --findPos8;
                                         }
                                         // Skip any '(' found within the parameters itself
-                                        uint findPos9 = code.find('(', findPos8);
+                                        size_t findPos9 = code.find('(', findPos8);
                                         while ((findPos9 != string::npos) && (findPos9 < findPos4)) {
                                             findPos9 = code.find('(', findPos9 + 1);
                                             findPos4 = code.find(')', findPos4 + 1);
                                         }
-                                        string define2 = code.substr(findPos8, findPos4 - findPos8);
+                                        string define2(code.substr(findPos8, findPos4 - findPos8));
                                         outputProjectDCECleanDefine(define2);
 
                                         // Get the block of code being wrapped
-                                        string code2;
+                                        string_view code2;
                                         findPos8 = code.find_first_not_of(g_whiteSpace, findPos4 + 1);
                                         if (code.at(findPos8) == '{') {
                                             // Need to get the entire block of code being wrapped
                                             findPos4 = code.find('}', findPos8 + 1);
                                             // Skip any '{' found within the parameters itself
-                                            uint findPos10 = code.find('{', findPos8 + 1);
+                                            size_t findPos10 = code.find('{', findPos8 + 1);
                                             while ((findPos10 != string::npos) && (findPos10 < findPos4)) {
                                                 findPos10 = code.find('{', findPos10 + 1);
                                                 findPos4 = code.find('}', findPos4 + 1);
@@ -819,7 +1201,7 @@ void ProjectGenerator::outputProjectDCEFindFunctions(const string& file, const s
 
                             // Check if not already added
                             auto find = internalList.find(add);
-                            uint valuePosition = findBack + findPos;
+                            size_t valuePosition = findBack + findPos;
                             if (find == internalList.end()) {
                                 // Check that another non DCE instance hasn't been found
                                 if (nonDCEUsage.find(add) == nonDCEUsage.end()) {
@@ -838,32 +1220,32 @@ void ProjectGenerator::outputProjectDCEFindFunctions(const string& file, const s
                 }
 
                 // Search for next occurrence
-                findPos = file.find(sSearch, findPos2 + 1);
+                nextPos = findPos2 + 1;
             }
         }
     }
 
     // Search for usage that is not effected by DCE
     for (const auto& i : funcIdents) {
-        uint findPos = file.find(i);
+        size_t findPos = file.find(i);
         while (findPos != string::npos) {
             bool valid = false;
             // Check if this is a valid value
-            uint findPos3 = file.find_first_of(g_nonName, findPos + 1);
+            size_t findPos3 = file.find_first_of(g_nonName, findPos + 1);
             if (findPos3 != string::npos) {
-                uint findPos4 = file.find_last_of(g_nonName, findPos3 - 1);
+                size_t findPos4 = file.find_last_of(g_nonName, findPos3 - 1);
                 findPos4 = (findPos4 == string::npos) ? 0 : findPos4 + 1;
                 if (findPos4 == findPos) {
                     findPos4 = file.find_first_not_of(g_whiteSpace, findPos3);
                     // Check if declared inside a preprocessor block
-                    uint findPos5 = file.find('#', findPos4 + 1);
+                    size_t findPos5 = file.find('#', findPos4 + 1);
                     if ((findPos5 == string::npos) || (file.at(findPos5 + 1) != 'e')) {
                         // Check if valid function
                         if (file.at(findPos4) == '(') {
                             // Check if function call or declaration (a function call must be inside a function {})
-                            uint check1 = file.rfind('{', findPos);
+                            size_t check1 = file.rfind('{', findPos);
                             if (check1 != string::npos) {
-                                uint check2 = file.rfind('}', findPos);
+                                size_t check2 = file.rfind('}', findPos);
                                 if ((check2 == string::npos) || (check1 > check2)) {
                                     valid = true;
                                 }
@@ -871,7 +1253,7 @@ void ProjectGenerator::outputProjectDCEFindFunctions(const string& file, const s
                             // Check if function definition
                             check1 = file.find(')', findPos4 + 1);
                             // Skip any '(' found within the function parameters itself
-                            uint check2 = file.find('(', findPos4 + 1);
+                            size_t check2 = file.find('(', findPos4 + 1);
                             while ((check2 != string::npos) && (check2 < check1)) {
                                 check2 = file.find('(', check2 + 1);
                                 check1 = file.find(')', check1 + 1) + 1;
@@ -901,7 +1283,7 @@ void ProjectGenerator::outputProjectDCEFindFunctions(const string& file, const s
                 }
             }
             if (valid) {
-                string add = file.substr(findPos, findPos3 - findPos);
+                string add(file.substr(findPos, findPos3 - findPos));
                 // Check if already added
                 auto find = internalList.find(add);
                 if (find == internalList.end()) {
@@ -952,10 +1334,10 @@ void ProjectGenerator::outputProjectDCEFindFunctions(const string& file, const s
 void ProjectGenerator::outputProgramDCEsResolveDefine(string& define)
 {
     // Complex combinations of config options require determining exact values
-    uint startTag = define.find_first_not_of(g_preProcessor);
+    size_t startTag = define.find_first_not_of(g_preProcessor);
     while (startTag != string::npos) {
         // Get the next tag
-        uint div = define.find_first_of(g_preProcessor, startTag);
+        size_t div = define.find_first_of(g_preProcessor, startTag);
         string tag = define.substr(startTag, div - startTag);
         // Check if tag is enabled
         auto configOpt = m_configHelper.getConfigOptionPrefixed(tag);
@@ -966,7 +1348,7 @@ void ProjectGenerator::outputProgramDCEsResolveDefine(string& define)
             // Or this is a reserved value
         } else {
             // Replace the option with its value
-            define.replace(startTag, div - startTag, configOpt->m_value);
+            define.replace(startTag, div - startTag, m_configHelper.getConfigValue(configOpt));
             div = define.find_first_of(g_preProcessor, startTag);
         }
 
@@ -988,12 +1370,12 @@ void ProjectGenerator::outputProgramDCEsResolveDefine(string& define)
             }
             // Get right tag
             ++startTag;
-            uint rightPos = define.find_first_of(g_preProcessor, startTag);
+            size_t rightPos = define.find_first_of(g_preProcessor, startTag);
             // Skip any '(' found within the function parameters itself
             if ((rightPos != string::npos) && (define.at(rightPos) == '(')) {
-                const uint back = rightPos + 1;
+                const size_t back = rightPos + 1;
                 rightPos = define.find(')', back) + 1;
-                uint findPos3 = define.find('(', back);
+                size_t findPos3 = define.find('(', back);
                 while ((findPos3 != string::npos) && (findPos3 < rightPos)) {
                     findPos3 = define.find('(', findPos3 + 1);
                     rightPos = define.find(')', rightPos + 1) + 1;
@@ -1026,12 +1408,12 @@ void ProjectGenerator::outputProgramDCEsResolveDefine(string& define)
                     --startTag;
                 }
                 // Get left tag
-                uint leftPos = define.find_last_of(g_preProcessor, startTag - 1);
+                size_t leftPos = define.find_last_of(g_preProcessor, startTag - 1);
                 // Skip any ')' found within the function parameters itself
                 if ((leftPos != string::npos) && (define.at(leftPos) == ')')) {
-                    const uint back = leftPos - 1;
+                    const size_t back = leftPos - 1;
                     leftPos = define.rfind('(', back);
-                    uint findPos3 = define.rfind(')', back);
+                    size_t findPos3 = define.rfind(')', back);
                     while ((findPos3 != string::npos) && (findPos3 > leftPos)) {
                         findPos3 = define.rfind(')', findPos3 - 1);
                         leftPos = define.rfind('(', leftPos - 1);
@@ -1146,10 +1528,10 @@ void ProjectGenerator::outputProgramDCEsResolveDefine(string& define)
     // Remove any (RESERV)
     startTag = define.find('(');
     while (startTag != string::npos) {
-        uint endTag = define.find(')', startTag);
+        size_t endTag = define.find(')', startTag);
         ++startTag;
         // Skip any '(' found within the function parameters itself
-        uint findPos3 = define.find('(', startTag);
+        size_t findPos3 = define.find('(', startTag);
         while ((findPos3 != string::npos) && (findPos3 < endTag)) {
             findPos3 = define.find('(', findPos3 + 1);
             endTag = define.find(')', endTag + 1);
@@ -1165,115 +1547,196 @@ void ProjectGenerator::outputProgramDCEsResolveDefine(string& define)
     findAndReplace(define, "|", " || ");
 }
 
-bool ProjectGenerator::outputProjectDCEsFindDeclarations(
-    const string& file, const string& function, const string&, string& retDeclaration, bool& isFunction)
+bool ProjectGenerator::outputProjectDCEsCheckDeclaration(const string_view file, size_t findPos, const size_t length,
+    string& retDeclaration, bool& isFunction, bool& isDefinition)
 {
-    uint findPos = file.find(function);
-    while (findPos != string::npos) {
-        const uint findPos4 = file.find_first_not_of(g_whiteSpace, findPos + function.length());
-        if (file.at(findPos4) == '(') {
-            // Check if this is a function call or an actual declaration
-            uint findPos2 = file.find(')', findPos4 + 1);
-            if (findPos2 != string::npos) {
-                // Skip any '(' found within the function parameters itself
-                uint findPos3 = file.find('(', findPos4 + 1);
-                while ((findPos3 != string::npos) && (findPos3 < findPos2)) {
-                    findPos3 = file.find('(', findPos3 + 1);
-                    findPos2 = file.find(')', findPos2 + 1);
+    const size_t findPos4 = file.find_first_not_of(g_whiteSpace, findPos + length);
+    if ((findPos == 0) || (findPos4 == string::npos)) {
+        return false;
+    }
+    if (file.at(findPos4) == '(') {
+        // Check if this is a function call or an actual declaration
+        size_t findPos2 = file.find(')', findPos4 + 1);
+        if (findPos2 != string::npos) {
+            // Skip any '(' found within the function parameters itself
+            size_t findPos3 = file.find('(', findPos4 + 1);
+            while ((findPos3 != string::npos) && (findPos3 < findPos2)) {
+                findPos3 = file.find('(', findPos3 + 1);
+                findPos2 = file.find(')', findPos2 + 1);
+            }
+            if (findPos2 == string::npos) {
+                return false;
+            }
+            findPos3 = file.find_first_not_of(g_whiteSpace, findPos2 + 1);
+            if (findPos3 == string::npos) {
+                return false;
+            }
+            // If this is a definition (i.e. '{') then that means no declaration could be found (headers are
+            // searched before code files)
+            isDefinition = (file.at(findPos3) == '{');
+            if ((file.at(findPos3) == ';') || isDefinition) {
+                findPos3 = file.find_last_not_of(g_whiteSpace, findPos - 1);
+                if (findPos3 == string::npos) {
+                    return false;
                 }
-                findPos3 = file.find_first_not_of(g_whiteSpace, findPos2 + 1);
-                // If this is a definition (i.e. '{') then that means no declaration could be found (headers are
-                // searched before code files)
-                const bool definition = (file.at(findPos3) == '{');
-                bool valid = false;
-                if ((file.at(findPos3) == ';') || definition) {
-                    findPos3 = file.find_last_not_of(g_whiteSpace, findPos - 1);
-                    if (g_nonName.find(file.at(findPos3)) == string::npos) {
+                if (g_nonName.find(file.at(findPos3)) == string::npos) {
+                    // Get the return type
+                    findPos = file.find_last_of(g_whiteSpace, findPos3 - 1);
+                    findPos = (findPos == string::npos) ? 0 : findPos + 1;
+                    // Return the declaration
+                    retDeclaration = file.substr(findPos, findPos2 - findPos + 1);
+                    isFunction = true;
+                    return true;
+                }
+                if ((file.at(findPos3) == '*') && (findPos3 > 1)) {
+                    // Return potentially contains a pointer
+                    --findPos3;
+                    findPos3 = file.find_last_not_of(g_whiteSpace, findPos3 - 1);
+                    if ((findPos3 != string::npos) && (g_nonName.find(file.at(findPos3)) == string::npos)) {
                         // Get the return type
                         findPos = file.find_last_of(g_whiteSpace, findPos3 - 1);
                         findPos = (findPos == string::npos) ? 0 : findPos + 1;
                         // Return the declaration
                         retDeclaration = file.substr(findPos, findPos2 - findPos + 1);
                         isFunction = true;
-                        valid = true;
-                    }
-                    if (!valid && file.at(findPos3) == '*') {
-                        // Return potentially contains a pointer
-                        --findPos3;
-                        findPos3 = file.find_last_not_of(g_whiteSpace, findPos3 - 1);
-                        if (g_nonName.find(file.at(findPos3)) == string::npos) {
-                            // Get the return type
-                            findPos = file.find_last_of(g_whiteSpace, findPos3 - 1);
-                            findPos = (findPos == string::npos) ? 0 : findPos + 1;
-                            // Return the declaration
-                            retDeclaration = file.substr(findPos, findPos2 - findPos + 1);
-                            isFunction = true;
-                            valid = true;
-                        }
-                    }
-                    if (valid) {
-                        if (definition) {
-                            outputWarning(
-                                "Using DCE definition for (" + function + ") this may cause errors during generation");
-                        }
                         return true;
                     }
                 }
             }
-        } else if (file.at(findPos4) == '[') {
-            // This is an array/table
-            // Check if this is an definition or an declaration
-            uint findPos2 = file.find(']', findPos4 + 1);
-            if (findPos2 != string::npos) {
-                // Skip multidimensional array
-                while ((findPos2 + 1 < file.length()) && (file.at(findPos2 + 1) == '[')) {
-                    findPos2 = file.find(']', findPos2 + 1);
+        }
+    } else if (file.at(findPos4) == '[') {
+        // This is an array/table
+        // Check if this is an definition or an declaration
+        size_t findPos2 = file.find(']', findPos4 + 1);
+        if (findPos2 != string::npos) {
+            // Skip multidimensional array
+            while ((findPos2 + 1 < file.length()) && (file.at(findPos2 + 1) == '[')) {
+                findPos2 = file.find(']', findPos2 + 1);
+            }
+            if (findPos2 == string::npos) {
+                return false;
+            }
+            size_t findPos3 = file.find_first_not_of(g_whiteSpace, findPos2 + 1);
+            if (findPos3 == string::npos) {
+                return false;
+            }
+            isDefinition = (file.at(findPos3) == '=');
+            if ((file.at(findPos3) == ';') || isDefinition) {
+                findPos3 = file.find_last_not_of(g_whiteSpace, findPos - 1);
+                if (findPos3 == string::npos) {
+                    return false;
+                }
+                if (g_nonName.find(file.at(findPos3)) == string::npos) {
+                    // Get the array type
+                    findPos = file.find_last_of(g_whiteSpace, findPos3 - 1);
+                    findPos = (findPos == string::npos) ? 0 : findPos + 1;
+                    // Return the definition
+                    retDeclaration = file.substr(findPos, findPos2 - findPos + 1);
+                    isFunction = false;
+                    return true;
                 }
-                uint findPos3 = file.find_first_not_of(g_whiteSpace, findPos2 + 1);
-                const bool definition = (file.at(findPos3) == '=');
-                bool valid = false;
-                if ((file.at(findPos3) == ';') || definition) {
-                    findPos3 = file.find_last_not_of(g_whiteSpace, findPos - 1);
-                    if (g_nonName.find(file.at(findPos3)) == string::npos) {
+                if ((file.at(findPos3) == '*') && (findPos3 > 1)) {
+                    // Type potentially contains a pointer
+                    --findPos3;
+                    findPos3 = file.find_last_not_of(g_whiteSpace, findPos3 - 1);
+                    if ((findPos3 != string::npos) && (g_nonName.find(file.at(findPos3)) == string::npos)) {
                         // Get the array type
                         findPos = file.find_last_of(g_whiteSpace, findPos3 - 1);
                         findPos = (findPos == string::npos) ? 0 : findPos + 1;
                         // Return the definition
                         retDeclaration = file.substr(findPos, findPos2 - findPos + 1);
                         isFunction = false;
-                        valid = true;
-                    }
-                    if (!valid && file.at(findPos3) == '*') {
-                        // Type potentially contains a pointer
-                        --findPos3;
-                        findPos3 = file.find_last_not_of(g_whiteSpace, findPos3 - 1);
-                        if (g_nonName.find(file.at(findPos3)) == string::npos) {
-                            // Get the array type
-                            findPos = file.find_last_of(g_whiteSpace, findPos3 - 1);
-                            findPos = (findPos == string::npos) ? 0 : findPos + 1;
-                            // Return the definition
-                            retDeclaration = file.substr(findPos, findPos2 - findPos + 1);
-                            isFunction = false;
-                            valid = true;
-                        }
-                    }
-                    if (valid) {
-                        if (definition) {
-                            outputWarning(
-                                "Using DCE definition for (" + function + ") this may cause errors during generation");
-                        }
                         return true;
                     }
                 }
             }
         }
-
-        // Search for next occurrence
-        findPos = file.find(function, findPos + function.length() + 1);
     }
     return false;
 }
 
+void ProjectGenerator::outputProjectDCEIndexDeclarations(
+    const string_view file, const string& fileName, DCEDeclarations& declarations)
+{
+    size_t pos = 0;
+    while (pos < file.length()) {
+        // Find the next identifier
+        if ((isalnum(static_cast<unsigned char>(file[pos])) == 0) && (file[pos] != '_')) {
+            ++pos;
+            continue;
+        }
+        const size_t start = pos;
+        while ((pos < file.length()) && ((isalnum(static_cast<unsigned char>(file[pos])) != 0) || (file[pos] == '_'))) {
+            ++pos;
+        }
+        if (isdigit(static_cast<unsigned char>(file[start])) != 0) {
+            continue;
+        }
+        // Only an identifier followed by a parameter list or an array size can be a declaration
+        const size_t next = file.find_first_not_of(g_whiteSpace, pos);
+        if ((next == string::npos) || ((file[next] != '(') && (file[next] != '['))) {
+            continue;
+        }
+        // Any existing declaration takes precedence over one found later
+        string name(file.substr(start, pos - start));
+        if (declarations.find(name) != declarations.end()) {
+            continue;
+        }
+        DCEDeclaration declaration;
+        if (outputProjectDCEsCheckDeclaration(file, start, pos - start, declaration.declaration,
+                declaration.isFunction, declaration.isDefinition)) {
+            // Declarations spanning multiple lines are output so any "\r\n" line endings must be removed
+            auto& text = declaration.declaration;
+            text.erase(remove(text.begin(), text.end(), '\r'), text.end());
+            declaration.file = fileName;
+            declarations.emplace(std::move(name), std::move(declaration));
+        }
+    }
+}
+
+bool ProjectGenerator::loadDCEDeclarations(
+    const string& file, const string& fileName, shared_ptr<const DCEDeclarations>& declarations)
+{
+    // Source files are shared between each project and variant so they only need to be indexed once
+    static map<string, pair<uint64_t, shared_ptr<const DCEDeclarations>>> s_declarations;
+    static mutex s_declarationsMutex;
+    MappedFile mapping;
+    if (!mapping.open(file)) {
+        return false;
+    }
+    const uint64_t hash = hashString(mapping.view());
+    {
+        lock_guard<mutex> lock(s_declarationsMutex);
+        const auto found = s_declarations.find(file);
+        if ((found != s_declarations.end()) && (found->second.first == hash)) {
+            declarations = found->second.second;
+            return true;
+        }
+    }
+    auto newDeclarations = make_shared<DCEDeclarations>();
+    outputProjectDCEIndexDeclarations(mapping.view(), fileName, *newDeclarations);
+    declarations = newDeclarations;
+    lock_guard<mutex> lock(s_declarationsMutex);
+    s_declarations[file] = {hash, declarations};
+    return true;
+}
+
+bool ProjectGenerator::outputProjectDCEsFindDeclaration(const DCEDeclarations& declarations, const string& function,
+    string& retDeclaration, bool& isFunction, string& retFile)
+{
+    const auto found = declarations.find(function);
+    if (found == declarations.end()) {
+        return false;
+    }
+    if (found->second.isDefinition) {
+        outputWarning("Using DCE definition for (" + function + ") this may cause errors during generation");
+    }
+    retDeclaration = found->second.declaration;
+    isFunction = found->second.isFunction;
+    retFile = found->second.file;
+    return true;
+}
+
 void ProjectGenerator::outputProjectDCECleanDefine(string& define)
 {
     const string tagReplace[] = {"EXTERNAL", "INTERNAL", "INLINE"};
@@ -1281,29 +1744,29 @@ void ProjectGenerator::outputProjectDCECleanDefine(string& define)
     // There are some macro tags that require conversion
     for (const auto& i : tagReplace) {
         string sSearch = i + '_';
-        uint findPos = 0;
+        size_t findPos = 0;
         while ((findPos = define.find(sSearch, findPos)) != string::npos) {
-            const uint findPos4 = define.find_first_of('(', findPos + 1);
-            const uint findPosBack = findPos;
+            const size_t findPos4 = define.find_first_of('(', findPos + 1);
+            const size_t findPosBack = findPos;
             findPos += sSearch.length();
             string tagPart = define.substr(findPos, findPos4 - findPos);
             // Remove conversion values
             for (const auto& j : tagReplaceRemove) {
-                uint uiFindRem = 0;
+                size_t uiFindRem = 0;
                 while ((uiFindRem = tagPart.find(j, uiFindRem)) != string::npos) {
                     tagPart.erase(uiFindRem, j.length());
                 }
             }
             tagPart = "HAVE_" + tagPart + '_' + i;
-            uint findPos6 = define.find_first_of(')', findPos4 + 1);
+            size_t findPos6 = define.find_first_of(')', findPos4 + 1);
             // Skip any '(' found within the parameters itself
-            uint findPos5 = define.find('(', findPos4 + 1);
+            size_t findPos5 = define.find('(', findPos4 + 1);
             while ((findPos5 != string::npos) && (findPos5 < findPos6)) {
                 findPos5 = define.find('(', findPos5 + 1);
                 findPos6 = define.find(')', findPos6 + 1);
             }
             // Update tag with replacement
-            const uint repLength = findPos6 - findPosBack + 1;
+            const size_t repLength = findPos6 - findPosBack + 1;
             define.replace(findPosBack, repLength, tagPart);
             findPos = findPosBack + tagPart.length();
         }
@@ -1311,7 +1774,7 @@ void ProjectGenerator::outputProjectDCECleanDefine(string& define)
 
     // Check if the tag contains multiple conditionals
     removeWhiteSpace(define);
-    uint startTag = define.find_first_not_of(g_preProcessor);
+    size_t startTag = define.find_first_not_of(g_preProcessor);
     while (startTag != string::npos) {
         // Check if each conditional is valid
         bool valid = false;
@@ -1324,12 +1787,12 @@ void ProjectGenerator::outputProjectDCECleanDefine(string& define)
         }
         if (!valid) {
             // Get right tag
-            uint rightPos = define.find_first_of(g_preProcessor, startTag);
+            size_t rightPos = define.find_first_of(g_preProcessor, startTag);
             // Skip any '(' found within the function parameters itself
             if ((rightPos != string::npos) && (define.at(rightPos) == '(')) {
-                const uint back = rightPos + 1;
+                const size_t back = rightPos + 1;
                 rightPos = define.find(')', back) + 1;
-                uint findPos3 = define.find('(', back);
+                size_t findPos3 = define.find('(', back);
                 while ((findPos3 != string::npos) && (findPos3 < rightPos)) {
                     findPos3 = define.find('(', findPos3 + 1);
                     rightPos = define.find(')', rightPos + 1) + 1;
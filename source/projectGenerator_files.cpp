@@ -27,18 +27,18 @@ bool ProjectGenerator::findSourceFile(const string& file, const string& extensio
 {
     string fileName;
     retFileName = m_projectDir + file + extension;
-    if (!findFile(retFileName, fileName)) {
+    if (!findIndexedFile(retFileName, fileName)) {
         // Check if this is a built file
-        uint pos = m_projectDir.rfind('/', m_projectDir.length() - 2);
+        size_t pos = m_projectDir.rfind('/', m_projectDir.length() - 2);
         pos = (pos == string::npos) ? 0 : pos + 1;
         string projectName = m_projectDir.substr(pos);
         projectName = (m_projectDir != "./") ? projectName : "";
         retFileName = m_configHelper.m_solutionDirectory + projectName + file + extension;
-        if (!findFile(retFileName, fileName)) {
+        if (!findIndexedFile(retFileName, fileName)) {
             // Check if this file already includes the project folder in its name
             if (file.find(projectName) != string::npos) {
                 retFileName = m_projectDir + file.substr(file.find(projectName) + projectName.length()) + extension;
-                return findFile(retFileName, fileName);
+                return findIndexedFile(retFileName, fileName);
             }
             return false;
         }
@@ -49,54 +49,66 @@ bool ProjectGenerator::findSourceFile(const string& file, const string& extensio
 bool ProjectGenerator::findSourceFiles(const string& file, const string& extension, vector<string>& retFiles) const
 {
     const string fileName = m_projectDir + file + extension;
-    return findFiles(fileName, retFiles);
+    return findIndexedFiles(fileName, retFiles);
 }
 
 bool ProjectGenerator::checkProjectFiles()
 {
     // Check that all headers are correct
-    for (auto& include : m_includesH) {
+    UniqueList includesH;
+    for (const auto& include : m_includesH) {
         string retFileName;
         if (!findSourceFile(include, ".h", retFileName)) {
             outputError("Could not find input header file for object (" + include + ")");
             return false;
         }
         // Update the entry with the found file with complete path
-        m_configHelper.makeFileProjectRelative(retFileName, include);
+        m_configHelper.makeFileProjectRelative(retFileName, retFileName);
+        includesH.push_back(retFileName);
     }
+    m_includesH = std::move(includesH);
 
     // Check that all C Source are correct
-    for (auto& include : m_includesC) {
+    UniqueList includesC;
+    for (const auto& include : m_includesC) {
         string retFileName;
         if (!findSourceFile(include, ".c", retFileName)) {
             outputError("Could not find input C source file for object (" + include + ")");
             return false;
         }
         // Update the entry with the found file with complete path
-        m_configHelper.makeFileProjectRelative(retFileName, include);
+        m_configHelper.makeFileProjectRelative(retFileName, retFileName);
+        includesC.push_back(retFileName);
     }
+    m_includesC = std::move(includesC);
 
     // Check that all CPP Source are correct
-    for (auto& include : m_includesCPP) {
+    UniqueList includesCPP;
+    for (const auto& include : m_includesCPP) {
         string retFileName;
         if (!findSourceFile(include, ".cpp", retFileName)) {
             outputError("Could not find input C++ source file for object (" + include + ")");
             return false;
         }
         // Update the entry with the found file with complete path
-        m_configHelper.makeFileProjectRelative(retFileName, include);
+        m_configHelper.makeFileProjectRelative(retFileName, retFileName);
+        includesCPP.push_back(retFileName);
     }
+    m_includesCPP = std::move(includesCPP);
 
     // Check that all ASM Source are correct
-    for (auto& include : m_includesASM) {
+    UniqueList includesASM;
+    for (const auto& include : m_includesASM) {
         string retFileName;
         if (!findSourceFile(include, ".asm", retFileName)) {
             outputError("Could not find input ASM source file for object (" + include + ")");
             return false;
         }
         // Update the entry with the found file with complete path
-        m_configHelper.makeFileProjectRelative(retFileName, include);
+        m_configHelper.makeFileProjectRelative(retFileName, retFileName);
+        includesASM.push_back(retFileName);
     }
+    m_includesASM = std::move(includesASM);
 
     // Check the output Unknown Includes and find there corresponding file
     if (!findProjectFiles(m_includes, m_includesC, m_includesCPP, m_includesASM, m_includesH, m_includesRC,
@@ -110,97 +122,90 @@ bool ProjectGenerator::checkProjectFiles()
     }
 
     // Check all source files associated with replaced config values
-    StaticList replaceIncludes, replaceCPPIncludes, replaceCIncludes, replaceASMIncludes, replaceCUIncludes,
+    UniqueList replaceIncludes, replaceCPPIncludes, replaceCIncludes, replaceASMIncludes, replaceCUIncludes,
         replaceCLIncludes, replaceCOMPIncludes;
-    for (auto& include : m_replaceIncludes) {
+    ReplaceStems replaceStems;
+    for (const auto& include : m_replaceIncludes) {
         replaceIncludes.push_back(include.first);
+        // Index by the file name without path or any additional extensions (e.g. .ptx)
+        const size_t stemPos = include.first.rfind('/') + 1;
+        replaceStems[include.first.substr(stemPos, include.first.find('.', stemPos) - stemPos)].push_back(
+            include.first);
     }
     if (!findProjectFiles(replaceIncludes, replaceCIncludes, replaceCPPIncludes, replaceASMIncludes, m_includesH,
             m_includesRC, replaceCUIncludes, replaceCLIncludes, replaceCOMPIncludes)) {
         return false;
     }
     // Need to create local files for any replace objects
-    if (!createReplaceFiles(replaceCIncludes, m_includesC, m_includesConditionalC)) {
+    if (!createReplaceFiles(replaceCIncludes, replaceStems, m_includesC, m_includesConditionalC)) {
         return false;
     }
-    if (!createReplaceFiles(replaceCPPIncludes, m_includesCPP, m_includesConditionalCPP)) {
+    if (!createReplaceFiles(replaceCPPIncludes, replaceStems, m_includesCPP, m_includesConditionalCPP)) {
         return false;
     }
-    if (!createReplaceFiles(replaceASMIncludes, m_includesASM, m_includesConditionalASM)) {
+    if (!createReplaceFiles(replaceASMIncludes, replaceStems, m_includesASM, m_includesConditionalASM)) {
         return false;
     }
-    if (!createReplaceFiles(replaceCUIncludes, m_includesCU, m_includesConditionalCU)) {
+    if (!createReplaceFiles(replaceCUIncludes, replaceStems, m_includesCU, m_includesConditionalCU)) {
         return false;
     }
-    if (!createReplaceFiles(replaceCLIncludes, m_includesCL, m_includesConditionalCL)) {
+    if (!createReplaceFiles(replaceCLIncludes, replaceStems, m_includesCL, m_includesConditionalCL)) {
         return false;
     }
-    if (!createReplaceFiles(replaceCOMPIncludes, m_includesCOMP, m_includesConditionalCOMP)) {
+    if (!createReplaceFiles(replaceCOMPIncludes, replaceStems, m_includesCOMP, m_includesConditionalCOMP)) {
         return false;
     }
     return true;
 }
 
-bool ProjectGenerator::createReplaceFiles(
-    const StaticList& replaceIncludes, StaticList& existingIncludes, ConditionalList& conditionalIncludes)
+bool ProjectGenerator::createReplaceFiles(const UniqueList& replaceIncludes, const ReplaceStems& replaceStems,
+    UniqueList& existingIncludes, ConditionalList& conditionalIncludes)
 {
     for (const auto& replaceInclude : replaceIncludes) {
         // Check hasn't already been included as a fixed object
-        if (find(existingIncludes.begin(), existingIncludes.end(), replaceInclude) != existingIncludes.end()) {
+        if (existingIncludes.contains(replaceInclude)) {
             // skip this item
             continue;
         }
         // Convert file to format required to search ReplaceIncludes
-        const uint extPos = replaceInclude.rfind('.');
-        const uint cutPos = replaceInclude.rfind('/') + 1;
+        const size_t extPos = replaceInclude.rfind('.');
+        const size_t cutPos = replaceInclude.rfind('/') + 1;
         string filename = replaceInclude.substr(cutPos, extPos - cutPos);
         string extension = replaceInclude.substr(extPos);
         string outFile = m_configHelper.m_solutionDirectory + m_projectName + "/" + filename + "_wrap" + extension;
         string newOutFile;
         m_configHelper.makeFileProjectRelative(outFile, newOutFile);
         // Check hasn't already been included as a wrapped object
-        if (find(existingIncludes.begin(), existingIncludes.end(), newOutFile) != existingIncludes.end()) {
+        if (existingIncludes.contains(newOutFile)) {
             // skip this item
             outputInfo(newOutFile);
             continue;
         }
         // Find the file in the original list
-        string origName;
-        for (auto& include : m_replaceIncludes) {
-            if (include.first.find(filename) != string::npos) {
-                origName = include.first;
-                break;
-            }
-        }
-        if (origName.length() == 0) {
+        const auto stem = replaceStems.find(filename);
+        if (stem == replaceStems.end()) {
             outputError("Could not find original file name for source file (" + filename + ")");
             return false;
         }
-        // Get the files dynamic config requirement
-        string idents;
-        bool isStatic = false;
-        bool isShared = false;
-        bool is32 = false;
-        bool is64 = false;
-        bool hasOther = false;
-        for (auto include = m_replaceIncludes[origName].begin(); include < m_replaceIncludes[origName].end();
-             ++include) {
-            idents += *include;
-            if ((include + 1) < m_replaceIncludes[origName].end()) {
-                idents += " || ";
-            }
-            if (*include == "ARCH_X86_32" || *include == "!ARCH_X86_64") {
-                is32 = true;
-            } else if (*include == "ARCH_X86_64" || *include == "!ARCH_X86_32") {
-                is64 = true;
-            } else if (*include == "CONFIG_SHARED" || *include == "!CONFIG_STATIC") {
-                isShared = true;
-            } else if (*include == "CONFIG_STATIC" || *include == "!CONFIG_SHARED") {
-                isStatic = true;
-            } else {
-                hasOther = true;
+        // Objects in different sub-directories may share the same stem so prefer the one matching the files path
+        const string* origName = &stem->second.front();
+        const string path = '/' + replaceInclude.substr(0, extPos);
+        for (const auto& i : stem->second) {
+            const string suffix = '/' + i.substr(0, i.find('.', i.rfind('/') + 1));
+            if ((path.length() >= suffix.length()) &&
+                (path.compare(path.length() - suffix.length(), suffix.length(), suffix) == 0)) {
+                origName = &i;
+                break;
             }
         }
+        // Get the files dynamic config requirement
+        const ReplaceConds& conditions = m_replaceIncludes.find(*origName)->second;
+        const string& idents = conditions.idents();
+        const bool isStatic = conditions.isStatic();
+        const bool isShared = conditions.isShared();
+        const bool is32 = conditions.is32();
+        const bool is64 = conditions.is64();
+        const bool hasOther = conditions.hasOther();
         // Check if already a conditional file
         auto j = conditionalIncludes.find(replaceInclude);
         if (j != conditionalIncludes.end()) {
@@ -256,51 +261,31 @@ bool ProjectGenerator::createReplaceFiles(
     return true;
 }
 
-bool ProjectGenerator::findProjectFiles(const StaticList& includes, StaticList& includesC, StaticList& includesCPP,
-    StaticList& includesASM, StaticList& includesH, StaticList& includesRC, StaticList& includesCU,
-    StaticList& includesCL, StaticList& includesCOMP) const
+bool ProjectGenerator::findProjectFiles(const UniqueList& includes, UniqueList& includesC, UniqueList& includesCPP,
+    UniqueList& includesASM, UniqueList& includesH, UniqueList& includesRC, UniqueList& includesCU,
+    UniqueList& includesCL, UniqueList& includesCOMP) const
 {
     for (const auto& include : includes) {
         string retFileName;
         if (findSourceFile(include, ".c", retFileName)) {
             // Found a C file to include
             m_configHelper.makeFileProjectRelative(retFileName, retFileName);
-            if (find(includesC.begin(), includesC.end(), retFileName) != includesC.end()) {
-                // skip this item
-                continue;
-            }
             includesC.push_back(retFileName);
         } else if (findSourceFile(include, ".cpp", retFileName)) {
             // Found a C++ file to include
             m_configHelper.makeFileProjectRelative(retFileName, retFileName);
-            if (find(includesCPP.begin(), includesCPP.end(), retFileName) != includesCPP.end()) {
-                // skip this item
-                continue;
-            }
             includesCPP.push_back(retFileName);
         } else if (findSourceFile(include, ".asm", retFileName)) {
             // Found a ASM file to include
             m_configHelper.makeFileProjectRelative(retFileName, retFileName);
-            if (find(includesASM.begin(), includesASM.end(), retFileName) != includesASM.end()) {
-                // skip this item
-                continue;
-            }
             includesASM.push_back(retFileName);
         } else if (findSourceFile(include, ".h", retFileName)) {
             // Found a H file to include
             m_configHelper.makeFileProjectRelative(retFileName, retFileName);
-            if (find(includesH.begin(), includesH.end(), retFileName) != includesH.end()) {
-                // skip this item
-                continue;
-            }
             includesH.push_back(retFileName);
         } else if (findSourceFile(include, ".rc", retFileName)) {
             // Found a resource file to include
             m_configHelper.makeFileProjectRelative(retFileName, retFileName);
-            if (find(includesRC.begin(), includesRC.end(), retFileName) != includesRC.end()) {
-                // skip this item
-                continue;
-            }
             includesRC.push_back(retFileName);
         } else if (include.find(".ptx") != string::npos) {
             // Found a CUDA file
@@ -308,27 +293,15 @@ bool ProjectGenerator::findProjectFiles(const StaticList& includes, StaticList&
             if (findSourceFile(fileName, ".cu", retFileName)) {
                 // Found a H File to include
                 m_configHelper.makeFileProjectRelative(retFileName, retFileName);
-                if (find(includesCU.begin(), includesCU.end(), retFileName) != includesCU.end()) {
-                    // skip this item
-                    continue;
-                }
                 includesCU.push_back(retFileName);
             }
         } else if (findSourceFile(include, ".cl", retFileName)) {
             // Found a opencl shader file to include
             m_configHelper.makeFileProjectRelative(retFileName, retFileName);
-            if (find(includesCL.begin(), includesCL.end(), retFileName) != includesCL.end()) {
-                // skip this item
-                continue;
-            }
             includesCL.push_back(retFileName);
         } else if (findSourceFile(include, ".comp", retFileName)) {
             // Found a compute shader file to include
             m_configHelper.makeFileProjectRelative(retFileName, retFileName);
-            if (find(includesCOMP.begin(), includesCOMP.end(), retFileName) != includesCOMP.end()) {
-                // skip this item
-                continue;
-            }
             includesCOMP.push_back(retFileName);
         } else {
             outputError("Could not find valid source file for object (" + include + ")");
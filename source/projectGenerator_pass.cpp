@@ -20,34 +20,244 @@
 #include "projectGenerator.h"
 
 #include <algorithm>
+#include <mutex>
 #include <utility>
 
-bool ProjectGenerator::passStaticIncludeObject(uint& startPos, uint& endPos, StaticList& staticIncludes)
+bool ProjectGenerator::loadMakeFile(const string& fileName, shared_ptr<const MakeFile>& makeFile)
 {
-    startPos = m_inLine.find_first_not_of(".\\/", startPos); // Skip any ./ or ../
+    // Makefiles are shared between each project and variant so they only need to be passed once
+    static map<string, shared_ptr<const MakeFile>> s_makeFiles;
+    static mutex s_makeFilesMutex;
+    lock_guard<mutex> lock(s_makeFilesMutex);
+    const auto found = s_makeFiles.find(fileName);
+    if (found != s_makeFiles.end()) {
+        makeFile = found->second;
+        return true;
+    }
+    MappedFile mapping;
+    if (!mapping.open(fileName, false)) {
+        return false;
+    }
+    auto newMakeFile = make_shared<MakeFile>();
+    passMakeFile(mapping.view(), *newMakeFile);
+    s_makeFiles.emplace(fileName, newMakeFile);
+    makeFile = newMakeFile;
+    return true;
+}
+
+void ProjectGenerator::passMakeFile(const string_view contents, MakeFile& makeFile)
+{
+    makeFile.resize(0);
+    string line; // Only used to join continuation lines
+    bool continued = false;
+    MakeStatement statement;
+    size_t start = 0;
+    while (start < contents.length()) {
+        size_t end = contents.find('\n', start);
+        end = (end == string::npos) ? contents.length() : end;
+        string_view physical = contents.substr(start, end - start);
+        start = end + 1;
+        if (!physical.empty() && (physical.back() == '\r')) {
+            physical.remove_suffix(1);
+        }
+        if (continued) {
+            // The newline and any leading white space are replaced with a single space
+            const size_t first = physical.find_first_not_of(" \t");
+            physical.remove_prefix((first == string::npos) ? physical.length() : first);
+            line += ' ';
+        } else if (physical.empty() || (physical.back() != '\\')) {
+            // Single lines can be passed directly
+            if (passMakeLine(physical, statement)) {
+                makeFile.push_back(std::move(statement));
+            }
+            continue;
+        }
+        line.append(physical.data(), physical.length());
+        continued = (line.back() == '\\');
+        if (continued) {
+            line.pop_back();
+            continue;
+        }
+        if (passMakeLine(line, statement)) {
+            makeFile.push_back(std::move(statement));
+        }
+        line.clear();
+    }
+    if (continued && passMakeLine(line, statement)) {
+        makeFile.push_back(std::move(statement));
+    }
+}
+
+bool ProjectGenerator::passMakeLine(string_view line, MakeStatement& statement)
+{
+    statement.name.clear();
+    statement.ident.clear();
+    statement.values.clear();
+    if (line.find_first_not_of(g_whiteSpace) == string::npos) {
+        return false;
+    }
+    if ((line[0] == ' ') || (line[0] == '\t')) {
+        // Indented lines are recipes and are kept as is
+        statement.type = MakeStatement::MAKE_OTHER;
+        statement.name = line;
+        return true;
+    }
+
+    // Remove any comments
+    size_t comment = line.find('#');
+    while ((comment != string::npos) && (comment > 0) && (line[comment - 1] == '\\')) {
+        comment = line.find('#', comment + 1);
+    }
+    const size_t last = line.find_last_not_of(" \t", comment - 1);
+    if ((comment == 0) || (last == string::npos)) {
+        return false;
+    }
+    line = line.substr(0, last + 1);
+
+    // Check for any directives
+    const size_t keyEnd = line.find_first_of(" \t(");
+    const string_view key = line.substr(0, keyEnd);
+    const size_t argsStart = (keyEnd == string::npos) ? line.length() : line.find_first_not_of(" \t", keyEnd);
+    const string_view args = line.substr(argsStart);
+    const string_view firstArg = args.substr(0, args.find_first_of(" \t"));
+    if (key == "ifdef") {
+        statement.type = MakeStatement::MAKE_IFDEF;
+        statement.name = firstArg;
+        return true;
+    }
+    if (key == "ifndef") {
+        statement.type = MakeStatement::MAKE_IFNDEF;
+        statement.name = firstArg;
+        return true;
+    }
+    if ((key == "ifeq") || (key == "ifneq")) {
+        statement.type = MakeStatement::MAKE_IFEQ;
+        statement.name = args;
+        return true;
+    }
+    if (key == "else") {
+        statement.type = MakeStatement::MAKE_ELSE;
+        statement.name = args;
+        return true;
+    }
+    if (key == "endif") {
+        statement.type = MakeStatement::MAKE_ENDIF;
+        return true;
+    }
+    if ((key == "include") || (key == "-include")) {
+        statement.type = MakeStatement::MAKE_INCLUDE;
+        statement.name = firstArg;
+        return true;
+    }
+
+    // Check for an assignment outside of any variable references
+    size_t depth = 0;
+    for (size_t i = 0; i < line.length(); ++i) {
+        const char c = line[i];
+        if ((c == '$') && (i + 1 < line.length()) && ((line[i + 1] == '(') || (line[i + 1] == '{'))) {
+            ++depth;
+            ++i;
+        } else if ((c == '(') || (c == '{')) {
+            depth += (depth > 0) ? 1 : 0;
+        } else if ((c == ')') || (c == '}')) {
+            depth -= (depth > 0) ? 1 : 0;
+        } else if (depth > 0) {
+            continue;
+        } else if (c == '=') {
+            // Include any operator prefix (i.e. +=, :=, ::=, ?=, !=)
+            size_t opStart = i;
+            if ((i > 0) && (string("+:?!").find(line[i - 1]) != string::npos)) {
+                --opStart;
+                if ((line[opStart] == ':') && (opStart > 0) && (line[opStart - 1] == ':')) {
+                    --opStart;
+                }
+            }
+            const size_t nameEnd = line.find_last_not_of(" \t", opStart - 1);
+            statement.type = MakeStatement::MAKE_ASSIGNMENT;
+            statement.name = line.substr(0, (nameEnd == string::npos) ? 0 : nameEnd + 1);
+            statement.ident = getMakeIdent(statement.name);
+            // Split the value into each of its words
+            size_t wordStart = line.find_first_not_of(" \t", i + 1);
+            while (wordStart != string::npos) {
+                const size_t wordEnd = line.find_first_of(" \t", wordStart);
+                statement.values.emplace_back(line.substr(wordStart, wordEnd - wordStart));
+                wordStart = line.find_first_not_of(" \t", wordEnd);
+            }
+            return true;
+        } else if ((c == ':') && (line.find(":=", i) != i) && (line.find("::=", i) != i)) {
+            // This is a rule
+            break;
+        }
+    }
+    statement.type = MakeStatement::MAKE_OTHER;
+    statement.name = line;
+    return true;
+}
+
+string ProjectGenerator::getMakeIdent(const string& name)
+{
+    const size_t start = name.find("$(");
+    if (start == string::npos) {
+        return string();
+    }
+    const size_t end = name.find(')', start + 2);
+    return name.substr(start + 2, end - start - 2);
+}
+
+const ProjectGenerator::MakeCondition& ProjectGenerator::getMakeCondition(const string& ident)
+{
+    const auto found = m_makeConditions.find(ident);
+    if (found != m_makeConditions.end()) {
+        return found->second;
+    }
+    MakeCondition condition;
+    string option = ident;
+    if (!option.empty() && (option.at(0) == '!')) {
+        option = option.substr(1);
+        condition.negate = true;
+    }
+    const auto configOption = m_configHelper.getConfigOptionPrefixed(option);
+    if (configOption != m_configHelper.m_configValues.end()) {
+        condition.id = configOption - m_configHelper.m_configValues.begin();
+        condition.replace = (m_configHelper.m_replaceList.find(option) != m_configHelper.m_replaceList.end());
+    }
+    return m_makeConditions.emplace(ident, condition).first->second;
+}
+
+bool ProjectGenerator::isMakeConditionMet(const MakeCondition& condition) const
+{
+    if (condition.id == string::npos) {
+        return false;
+    }
+    return (condition.negate) ? m_configHelper.isConfigIDDisabled(condition.id) :
+                                m_configHelper.isConfigIDEnabled(condition.id);
+}
+
+bool ProjectGenerator::passStaticIncludeObject(const string& object, UniqueList& staticIncludes)
+{
+    size_t startPos = object.find_first_not_of(".\\/"); // Skip any ./ or ../
     if (startPos == string::npos) {
-        endPos = startPos;
-        return true; // skip this line as its empty
+        return true; // skip this object as its empty
     }
     // Add the found string to internal storage
-    endPos = m_inLine.find_first_of(". \t", startPos);
-    if ((endPos != string::npos) && (m_inLine.at(endPos) == '.')) {
+    size_t endPos = object.find('.', startPos);
+    if (endPos != string::npos) {
         // Skip any ./ or ../
-        const uint endPos2 = m_inLine.find_first_not_of(".\\/", endPos + 1);
+        const size_t endPos2 = object.find_first_not_of(".\\/", endPos + 1);
         if ((endPos2 != string::npos) && (endPos2 > endPos + 1)) {
-            endPos = m_inLine.find_first_of(". \t", endPos2 + 1);
+            endPos = object.find('.', endPos2 + 1);
         }
     }
-    string tag = m_inLine.substr(startPos, endPos - startPos);
+    string tag = object.substr(startPos, endPos - startPos);
     if (tag.find('$') != string::npos) {
         // Invalid include. Occurs when include is actually a variable
         startPos += 2;
-        tag = m_inLine.substr(startPos, m_inLine.find(')', startPos) - startPos);
+        tag = object.substr(startPos, object.find(')', startPos) - startPos);
         // Check if additional variable (This happens when a string should be prepended to existing items within tag.)
         string tag2;
         if (tag.find(':') != string::npos) {
             startPos = tag.find(":%=");
-            const uint startPos2 = startPos + 3;
+            const size_t startPos2 = startPos + 3;
             endPos = tag.find('%', startPos2);
             tag2 = tag.substr(startPos2, endPos - startPos2);
             tag = tag.substr(0, startPos);
@@ -64,8 +274,7 @@ bool ProjectGenerator::passStaticIncludeObject(uint& startPos, uint& endPos, Sta
         // Loop through each item and add to list
         for (auto file = files.begin(); file < files.end(); ++file) {
             // Check if object already included in internal list
-            if (find(m_includesC.begin(), m_includesC.end(), *file) == m_includesC.end()) {
-                staticIncludes.push_back(*file);
+            if (!m_includesC.contains(*file) && staticIncludes.push_back(*file)) {
                 outputInfo("Found C Static: '" + *file + "'");
             }
         }
@@ -73,79 +282,47 @@ bool ProjectGenerator::passStaticIncludeObject(uint& startPos, uint& endPos, Sta
     }
 
     // Check if object already included in internal list
-    if (find(staticIncludes.begin(), staticIncludes.end(), tag) == staticIncludes.end()) {
-        staticIncludes.push_back(tag);
+    if (staticIncludes.push_back(tag)) {
         outputInfo("Found Static: '" + tag + "'");
     }
     return true;
 }
 
-bool ProjectGenerator::passStaticIncludeLine(uint startPos, StaticList& staticIncludes)
+bool ProjectGenerator::passStaticInclude(const vector<string>& values, UniqueList& staticIncludes)
 {
-    uint endPos;
-    if (!passStaticIncludeObject(startPos, endPos, staticIncludes)) {
-        return false;
-    }
-    // Check if there are multiple files declared on the same line
-    while (endPos != string::npos) {
-        startPos = m_inLine.find_first_of(" \t\\\n\0", endPos);
-        startPos = m_inLine.find_first_not_of(" \t\\\n\0", startPos);
-        if (startPos == string::npos) {
-            break;
-        }
-        if (!passStaticIncludeObject(startPos, endPos, staticIncludes)) {
+    // Check each of the files declared in the statement
+    for (const auto& i : values) {
+        if (!passStaticIncludeObject(i, staticIncludes)) {
             return false;
         }
     }
     return true;
 }
 
-bool ProjectGenerator::passStaticInclude(const uint length, StaticList& staticIncludes)
-{
-    // Remove the identifier and '='
-    uint startPos = m_inLine.find_first_not_of("+=: \t", length);
-    if (!passStaticIncludeLine(startPos, staticIncludes)) {
-        return true;
-    }
-    // Check if this is a multi line declaration
-    while (m_inLine.back() == '\\') {
-        // Get the next line
-        getline(m_inputFile, m_inLine);
-        // Remove the whitespace
-        startPos = m_inLine.find_first_not_of(" \t");
-        if (startPos == string::npos) {
-            break;
-        }
-        if (!passStaticIncludeLine(startPos, staticIncludes)) {
-            return true;
-        }
-    }
-    return true;
-}
-
-bool ProjectGenerator::passDynamicIncludeObject(uint& startPos, uint& endPos, string& ident, StaticList& includes)
+bool ProjectGenerator::passDynamicIncludeObject(
+    const string& object, const string& ident, const MakeCondition& condition, UniqueList& includes)
 {
     // Check if this is a valid File or a past compile option
-    if (m_inLine.at(startPos) == '$') {
-        endPos = m_inLine.find(')', startPos);
-        const string dynInc = m_inLine.substr(startPos + 2, endPos - startPos - 2);
+    if (object.at(0) == '$') {
+        const size_t endPos = object.find(')');
+        const string dynInc = object.substr(2, endPos - 2);
         // Find it in the unknown list
         const auto objectList = m_unknowns.find(dynInc);
         if (objectList != m_unknowns.end()) {
             // Loop over each internal object
-            for (auto object = objectList->second.begin(); object < objectList->second.end(); ++object) {
+            for (auto object2 = objectList->second.begin(); object2 < objectList->second.end(); ++object2) {
                 // Check if object already included in internal list
-                if (find(includes.begin(), includes.end(), *object) == includes.end()) {
+                if (!includes.contains(*object2)) {
                     // Check if the config option is correct
-                    auto option = m_configHelper.getConfigOptionPrefixed(ident);
-                    if (option == m_configHelper.m_configValues.end()) {
+                    if (condition.id == string::npos) {
                         outputInfo("Unknown dynamic configuration option (" + ident + ") used when passing object (" +
-                            *object + ")");
+                            *object2 + ")");
                         return true;
                     }
-                    if (option->m_value == "1") {
-                        includes.push_back(*object);
-                        outputInfo("Found Dynamic: '" + *object + "', '" + "( " + ident + " && " + dynInc + " )" + "'");
+                    if (isMakeConditionMet(condition)) {
+                        includes.push_back(*object2);
+                        outputInfo(
+                            "Found Dynamic: '" + *object2 + "', '" + "( " + ident + " && " + dynInc + " )" + "'");
                     }
                 }
             }
@@ -153,119 +330,68 @@ bool ProjectGenerator::passDynamicIncludeObject(uint& startPos, uint& endPos, st
             outputError("Found unknown token (" + dynInc + ")");
             return false;
         }
-    } else if (m_inLine.at(startPos) == '#') {
-        // Found a comment, just skip till end of line
-        endPos = m_inLine.length();
-        return true;
     } else {
-        // Check for condition
-        string compare = "1";
-        if (ident.at(0) == '!') {
-            ident = ident.substr(1);
-            compare = "0";
-        }
-        startPos = m_inLine.find_first_not_of(".\\/", startPos); // Skip any ./ or ../
+        const size_t startPos = object.find_first_not_of(".\\/"); // Skip any ./ or ../
         if (startPos == string::npos) {
-            // Multi line statement, well get it on the next line
             return true;
         }
-        endPos = m_inLine.find_first_of(" \t", startPos);
-        endPos = m_inLine.rfind('.', endPos); // Include any additional extensions
+        const size_t endPos = object.rfind('.'); // Include any additional extensions
         // Add the found string to internal storage
-        const string tag = m_inLine.substr(startPos, endPos - startPos);
+        const string tag = object.substr(startPos, endPos - startPos);
         // Check if object already included in internal list
-        if (find(includes.begin(), includes.end(), tag) == includes.end()) {
+        if (!includes.contains(tag)) {
             // Check if the config option is correct
-            const auto option = m_configHelper.getConfigOptionPrefixed(ident);
-            if (option == m_configHelper.m_configValues.end()) {
+            const string option = (condition.negate) ? ident.substr(1) : ident;
+            if (condition.id == string::npos) {
                 outputInfo(
-                    "Unknown dynamic configuration option (" + ident + ") used when passing object (" + tag + ")");
+                    "Unknown dynamic configuration option (" + option + ") used when passing object (" + tag + ")");
                 return true;
             }
-            if (option->m_value == compare ||
-                m_configHelper.m_replaceList.find(ident) != m_configHelper.m_replaceList.end()) {
-                // Check if the config option is for a reserved type
-                if (m_configHelper.m_replaceList.find(ident) != m_configHelper.m_replaceList.end()) {
-                    m_replaceIncludes[tag].push_back(compare == "1" ? ident : "!" + ident);
-                    outputInfo("Found Dynamic Replace: '" + tag + "', '" + ident + "'");
-                } else {
-                    includes.push_back(tag);
-                    outputInfo("Found Dynamic: '" + tag + "', '" + ident + "'");
-                }
+            // Check if the config option is for a reserved type
+            if (condition.replace) {
+                m_replaceIncludes[tag].push_back(ident);
+                outputInfo("Found Dynamic Replace: '" + tag + "', '" + option + "'");
+            } else if (isMakeConditionMet(condition)) {
+                includes.push_back(tag);
+                outputInfo("Found Dynamic: '" + tag + "', '" + option + "'");
             }
         }
     }
     return true;
 }
 
-bool ProjectGenerator::passDynamicIncludeLine(uint startPos, string& ident, StaticList& includes)
+bool ProjectGenerator::passDynamicInclude(const string& ident, const vector<string>& values, UniqueList& includes)
 {
-    uint endPos;
-    if (!passDynamicIncludeObject(startPos, endPos, ident, includes)) {
-        return false;
-    }
-    // Check if there are multiple files declared on the same line
-    while (endPos != string::npos) {
-        startPos = m_inLine.find_first_of(" \t\\\n\0", endPos);
-        startPos = m_inLine.find_first_not_of(" \t\\\n\0", startPos);
-        if (startPos == string::npos) {
-            break;
-        }
-        if (!passDynamicIncludeObject(startPos, endPos, ident, includes)) {
+    // Each of the files declared in the statement share the same condition
+    const MakeCondition& condition = getMakeCondition(ident);
+    for (const auto& i : values) {
+        if (!passDynamicIncludeObject(i, ident, condition, includes)) {
             return false;
         }
     }
     return true;
 }
 
-bool ProjectGenerator::passDynamicInclude(const uint length, StaticList& includes)
+bool ProjectGenerator::passCondition(
+    const string& condition, const vector<string>& values, UniqueList& list, ReplaceList& replace)
 {
-    // Find the dynamic identifier
-    uint startPos = m_inLine.find_first_not_of("$( \t", length);
-    const uint endPos = m_inLine.find(')', startPos);
-    string ident = m_inLine.substr(startPos, endPos - startPos);
-    // Find the included obj
-    startPos = m_inLine.find_first_not_of("+=: \t\\", endPos + 1);
-    if (startPos != string::npos) {
-        if (!passDynamicIncludeLine(startPos, ident, includes)) {
-            return false;
-        }
-    }
-    // Check if this is a multi line declaration
-    while (m_inLine.back() == '\\') {
-        // Get the next line
-        getline(m_inputFile, m_inLine);
-        // Remove the whitespace
-        startPos = m_inLine.find_first_not_of(" \t");
-        if (startPos == string::npos) {
-            break;
-        }
-        if (!passDynamicIncludeLine(startPos, ident, includes)) {
-            return false;
-        }
-    }
-    return true;
-}
-
-bool ProjectGenerator::passCondition(const string& condition, StaticList& list, UnknownList& replace, const uint offset)
-{
-    const auto cond = m_configHelper.getConfigOptionPrefixed(condition);
-    if (cond == m_configHelper.m_configValues.end()) {
+    const MakeCondition& cond = getMakeCondition(condition);
+    if (cond.id == string::npos) {
         outputError("Unknown configuration condition (" + condition + ")");
         return false;
     }
-    if (cond->m_value == "0") {
+    if (m_configHelper.isConfigIDDisabled(cond.id)) {
         return true;
     }
-    StaticList temp;
-    if (passStaticInclude(offset, temp)) {
-        for (auto& i : temp) {
+    UniqueList temp;
+    if (passStaticInclude(values, temp)) {
+        for (const auto& i : temp) {
             // Check if object already included in internal list
-            if (find(list.begin(), list.end(), i) == list.end()) {
+            if (!list.contains(i)) {
                 // Check if already in replace list
-                if (replace.find(i) == replace.end() ||
-                    find(replace[i].begin(), replace[i].end(), condition) == replace[i].end()) {
-                    replace[i].push_back(condition);
+                ReplaceConds& conditions = replace[i];
+                if (!conditions.contains(condition)) {
+                    conditions.push_back(condition);
                 }
             }
         }
@@ -274,26 +400,26 @@ bool ProjectGenerator::passCondition(const string& condition, StaticList& list,
     return false;
 }
 
-bool ProjectGenerator::passDCondition(
-    const string& condition, StaticList& list, UnknownList& replace, const uint offset)
+bool ProjectGenerator::passDCondition(const string& condition, const string& ident, const vector<string>& values,
+    UniqueList& list, ReplaceList& replace)
 {
-    const auto cond = m_configHelper.getConfigOptionPrefixed(condition);
-    if (cond == m_configHelper.m_configValues.end()) {
+    const MakeCondition& cond = getMakeCondition(condition);
+    if (cond.id == string::npos) {
         outputInfo("Unknown configuration condition (" + condition + ")");
         return false;
     }
-    if (cond->m_value == "0") {
+    if (m_configHelper.isConfigIDDisabled(cond.id)) {
         return true;
     }
-    StaticList temp;
-    if (passDynamicInclude(offset, temp)) {
-        for (auto& i : temp) {
+    UniqueList temp;
+    if (passDynamicInclude(ident, values, temp)) {
+        for (const auto& i : temp) {
             // Check if object already included in internal list
-            if (find(list.begin(), list.end(), i) == list.end()) {
+            if (!list.contains(i)) {
                 // Check if already in replace list
-                if (replace.find(i) == replace.end() ||
-                    find(replace[i].begin(), replace[i].end(), condition) == replace[i].end()) {
-                    replace[i].push_back(condition);
+                ReplaceConds& conditions = replace[i];
+                if (!conditions.contains(condition)) {
+                    conditions.push_back(condition);
                 }
             }
         }
@@ -302,166 +428,115 @@ bool ProjectGenerator::passDCondition(
     return false;
 }
 
-bool ProjectGenerator::passCInclude(const std::string& condition)
+bool ProjectGenerator::passCInclude(const MakeStatement& statement, const std::string& condition)
 {
     if (!condition.empty()) {
-        return passCondition(condition, m_includes, m_replaceIncludes, 4);
+        return passCondition(condition, statement.values, m_includes, m_replaceIncludes);
     }
-    return passStaticInclude(4, m_includes);
+    return passStaticInclude(statement.values, m_includes);
 }
 
-bool ProjectGenerator::passDCInclude(const std::string& condition)
+bool ProjectGenerator::passDCInclude(const MakeStatement& statement, const std::string& condition)
 {
     if (!condition.empty()) {
-        return passDCondition(condition, m_includes, m_replaceIncludes, 5);
+        return passDCondition(
+            condition, statement.ident, statement.values, m_includes, m_replaceIncludes);
     }
-    return passDynamicInclude(5, m_includes);
+    return passDynamicInclude(statement.ident, statement.values, m_includes);
 }
 
-bool ProjectGenerator::passASMInclude(const uint offset, const std::string& condition)
+bool ProjectGenerator::passASMInclude(const MakeStatement& statement, const std::string& condition)
 {
     // Check if supported option
     if (m_configHelper.isASMEnabled()) {
-        if (!condition.empty()) {
-            return passCondition(condition, m_includes, m_replaceIncludes, 9 + offset);
-        }
-        return passStaticInclude(9 + offset, m_includes);
+        return passCInclude(statement, condition);
     }
     return true;
 }
 
-bool ProjectGenerator::passDASMInclude(const uint offset, const std::string& condition)
+bool ProjectGenerator::passDASMInclude(const MakeStatement& statement, const std::string& condition)
 {
     // Check if supported option
     if (m_configHelper.isASMEnabled()) {
-        if (!condition.empty()) {
-            return passDCondition(condition, m_includes, m_replaceIncludes, 10 + offset);
-        }
-        return passDynamicInclude(10 + offset, m_includes);
+        return passDCInclude(statement, condition);
     }
     return true;
 }
 
-bool ProjectGenerator::passMMXInclude(const std::string& condition)
+bool ProjectGenerator::passMMXInclude(const MakeStatement& statement, const std::string& condition)
 {
     // Check if supported option
-    if (m_configHelper.getConfigOptionPrefixed("HAVE_MMX")->m_value == "1") {
-        if (!condition.empty()) {
-            return passDCondition(condition, m_includes, m_replaceIncludes, 8);
-        }
-        return passStaticInclude(8, m_includes);
+    if (isMakeConditionMet(getMakeCondition("HAVE_MMX"))) {
+        return passCInclude(statement, condition);
     }
     return true;
 }
 
-bool ProjectGenerator::passDMMXInclude(const std::string& condition)
+bool ProjectGenerator::passDMMXInclude(const MakeStatement& statement, const std::string& condition)
 {
     // Check if supported option
-    if (m_configHelper.getConfigOptionPrefixed("HAVE_MMX")->m_value == "1") {
-        if (!condition.empty()) {
-            return passDCondition(condition, m_includes, m_replaceIncludes, 9);
-        }
-        return passDynamicInclude(9, m_includes);
+    if (isMakeConditionMet(getMakeCondition("HAVE_MMX"))) {
+        return passDCInclude(statement, condition);
     }
     return true;
 }
 
-bool ProjectGenerator::passHInclude(const uint cutPos)
+bool ProjectGenerator::passHInclude(const MakeStatement& statement)
 {
-    return passStaticInclude(cutPos, m_includesH);
+    return passStaticInclude(statement.values, m_includesH);
 }
 
-bool ProjectGenerator::passDHInclude()
+bool ProjectGenerator::passDHInclude(const MakeStatement& statement)
 {
-    return passDynamicInclude(8, m_includesH);
+    return passDynamicInclude(statement.ident, statement.values, m_includesH);
 }
 
-bool ProjectGenerator::passLibInclude()
+bool ProjectGenerator::passLibInclude(const MakeStatement& statement)
 {
-    return passStaticInclude(6, m_libs);
+    return passStaticInclude(statement.values, m_libs);
 }
 
-bool ProjectGenerator::passDLibInclude()
+bool ProjectGenerator::passDLibInclude(const MakeStatement& statement)
 {
-    return passDynamicInclude(7, m_libs);
+    return passDynamicInclude(statement.ident, statement.values, m_libs);
 }
 
-bool ProjectGenerator::passDUnknown()
+bool ProjectGenerator::passDUnknown(const MakeStatement& statement)
 {
-    // Find the dynamic identifier
-    uint startPos = m_inLine.find("$(");
-    const uint endPos = m_inLine.find(')', startPos);
-    const string prefix = m_inLine.substr(0, startPos) + "yes";
-    startPos += 2; // Skip the $(
-    string ident = m_inLine.substr(startPos, endPos - startPos);
-    // Find the included obj
-    startPos = m_inLine.find_first_not_of("+= \t", endPos + 1);
-    if (!passDynamicIncludeLine(startPos, ident, m_unknowns[prefix])) {
-        return false;
-    }
-    // Check if this is a multi line declaration
-    while (m_inLine.back() == '\\') {
-        // Get the next line
-        getline(m_inputFile, m_inLine);
-        // Remove the whitespace
-        startPos = m_inLine.find_first_not_of(" \t");
-        if (startPos == string::npos) {
-            break;
-        }
-        if (!passDynamicIncludeLine(startPos, ident, m_unknowns[prefix])) {
-            return false;
-        }
-    }
-    return true;
+    // The objects are stored using the variable name with the dynamic identifier replaced by 'yes'
+    const string prefix = statement.name.substr(0, statement.name.find("$(")) + "yes";
+    return passDynamicInclude(statement.ident, statement.values, m_unknowns[prefix]);
 }
 
-bool ProjectGenerator::passDLibUnknown()
+bool ProjectGenerator::passSharedDCInclude(const MakeStatement& statement)
 {
-    // Find the dynamic identifier
-    uint startPos = m_inLine.find("$(");
-    const uint endPos = m_inLine.find(')', startPos);
-    const string prefix = m_inLine.substr(0, startPos) + "yes";
-    startPos += 2; // Skip the $(
-    string ident = m_inLine.substr(startPos, endPos - startPos);
-    // Find the included obj
-    startPos = m_inLine.find_first_not_of("+= \t", endPos + 1);
-    if (!passDynamicIncludeLine(startPos, ident, m_unknowns[prefix])) {
-        return false;
-    }
-    // Check if this is a multi line declaration
-    while (m_inLine.back() == '\\') {
-        // Get the next line
-        getline(m_inputFile, m_inLine);
-        // Remove the whitespace
-        startPos = m_inLine.find_first_not_of(" \t");
-        if (startPos == string::npos) {
-            break;
-        }
-        if (!passDynamicIncludeLine(startPos, ident, m_unknowns[prefix])) {
-            return false;
-        }
-    }
-    return true;
+    return passDCondition(
+        "CONFIG_SHARED", statement.ident, statement.values, m_includes, m_replaceIncludes);
 }
 
-bool ProjectGenerator::passSharedDCInclude()
+bool ProjectGenerator::passSharedCInclude(const MakeStatement& statement)
 {
-    return passDCondition("CONFIG_SHARED", m_includes, m_replaceIncludes, 10);
+    return passCondition("CONFIG_SHARED", statement.values, m_includes, m_replaceIncludes);
 }
 
-bool ProjectGenerator::passSharedCInclude()
+bool ProjectGenerator::passStaticDCInclude(const MakeStatement& statement)
 {
-    return passCondition("CONFIG_SHARED", m_includes, m_replaceIncludes, 10);
+    return passDCondition(
+        "CONFIG_STATIC", statement.ident, statement.values, m_includes, m_replaceIncludes);
 }
 
-bool ProjectGenerator::passStaticDCInclude()
+bool ProjectGenerator::passStaticCInclude(const MakeStatement& statement)
 {
-    return passDCondition("CONFIG_STATIC", m_includes, m_replaceIncludes, 10);
+    return passCondition("CONFIG_STATIC", statement.values, m_includes, m_replaceIncludes);
 }
 
-bool ProjectGenerator::passStaticCInclude()
+bool ProjectGenerator::passProgramInclude(const MakeStatement& statement, const size_t prefix)
 {
-    return passCondition("CONFIG_STATIC", m_includes, m_replaceIncludes, 10);
+    // Anything following the program identifier is a dynamic condition
+    if ((statement.name.length() > prefix) && (statement.name.at(prefix) == '-')) {
+        return passDynamicInclude(getMakeIdent(statement.name.substr(prefix)), statement.values, m_includes);
+    }
+    return passStaticInclude(statement.values, m_includes);
 }
 
 bool ProjectGenerator::passMake()
@@ -472,246 +547,191 @@ bool ProjectGenerator::passMake()
         const string makeFile = makeFiles.back();
         makeFiles.pop_back();
         outputLine("  Generating from Makefile (" + makeFile + ")...");
-        // Open the input Makefile
-        m_inputFile.open(makeFile);
-        if (m_inputFile.is_open()) {
-            // Read each line in the MakeFile
-            string condition;
-            while (getline(m_inputFile, m_inLine)) {
-                // Check what information is included in the current line
-                if (m_inLine.substr(0, 4) == "OBJS") {
+        // Load the input Makefile
+        shared_ptr<const MakeFile> statements;
+        if (!loadMakeFile(makeFile, statements)) {
+            outputError("Could not open open MakeFile (" + makeFile + ")");
+            return false;
+        }
+        // Check each statement in the MakeFile
+        string condition;
+        for (size_t i = 0; i < statements->size(); ++i) {
+            const MakeStatement& statement = (*statements)[i];
+            const string& name = statement.name;
+            // Check what information is included in the current statement
+            if (statement.type == MakeStatement::MAKE_ASSIGNMENT) {
+                bool ret = true;
+                if (name.compare(0, 4, "OBJS") == 0) {
                     // Found some c includes
-                    if (m_inLine.at(4) == '-') {
+                    if ((name.length() > 4) && (name.at(4) == '-')) {
                         // Found some dynamic c includes
-                        if (!passDCInclude(condition)) {
-                            m_inputFile.close();
-                            return false;
-                        }
+                        ret = passDCInclude(statement, condition);
                     } else {
                         // Found some static c includes
-                        if (!passCInclude(condition)) {
-                            m_inputFile.close();
-                            return false;
-                        }
+                        ret = passCInclude(statement, condition);
                     }
-                } else if ((m_inLine.substr(0, 11) == "X86ASM-OBJS") || (m_inLine.substr(0, 9) == "YASM-OBJS")) {
+                } else if ((name.compare(0, 11, "X86ASM-OBJS") == 0) || (name.compare(0, 9, "YASM-OBJS") == 0)) {
                     // Found some YASM includes
-                    const uint offset = (m_inLine.at(0) == 'X') ? 2 : 0;
-                    if (m_inLine.at(9 + offset) == '-') {
+                    const size_t offset = (name.at(0) == 'X') ? 2 : 0;
+                    if ((name.length() > 9 + offset) && (name.at(9 + offset) == '-')) {
                         // Found some dynamic ASM includes
-                        if (!passDASMInclude(offset, condition)) {
-                            m_inputFile.close();
-                            return false;
-                        }
+                        ret = passDASMInclude(statement, condition);
                     } else {
                         // Found some static ASM includes
-                        if (!passASMInclude(offset, condition)) {
-                            m_inputFile.close();
-                            return false;
-                        }
+                        ret = passASMInclude(statement, condition);
                     }
-                } else if (m_inLine.substr(0, 8) == "MMX-OBJS") {
+                } else if (name.compare(0, 8, "MMX-OBJS") == 0) {
                     // Found some ASM includes
-                    if (m_inLine.at(8) == '-') {
+                    if ((name.length() > 8) && (name.at(8) == '-')) {
                         // Found some dynamic MMX includes
-                        if (!passDMMXInclude(condition)) {
-                            m_inputFile.close();
-                            return false;
-                        }
+                        ret = passDMMXInclude(statement, condition);
                     } else {
                         // Found some static MMX includes
-                        if (!passMMXInclude(condition)) {
-                            m_inputFile.close();
-                            return false;
-                        }
+                        ret = passMMXInclude(statement, condition);
                     }
-                } else if (m_inLine.substr(0, 7) == "HEADERS") {
+                } else if (name.compare(0, 7, "HEADERS") == 0) {
                     // Found some headers
-                    if (m_inLine.at(7) == '-') {
+                    if ((name.length() > 7) && (name.at(7) == '-')) {
                         // Found some dynamic headers
-                        if (!passDHInclude()) {
-                            m_inputFile.close();
-                            return false;
-                        }
+                        ret = passDHInclude(statement);
                     } else {
                         // Found some static headers
-                        if (!passHInclude()) {
-                            m_inputFile.close();
-                            return false;
-                        }
+                        ret = passHInclude(statement);
                     }
-                } else if (m_inLine.find("BUILT_HEADERS") == 0) {
+                } else if (name.compare(0, 13, "BUILT_HEADERS") == 0) {
                     // Found some static built headers
-                    if (!passHInclude(13)) {
-                        m_inputFile.close();
-                        return false;
-                    }
-                } else if (m_inLine.substr(0, 6) == "FFLIBS") {
+                    ret = passHInclude(statement);
+                } else if (name.compare(0, 6, "FFLIBS") == 0) {
                     // Found some libs
-                    if (m_inLine.at(6) == '-') {
+                    if ((name.length() > 6) && (name.at(6) == '-')) {
                         // Found some dynamic libs
-                        if (!passDLibInclude()) {
-                            m_inputFile.close();
-                            return false;
-                        }
+                        ret = passDLibInclude(statement);
                     } else {
                         // Found some static libs
-                        if (!passLibInclude()) {
-                            m_inputFile.close();
-                            return false;
-                        }
+                        ret = passLibInclude(statement);
                     }
-                } else if (m_inLine.substr(0, 9) == "SHLIBOBJS") {
+                } else if (name.compare(0, 9, "SHLIBOBJS") == 0) {
                     // Found some libs
-                    if (m_inLine.at(9) == '-') {
+                    if ((name.length() > 9) && (name.at(9) == '-')) {
                         // Found some dynamic include
-                        if (!passSharedDCInclude()) {
-                            m_inputFile.close();
-                            return false;
-                        }
+                        ret = passSharedDCInclude(statement);
                     } else {
                         // Found some static include
-                        if (!passSharedCInclude()) {
-                            m_inputFile.close();
-                            return false;
-                        }
+                        ret = passSharedCInclude(statement);
                     }
-                } else if (m_inLine.substr(0, 9) == "STLIBOBJS") {
+                } else if (name.compare(0, 9, "STLIBOBJS") == 0) {
                     // Found some libs
-                    if (m_inLine.at(9) == '-') {
+                    if ((name.length() > 9) && (name.at(9) == '-')) {
                         // Found some dynamic include
-                        if (!passStaticDCInclude()) {
-                            m_inputFile.close();
-                            return false;
-                        }
+                        ret = passStaticDCInclude(statement);
                     } else {
                         // Found some static include
-                        if (!passStaticCInclude()) {
-                            m_inputFile.close();
-                            return false;
-                        }
+                        ret = passStaticCInclude(statement);
                     }
-                } else if (m_inLine.find("-OBJS-$") != string::npos) {
+                } else if ((name.find("-OBJS-$") != string::npos) || (name.find("LIBS-$") != string::npos)) {
                     // Found unknown
-                    if (!passDUnknown()) {
-                        m_inputFile.close();
-                        return false;
-                    }
-                } else if (m_inLine.find("LIBS-$") != string::npos) {
-                    // Found Lib unknown
-                    if (!passDLibUnknown()) {
-                        m_inputFile.close();
-                        return false;
+                    ret = passDUnknown(statement);
+                }
+                if (!ret) {
+                    return false;
+                }
+            } else if (statement.type == MakeStatement::MAKE_IFDEF) {
+                // Check if the config option is correct
+                const MakeCondition& option = getMakeCondition(name);
+                if (option.id == string::npos) {
+                    outputInfo("Unknown ifdef configuration option (" + name + ")");
+                    return false;
+                }
+                if (m_configHelper.isConfigIDDisabled(option.id)) {
+                    // Skip everything between the ifdefs
+                    while (++i < statements->size()) {
+                        const MakeStatement::Type type = (*statements)[i].type;
+                        if ((type == MakeStatement::MAKE_ENDIF) || (type == MakeStatement::MAKE_ELSE)) {
+                            break;
+                        }
                     }
-                } else if (m_inLine.substr(0, 5) == "ifdef") {
-                    // Check for configuration value
-                    const uint startPos = m_inLine.find_first_not_of(" \t", 5);
-                    uint endPos = m_inLine.find_first_of(" \t\n\r", startPos + 1);
-                    endPos = (endPos == string::npos) ? endPos : endPos - startPos;
-                    string config = m_inLine.substr(startPos, endPos);
-                    // Check if the config option is correct
-                    auto option = m_configHelper.getConfigOptionPrefixed(config);
-                    if (option == m_configHelper.m_configValues.end()) {
-                        outputInfo("Unknown ifdef configuration option (" + config + ")");
-                        return false;
+                } else {
+                    // Check if the config option is for a reserved type
+                    if (option.replace) {
+                        condition = name;
                     }
-                    if (option->m_value == "0") {
+                }
+            } else if ((statement.type == MakeStatement::MAKE_ELSE) && name.empty()) {
+                // If we have no previous reserved condition then we can just pull in everything after the 'else'
+                if (!condition.empty()) {
+                    // Condition is now the opposite of what it was
+                    if (condition == "ARCH_X86_32") {
+                        condition = "ARCH_X86_64";
+                    } else if (condition == "ARCH_X86_64") {
+                        condition = "ARCH_X86_32";
+                    } else if (condition == "CONFIG_SHARED") {
+                        condition = "CONFIG_STATIC";
+                    } else if (condition == "CONFIG_STATIC") {
+                        condition = "CONFIG_SHARED";
+                    } else {
+                        outputInfo("Unknown ifdef else configuration option (" + condition + ")");
                         // Skip everything between the ifdefs
-                        while (getline(m_inputFile, m_inLine)) {
-                            if ((m_inLine.substr(0, 5) == "endif") || (m_inLine.substr(0, 4) == "else")) {
+                        while (++i < statements->size()) {
+                            if ((*statements)[i].type == MakeStatement::MAKE_ENDIF) {
                                 break;
                             }
                         }
-                    } else {
-                        // Check if the config option is for a reserved type
-                        if (m_configHelper.m_replaceList.find(config) != m_configHelper.m_replaceList.end()) {
-                            condition = config;
-                        }
-                    }
-                } else if (m_inLine.substr(0, 5) == "else") {
-                    // If we have no previous reserved condition then we can just pull in everything after the 'else'
-                    if (!condition.empty()) {
-                        // Condition is now the opposite of what it was
-                        if (condition == "ARCH_X86_32") {
-                            condition = "ARCH_X86_64";
-                        } else if (condition == "ARCH_X86_64") {
-                            condition = "ARCH_X86_32";
-                        } else if (condition == "CONFIG_SHARED") {
-                            condition = "CONFIG_STATIC";
-                        } else if (condition == "CONFIG_STATIC") {
-                            condition = "CONFIG_SHARED";
-                        } else {
-                            outputInfo("Unknown ifdef else configuration option (" + condition + ")");
-                            // Skip everything between the ifdefs
-                            while (getline(m_inputFile, m_inLine)) {
-                                if (m_inLine.substr(0, 5) == "endif") {
-                                    break;
-                                }
-                            }
-                        }
-                    }
-                } else if (m_inLine.substr(0, 5) == "endif") {
-                    // Reset the current condition
-                    condition.clear();
-                } else if (m_inLine.substr(0, 7) == "include" || m_inLine.substr(0, 8) == "-include") {
-                    // Need to append the included file to makefile list
-                    uint startPos = m_inLine.find_first_not_of(" \t", 7 + (m_inLine[0] == '-' ? 1 : 0));
-                    uint endPos = m_inLine.find_first_of(" \t\n\r", startPos + 1);
-                    endPos = (endPos == string::npos) ? endPos : endPos - startPos;
-                    string newMake = m_inLine.substr(startPos, endPos);
-                    // Perform token substitution
-                    startPos = newMake.find('$');
-                    while (startPos != string::npos) {
-                        endPos = newMake.find(')', startPos + 1);
-                        if (endPos == string::npos) {
-                            outputError("Invalid token in include (" + newMake + ")");
-                            return false;
-                        }
-                        ++endPos;
-                        string token = newMake.substr(startPos, endPos - startPos);
-                        if (token == "$(SRC_PATH)") {
-                            newMake.replace(startPos, endPos - startPos, m_configHelper.m_rootDirectory);
-                        } else if (token == "$(ARCH)") {
-                            newMake.replace(startPos, endPos - startPos, "x86");
-                        } else {
-                            outputError("Unknown token in include (" + token + ")");
-                            return false;
-                        }
-                        startPos = newMake.find('$', startPos);
-                    }
-                    makeFiles.push_back(newMake);
-                    // Add to internal list of known subdirectories
-                    const uint rootPos = newMake.find(m_configHelper.m_rootDirectory); 
-                    if (rootPos != string::npos) {
-                        newMake.erase(rootPos, m_configHelper.m_rootDirectory.length());
-                    }
-                    const uint projPos = newMake.find(m_projectName + '/');
-                    if (projPos != string::npos) {
-                        newMake.erase(projPos, m_projectName.length() + 1);
-                    }
-                    // Clean duplicate '//'
-                    uint findPos2 = newMake.find("//");
-                    while (findPos2 != string::npos) {
-                        newMake.erase(findPos2, 1);
-                        // get next
-                        findPos2 = newMake.find("//");
                     }
-                    if (newMake[0] == '/') {
-                        newMake.erase(0, 1);
-                    }
-                    findPos2 = newMake.rfind('/');
-                    if (findPos2 != string::npos) {
-                        newMake.erase(findPos2);
+                }
+            } else if (statement.type == MakeStatement::MAKE_ENDIF) {
+                // Reset the current condition
+                condition.clear();
+            } else if (statement.type == MakeStatement::MAKE_INCLUDE) {
+                // Need to append the included file to makefile list
+                string newMake = name;
+                // Perform token substitution
+                size_t startPos = newMake.find('$');
+                while (startPos != string::npos) {
+                    size_t endPos = newMake.find(')', startPos + 1);
+                    if (endPos == string::npos) {
+                        outputError("Invalid token in include (" + newMake + ")");
+                        return false;
                     }
-                    if (!newMake.empty()) {
-                        m_subDirs.push_back(newMake);
+                    ++endPos;
+                    string token = newMake.substr(startPos, endPos - startPos);
+                    if (token == "$(SRC_PATH)") {
+                        newMake.replace(startPos, endPos - startPos, m_configHelper.m_rootDirectory);
+                    } else if (token == "$(ARCH)") {
+                        newMake.replace(startPos, endPos - startPos, "x86");
+                    } else {
+                        outputError("Unknown token in include (" + token + ")");
+                        return false;
                     }
+                    startPos = newMake.find('$', startPos);
+                }
+                makeFiles.push_back(newMake);
+                // Add to internal list of known subdirectories
+                const size_t rootPos = newMake.find(m_configHelper.m_rootDirectory);
+                if (rootPos != string::npos) {
+                    newMake.erase(rootPos, m_configHelper.m_rootDirectory.length());
+                }
+                const size_t projPos = newMake.find(m_projectName + '/');
+                if (projPos != string::npos) {
+                    newMake.erase(projPos, m_projectName.length() + 1);
+                }
+                // Clean duplicate '//'
+                size_t findPos2 = newMake.find("//");
+                while (findPos2 != string::npos) {
+                    newMake.erase(findPos2, 1);
+                    // get next
+                    findPos2 = newMake.find("//");
+                }
+                if (newMake[0] == '/') {
+                    newMake.erase(0, 1);
+                }
+                findPos2 = newMake.rfind('/');
+                if (findPos2 != string::npos) {
+                    newMake.erase(findPos2);
+                }
+                if (!newMake.empty()) {
+                    m_subDirs.push_back(newMake);
                 }
             }
-            m_inputFile.close();
-        } else {
-            outputError("Could not open open MakeFile (" + makeFile + ")");
-            return false;
         }
     }
     return true;
@@ -719,100 +739,64 @@ bool ProjectGenerator::passMake()
 
 bool ProjectGenerator::passProgramMake()
 {
-    uint checks = 2;
+    size_t checks = 2;
     while (checks >= 1) {
-        // Open the input Makefile
+        // Load the input Makefile
         string makeFile = m_projectDir + "MakeFile";
-        m_inputFile.close();
-        m_inputFile.open(makeFile);
-        if (!m_inputFile.is_open()) {
+        shared_ptr<const MakeFile> statements = make_shared<const MakeFile>();
+        if (!loadMakeFile(makeFile, statements)) {
             outputError("Could not open open MakeFile (" + makeFile + ")");
         }
         outputLine("  Generating from Makefile (" + makeFile + ") for project " + m_projectName + "...");
-        string objTag = "OBJS-" + m_projectName;
-        uint findPos;
-        // Read each line in the MakeFile
-        while (getline(m_inputFile, m_inLine)) {
-            // Check what information is included in the current line
-            if (m_inLine.substr(0, objTag.length()) == objTag) {
-                // Cut the line so it can be used by default passers
-                m_inLine = m_inLine.substr(objTag.length() - 4);
-                if (m_inLine.at(4) == '-') {
-                    // Found some dynamic c includes
-                    if (!passDCInclude()) {
-                        m_inputFile.close();
-                        return false;
-                    }
-                } else {
-                    // Found some static c includes
-                    if (!passCInclude()) {
-                        m_inputFile.close();
-                        return false;
-                    }
-                }
-            } else if (m_inLine.substr(0, 6) == "FFLIBS") {
-                // Found some libs
-                if (m_inLine.at(6) == '-') {
-                    // Found some dynamic libs
-                    if (!passDLibInclude()) {
-                        m_inputFile.close();
-                        return false;
-                    }
-                } else {
-                    // Found some static libs
-                    if (!passLibInclude()) {
-                        m_inputFile.close();
-                        return false;
-                    }
-                }
-            } else if ((findPos = m_inLine.find("eval OBJS-$(prog)")) != string::npos) {
-                m_inLine = m_inLine.substr(findPos + 13);
-                if (m_inLine.at(4) == '-') {
-                    // Found some dynamic c includes
-                    if (!passDCInclude()) {
-                        m_inputFile.close();
-                        return false;
-                    }
-                } else {
-                    // Found some static c includes
-                    if (!passCInclude()) {
-                        m_inputFile.close();
-                        return false;
+        const string objTag = "OBJS-" + m_projectName;
+        MakeStatement evalStatement;
+        size_t findPos;
+        // Check each statement in the MakeFile
+        for (const auto& statement : *statements) {
+            const string& name = statement.name;
+            bool ret = true;
+            // Check what information is included in the current statement
+            if (statement.type == MakeStatement::MAKE_ASSIGNMENT) {
+                if (name.compare(0, objTag.length(), objTag) == 0) {
+                    // Found some c includes
+                    ret = passProgramInclude(statement, objTag.length());
+                } else if (name.compare(0, 6, "FFLIBS") == 0) {
+                    // Found some libs
+                    if ((name.length() > 6) && (name.at(6) == '-')) {
+                        // Found some dynamic libs
+                        ret = passDLibInclude(statement);
+                    } else {
+                        // Found some static libs
+                        ret = passLibInclude(statement);
+                    }
+                } else if (name.compare(0, 9, "OBJS-$(1)") == 0) {
+                    // Only the objects up to the last '.o' belong to the program
+                    MakeStatement objects = statement;
+                    for (size_t i = objects.values.size(); i > 0; --i) {
+                        if (objects.values[i - 1].find(".o") != string::npos) {
+                            objects.values.resize(i);
+                            break;
+                        }
                     }
+                    ret = passProgramInclude(objects, 9);
                 }
-            } else if (((findPos = m_inLine.find("OBJS-$(1)")) != string::npos) && (findPos == 0)) {
-                m_inLine = m_inLine.substr(findPos + 5, m_inLine.rfind(".o") + 2 - (findPos + 5));
-                if (m_inLine.at(4) == '-') {
-                    // Found some dynamic c includes
-                    if (!passDCInclude()) {
-                        m_inputFile.close();
-                        return false;
-                    }
-                } else {
-                    // Found some static c includes
-                    if (!passCInclude()) {
-                        m_inputFile.close();
-                        return false;
-                    }
+            } else if ((findPos = name.find("eval OBJS-$(prog)")) != string::npos) {
+                // Pass the assignment found inside the eval
+                if (passMakeLine(string_view(name).substr(findPos + 5), evalStatement) &&
+                    (evalStatement.type == MakeStatement::MAKE_ASSIGNMENT)) {
+                    ret = passProgramInclude(evalStatement, 12);
                 }
-            } else if ((findPos = m_inLine.find("eval OBJS-$(P)")) != string::npos) {
-                m_inLine = m_inLine.substr(findPos + 10);
-                if (m_inLine.at(4) == '-') {
-                    // Found some dynamic c includes
-                    if (!passDCInclude()) {
-                        m_inputFile.close();
-                        return false;
-                    }
-                } else {
-                    // Found some static c includes
-                    if (!passCInclude()) {
-                        m_inputFile.close();
-                        return false;
-                    }
+            } else if ((findPos = name.find("eval OBJS-$(P)")) != string::npos) {
+                // Pass the assignment found inside the eval
+                if (passMakeLine(string_view(name).substr(findPos + 5), evalStatement) &&
+                    (evalStatement.type == MakeStatement::MAKE_ASSIGNMENT)) {
+                    ret = passProgramInclude(evalStatement, 9);
                 }
             }
+            if (!ret) {
+                return false;
+            }
         }
-        m_inputFile.close();
         if (checks == 2) {
             string ignored;
             const string makeFolder = "fftools/";
@@ -826,12 +810,16 @@ bool ProjectGenerator::passProgramMake()
         }
         // When passing the fftools folder some objects are added with fftools folder prefixed to file name
         const string makeFolder = "fftools/";
-        uint uiPos;
-        for (auto i = m_includes.begin(); i < m_includes.end(); ++i) {
-            if ((uiPos = i->find(makeFolder)) != string::npos) {
-                i->erase(uiPos, makeFolder.length());
+        size_t uiPos;
+        UniqueList includes;
+        for (const auto& i : m_includes) {
+            string include = i;
+            if ((uiPos = include.find(makeFolder)) != string::npos) {
+                include.erase(uiPos, makeFolder.length());
             }
+            includes.push_back(include);
         }
+        m_includes = std::move(includes);
         --checks;
     }
 
@@ -21,21 +21,153 @@
 #include "configGenerator.h"
 #include "projectGenerator.h"
 
+#include <cctype>
+#include <future>
+
+/**
+ * Generates all output files for a single project variant.
+ * @param [in,out] configHelper A copy of a config helper that has already passed the configure file.
+ * @param          name         The variant name.
+ * @param          options      The list of input options to use for the variant.
+ * @return True if it succeeds, false if it fails.
+ */
+bool passVariant(ConfigGenerator& configHelper, const string& name, const vector<string>& options)
+{
+    // Start from the already passed configure file and then apply the variants options
+    outputLine("  Generating variant (" + name + ")...");
+    if (!configHelper.passConfigValues(options)) {
+        outputError("Failed passing config options for variant (" + name + ")");
+        return false;
+    }
+    ProjectGenerator projectGenerator(configHelper, "FFVSTemp_" + name + "/");
+
+    // Output config.h and avutil.h and then generate desired configuration files
+    if (!configHelper.outputConfig() || !projectGenerator.passAllMake()) {
+        outputError("Failed generating variant (" + name + ")");
+        projectGenerator.cleanupCreatedFiles();
+        return false;
+    }
+
+    // Delete any previously generated files that are no longer needed
+    configHelper.deleteCreatedFiles(true);
+    projectGenerator.deleteCreatedFiles(true);
+    outputLine("  Completed variant (" + name + ")");
+    return true;
+}
+
+/**
+ * Generates multiple project variants in parallel from a single pass of the configure file.
+ * @param options  The list of input options common to all variants.
+ * @param variants The name and list of input options for each variant.
+ * @return True if it succeeds, false if it fails.
+ */
+bool passVariants(const vector<string>& options, const vector<pair<string, vector<string>>>& variants)
+{
+    // Each variant must be output to a unique location and use a unique temporary directory
+    vector<string> projectDirs;
+    for (auto i = variants.begin(); i < variants.end(); ++i) {
+        if (i->first.empty()) {
+            outputError("Each variant must be given a name (--variant=NAME)");
+            return false;
+        }
+        // The name is used as part of the temporary directory so it must not contain any path characters
+        for (const auto& j : i->first) {
+            if ((isalnum(static_cast<unsigned char>(j)) == 0) && (j != '_') && (j != '-')) {
+                outputError("Invalid variant name (" + i->first + ")");
+                outputError("Variant names may only contain letters, digits, '_' and '-'", false);
+                return false;
+            }
+        }
+        for (auto j = variants.begin(); j < i; ++j) {
+            if (j->first == i->first) {
+                outputError("The variant name (" + i->first + ") is already used by another variant");
+                return false;
+            }
+        }
+        string projectDir;
+        for (const auto& j : i->second) {
+            // Options passed along with the configure file are shared by all variants
+            if ((j.find("--rootdir") == 0) || (j == "--loud") || (j == "--quiet") || (j == "--use-yasm") ||
+                (j == "--trace-config")) {
+                outputError("The option (" + j + ") cannot be used within a variant (" + i->first + ")");
+                outputError("Pass the option before the first variant so that it applies to all variants", false);
+                return false;
+            }
+            if (j.find("--projdir=") == 0) {
+                projectDir = j.substr(10);
+            }
+        }
+        if (projectDir.empty()) {
+            outputError("A projdir option must be specified for variant (" + i->first + ")");
+            return false;
+        }
+        for (const auto& j : projectDirs) {
+            if (isSameDirectory(j, projectDir)) {
+                outputError("The projdir for variant (" + i->first + ") is already used by another variant");
+                return false;
+            }
+        }
+        projectDirs.push_back(projectDir);
+    }
+
+    // Pass the configure file once and then share it between each variant
+    ConfigGenerator configHelper;
+    if (!configHelper.passConfigure(options)) {
+        return false;
+    }
+    vector<ConfigGenerator> configHelpers(variants.size(), configHelper);
+    vector<future<bool>> results;
+    for (size_t i = 0; i < variants.size(); ++i) {
+        // Common options are passed first so that they can be overridden by the variant
+        vector<string> variantOptions = options;
+        variantOptions.insert(variantOptions.end(), variants[i].second.begin(), variants[i].second.end());
+        results.push_back(
+            async(launch::async, passVariant, ref(configHelpers[i]), cref(variants[i].first), variantOptions));
+    }
+    bool ret = true;
+    for (auto& i : results) {
+        ret = i.get() && ret;
+    }
+    return ret;
+}
+
 int main(const int argc, char** argv)
 {
     outputLine("Project generator (this may take several minutes, please wait)...");
+    // Check for any variants
+    vector<string> options;
+    vector<pair<string, vector<string>>> variants;
+    for (int i = 1; i < argc; i++) {
+        string option = string(argv[i]);
+        if (option.find("--variant=") == 0) {
+            variants.emplace_back(option.substr(10), vector<string>());
+        } else if (variants.empty()) {
+            options.push_back(option);
+        } else {
+            variants.back().second.push_back(option);
+        }
+    }
+    if (!variants.empty()) {
+        if (!passVariants(options, variants)) {
+            pressKeyToContinue();
+            exit(1);
+        }
+        outputLine("Completed Successfully");
+#if _DEBUG
+        pressKeyToContinue();
+#endif
+        exit(0);
+    }
+
     // Pass the input configuration
-    ProjectGenerator projectGenerator;
-    if (!projectGenerator.m_configHelper.passConfig(argc, argv)) {
+    ConfigGenerator configHelper;
+    ProjectGenerator projectGenerator(configHelper);
+    if (!configHelper.passConfig(argc, argv)) {
         projectGenerator.errorFunc(false);
     }
 
-    // Delete any previously generated files
-    projectGenerator.m_configHelper.deleteCreatedFiles();
-    projectGenerator.deleteCreatedFiles();
-
     // Output config.h and avutil.h
-    if (!projectGenerator.m_configHelper.outputConfig()) {
+    if (!configHelper.outputConfig()) {
         projectGenerator.errorFunc();
     }
 
@@ -43,6 +175,10 @@ int main(const int argc, char** argv)
     if (!projectGenerator.passAllMake()) {
         projectGenerator.errorFunc();
     }
+
+    // Delete any previously generated files that are no longer needed
+    configHelper.deleteCreatedFiles(true);
+    projectGenerator.deleteCreatedFiles(true);
     outputLine("Completed Successfully");
 #if _DEBUG
     pressKeyToContinue();
@@ -0,0 +1,127 @@
+/*
+ * copyright (c) 2017 Matthew Oliver
+ *
+ * This file is part of ShiftMediaProject.
+ *
+ * ShiftMediaProject is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * ShiftMediaProject is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with ShiftMediaProject; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "configGenerator.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+// Counts every allocation made through the global allocator
+static atomic<size_t> s_allocations(0);
+static atomic<size_t> s_allocatedBytes(0);
+
+void* operator new(const size_t size)
+{
+    ++s_allocations;
+    s_allocatedBytes += size;
+    void* ret = malloc((size > 0) ? size : 1);
+    if (ret == nullptr) {
+        throw bad_alloc();
+    }
+    return ret;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    free(ptr);
+}
+
+/**
+ * Counts the number of config values output to a generated config header.
+ * @param fileName Filename of the header.
+ * @return The number of values.
+ */
+static size_t countConfigValues(const string& fileName)
+{
+    string file;
+    if (!loadFromFile(fileName, file, false, false)) {
+        return 0;
+    }
+    size_t values = 0;
+    const string prefixes[] = {"\n#define ARCH_", "\n#define HAVE_", "\n#define CONFIG_"};
+    for (const auto& i : prefixes) {
+        for (size_t pos = file.find(i); pos != string::npos; pos = file.find(i, pos + 1)) {
+            ++values;
+        }
+    }
+    return values;
+}
+
+/**
+ * Measures the allocations made while resolving config values.
+ * @remark Usage: config_allocations --rootdir=DIR --projdir=DIR [options]. The projdir is used for the output config
+ * files and any existing config snapshot within it is removed so that all values are resolved.
+ */
+int main(const int argc, char** argv)
+{
+    vector<string> options;
+    string projectDir;
+    for (int i = 1; i < argc; i++) {
+        options.emplace_back(argv[i]);
+        if (options.back().find("--projdir=") == 0) {
+            projectDir = options.back().substr(10);
+        }
+    }
+    if (projectDir.empty()) {
+        outputError("A projdir option must be specified");
+        return 1;
+    }
+    if (projectDir.back() != '/') {
+        projectDir += '/';
+    }
+    remove((projectDir + "config.snapshot").c_str());
+
+    ConfigGenerator configHelper;
+    s_allocations = 0;
+    s_allocatedBytes = 0;
+    if (!configHelper.passConfigure(options)) {
+        return 1;
+    }
+    const size_t configureAllocations = s_allocations;
+    const size_t configureBytes = s_allocatedBytes;
+    s_allocations = 0;
+    s_allocatedBytes = 0;
+    if (!configHelper.passConfigValues(options)) {
+        return 1;
+    }
+    const size_t resolveAllocations = s_allocations;
+    const size_t resolveBytes = s_allocatedBytes;
+    if (!configHelper.outputConfig()) {
+        return 1;
+    }
+    const size_t values = countConfigValues(projectDir + "config.h") + countConfigValues(projectDir + "config_components.h");
+    if (values == 0) {
+        outputError("No config values were output");
+        return 1;
+    }
+    printf("Resolved config values:     %zu\n", values);
+    printf("Passing configure:          %zu allocations (%zu bytes)\n", configureAllocations, configureBytes);
+    printf("Resolving values:           %zu allocations (%zu bytes)\n", resolveAllocations, resolveBytes);
+    printf("Resolving values per value: %.1f allocations\n",
+        static_cast<double>(resolveAllocations) / static_cast<double>(values));
+    return 0;
+}
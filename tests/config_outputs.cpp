@@ -0,0 +1,89 @@
+/*
+ * copyright (c) 2017 Matthew Oliver
+ *
+ * This file is part of ShiftMediaProject.
+ *
+ * ShiftMediaProject is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * ShiftMediaProject is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with ShiftMediaProject; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "configGenerator.h"
+
+#include <algorithm>
+
+/**
+ * Compares a generated file against its expected contents.
+ * @param fileName     Filename of the generated file.
+ * @param expectedName Filename of the file containing the expected contents.
+ * @return True if the files are identical, false if they differ.
+ */
+static bool compareFile(const string& fileName, const string& expectedName)
+{
+    string file;
+    string expected;
+    if (!loadFromFile(fileName, file, true) || !loadFromFile(expectedName, expected, true)) {
+        return false;
+    }
+    if (file == expected) {
+        return true;
+    }
+    // Find the first line that differs
+    size_t pos = 0;
+    while ((pos < file.length()) && (pos < expected.length()) && (file[pos] == expected[pos])) {
+        ++pos;
+    }
+    const size_t line = count(file.begin(), file.begin() + pos, '\n') + 1;
+    outputError("Generated file (" + fileName + ") differs from expected output at line " + to_string(line));
+    return false;
+}
+
+/**
+ * Generates the config files and compares them against the expected output.
+ * @remark Usage: config_outputs EXPECTED_DIR --rootdir=DIR --projdir=DIR [options]. The projdir is part of the
+ * generated FFMPEG_CONFIGURATION so it must match the one used to create the expected output.
+ */
+int main(const int argc, char** argv)
+{
+    if (argc < 2) {
+        outputError("An expected output directory must be specified");
+        return 1;
+    }
+    const string expectedDir = string(argv[1]) + '/';
+    // The expected directory takes the place of the program name
+    vector<char*> options;
+    options.push_back(argv[0]);
+    string projectDir;
+    for (int i = 2; i < argc; i++) {
+        options.push_back(argv[i]);
+        const string option = argv[i];
+        if (option.find("--projdir=") == 0) {
+            projectDir = option.substr(10) + '/';
+        }
+    }
+    if (projectDir.empty()) {
+        outputError("A projdir option must be specified");
+        return 1;
+    }
+
+    ConfigGenerator configHelper;
+    if (!configHelper.passConfig(static_cast<int>(options.size()), options.data()) || !configHelper.outputConfig()) {
+        return 1;
+    }
+    bool ret = true;
+    const string files[] = {"config.h", "config.asm", "config_components.h"};
+    for (const auto& i : files) {
+        ret = compareFile(projectDir + i, expectedDir + i) && ret;
+    }
+    return (ret) ? 0 : 1;
+}
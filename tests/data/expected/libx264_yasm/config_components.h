@@ -0,0 +1,84 @@
+/** Automatically generated configuration values
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef FFMPEG_CONFIG_COMPONENTS_H
+#define FFMPEG_CONFIG_COMPONENTS_H
+#include "config.h"
+#define CONFIG_AAC_ADTSTOASC_BSF 0
+#define CONFIG_H264_MP4TOANNEXB_BSF 0
+#define CONFIG_NULL_BSF 0
+#define CONFIG_AAC_DECODER 0
+#define CONFIG_AAC_FIXED_DECODER 0
+#define CONFIG_H264_DECODER 0
+#define CONFIG_HEVC_DECODER 0
+#define CONFIG_MP3_DECODER 0
+#define CONFIG_MPEG4_DECODER 0
+#define CONFIG_OPUS_DECODER 0
+#define CONFIG_VP9_DECODER 0
+#define CONFIG_LIBDAV1D_DECODER 0
+#define CONFIG_LIBOPENCORE_AMRNB_DECODER 0
+#define CONFIG_H264_CUVID_DECODER 0
+#define CONFIG_AAC_ENCODER 0
+#define CONFIG_MPEG4_ENCODER 0
+#define CONFIG_LIBX264_ENCODER 0
+#define CONFIG_LIBX265_ENCODER 0
+#define CONFIG_LIBFDK_AAC_ENCODER 0
+#define CONFIG_LIBMP3LAME_ENCODER 0
+#define CONFIG_LIBOPUS_ENCODER 0
+#define CONFIG_LIBVPX_VP9_ENCODER 0
+#define CONFIG_H264_NVENC_ENCODER 0
+#define CONFIG_H264_QSV_ENCODER 0
+#define CONFIG_H264_D3D11VA_HWACCEL 0
+#define CONFIG_H264_DXVA2_HWACCEL 0
+#define CONFIG_H264_NVDEC_HWACCEL 0
+#define CONFIG_HEVC_NVDEC_HWACCEL 0
+#define CONFIG_AAC_PARSER 0
+#define CONFIG_H264_PARSER 0
+#define CONFIG_HEVC_PARSER 0
+#define CONFIG_MPEG4VIDEO_PARSER 0
+#define CONFIG_DSHOW_INDEV 0
+#define CONFIG_GDIGRAB_INDEV 0
+#define CONFIG_DECKLINK_INDEV 0
+#define CONFIG_SDL2_OUTDEV 0
+#define CONFIG_DECKLINK_OUTDEV 0
+#define CONFIG_SCALE_FILTER 0
+#define CONFIG_SUBTITLES_FILTER 0
+#define CONFIG_ASS_FILTER 0
+#define CONFIG_DRAWTEXT_FILTER 0
+#define CONFIG_NULL_FILTER 0
+#define CONFIG_FORMAT_FILTER 0
+#define CONFIG_AAC_DEMUXER 0
+#define CONFIG_H264_DEMUXER 0
+#define CONFIG_MOV_DEMUXER 0
+#define CONFIG_MATROSKA_DEMUXER 0
+#define CONFIG_MP3_DEMUXER 0
+#define CONFIG_DASH_DEMUXER 0
+#define CONFIG_MP4_MUXER 0
+#define CONFIG_MOV_MUXER 0
+#define CONFIG_MATROSKA_MUXER 0
+#define CONFIG_NULL_MUXER 0
+#define CONFIG_IPOD_MUXER 0
+#define CONFIG_FILE_PROTOCOL 0
+#define CONFIG_HTTP_PROTOCOL 0
+#define CONFIG_HTTPS_PROTOCOL 0
+#define CONFIG_TCP_PROTOCOL 0
+#define CONFIG_TLS_PROTOCOL 0
+#endif /* FFMPEG_CONFIG_COMPONENTS_H */
@@ -0,0 +1,284 @@
+;******* Automatically generated configuration values
+;* 
+;*  Permission is hereby granted, free of charge, to any person obtaining a copy
+;*  of this software and associated documentation files (the "Software"), to deal
+;*  in the Software without restriction, including without limitation the rights
+;*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+;*  copies of the Software, and to permit persons to whom the Software is
+;*  furnished to do so, subject to the following conditions:
+;* 
+;*  The above copyright notice and this permission notice shall be included in
+;*  all copies or substantial portions of the Software.
+;* 
+;*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+;*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+;*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+;*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+;*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+;*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+;*  THE SOFTWARE.
+;******
+
+%define ARCH_AARCH64 0
+%define ARCH_ARM 0
+%define ARCH_X86 1
+%if __BITS__ = 64
+%define ARCH_X86_32 0
+%elif __BITS__ = 32
+%define ARCH_X86_32 1
+%define PREFIX
+%endif
+%if __BITS__ = 64
+%define ARCH_X86_64 1
+%elif __BITS__ = 32
+%define ARCH_X86_64 0
+%endif
+%define HAVE_NEON 0
+%define HAVE_VFP 0
+%define HAVE_AVX 1
+%define HAVE_AVX2 1
+%define HAVE_AVX512 1
+%define HAVE_MMX 1
+%define HAVE_MMXEXT 1
+%define HAVE_SSE 1
+%define HAVE_SSE2 1
+%define HAVE_SSE3 1
+%define HAVE_SSE4 1
+%define HAVE_SSE42 1
+%define HAVE_SSSE3 1
+%define HAVE_CPUNOP 0
+%define HAVE_I686 1
+%define HAVE_NEON_EXTERNAL 0
+%define HAVE_VFP_EXTERNAL 0
+%define HAVE_AVX_EXTERNAL 1
+%define HAVE_AVX2_EXTERNAL 1
+%define HAVE_AVX512_EXTERNAL 1
+%define HAVE_MMX_EXTERNAL 1
+%define HAVE_MMXEXT_EXTERNAL 1
+%define HAVE_SSE_EXTERNAL 1
+%define HAVE_SSE2_EXTERNAL 1
+%define HAVE_SSE3_EXTERNAL 1
+%define HAVE_SSE4_EXTERNAL 1
+%define HAVE_SSE42_EXTERNAL 1
+%define HAVE_SSSE3_EXTERNAL 1
+%define HAVE_CPUNOP_EXTERNAL 0
+%define HAVE_I686_EXTERNAL 1
+%define HAVE_NEON_INLINE 0
+%define HAVE_VFP_INLINE 0
+%define HAVE_AVX_INLINE 1
+%define HAVE_AVX2_INLINE 1
+%define HAVE_AVX512_INLINE 1
+%define HAVE_MMX_INLINE 0
+%define HAVE_MMXEXT_INLINE 1
+%define HAVE_SSE_INLINE 1
+%define HAVE_SSE2_INLINE 1
+%define HAVE_SSE3_INLINE 1
+%define HAVE_SSE4_INLINE 1
+%define HAVE_SSE42_INLINE 1
+%define HAVE_SSSE3_INLINE 1
+%define HAVE_CPUNOP_INLINE 1
+%define HAVE_I686_INLINE 1
+%if __BITS__ = 64
+%define HAVE_ALIGNED_STACK 1
+%elif __BITS__ = 32
+%define HAVE_ALIGNED_STACK 0
+%endif
+%if __BITS__ = 64
+%define HAVE_FAST_64BIT 1
+%elif __BITS__ = 32
+%define HAVE_FAST_64BIT 0
+%endif
+%define HAVE_FAST_CLZ 1
+%define HAVE_FAST_CMOV 1
+%define HAVE_LOCAL_ALIGNED 1
+%define HAVE_SIMD_ALIGN_16 1
+%define HAVE_SIMD_ALIGN_32 1
+%define HAVE_SIMD_ALIGN_64 1
+%define HAVE_ATOMICS_GCC 0
+%define HAVE_ATOMICS_SUNCC 0
+%define HAVE_ATOMICS_WIN32 1
+%define HAVE_ATOMIC_CAS_PTR 0
+%define HAVE_MACHINE_RW_BARRIER 0
+%define HAVE_MEMORYBARRIER 1
+%define HAVE_MM_EMPTY 1
+%define HAVE_RDTSC 1
+%define HAVE_SEM_TIMEDWAIT 0
+%define HAVE_SYNC_VAL_COMPARE_AND_SWAP 0
+%define HAVE_INLINE_ASM 0
+%define HAVE_SYMVER 0
+%define HAVE_X86ASM 1
+%define HAVE_BIGENDIAN 0
+%define HAVE_FAST_UNALIGNED 1
+%define HAVE_DIRECT_H 1
+%define HAVE_DXGIDEBUG_H 1
+%define HAVE_DXVA_H 1
+%define HAVE_IO_H 1
+%define HAVE_MALLOC_H 1
+%define HAVE_WINDOWS_H 1
+%define HAVE_CBRT 1
+%define HAVE_EXP2 1
+%define HAVE_LLRINT 1
+%define HAVE_LRINT 1
+%define HAVE_ROUND 1
+%define HAVE_TRUNC 1
+%define HAVE_ALIGNED_MALLOC 1
+%define HAVE_COMMANDLINETOARGVW 1
+%define HAVE_GETMODULEHANDLE 1
+%define HAVE_GETTIMEOFDAY 0
+%define HAVE_ISATTY 1
+%define HAVE_MKSTEMP 0
+%define HAVE_USLEEP 0
+%define HAVE_BCRYPT 1
+%define HAVE_VAAPI_DRM 0
+%define HAVE_PTHREADS 0
+%define HAVE_OS2THREADS 0
+%define HAVE_W32THREADS 1
+%define HAVE_AS_FUNC 0
+%define HAVE_INLINE_ASM_LABELS 1
+%define HAVE_PRAGMA_DEPRECATED 1
+%define HAVE_SYMVER_ASM_LABEL 0
+%define HAVE_DXVA_PICPARAMS_HEVC 0
+%define HAVE_ID3D11VIDEODECODER 0
+%define HAVE_KCMVIDEOCODECTYPE_HEVC 0
+%define HAVE_STRUCT_POLLFD 1
+%define HAVE_CLOCK_GETTIME 0
+%define HAVE_GCRYPT 0
+%define HAVE_LIBDRM 0
+%define HAVE_LIBSOXR 0
+%define HAVE_LIBDRM_GETFB2 0
+%define HAVE_MAKEINFO 0
+%define HAVE_PERL 0
+%define HAVE_POD2MAN 0
+%define HAVE_THREADS 1
+%define CONFIG_DOC 0
+%define CONFIG_HTMLPAGES 0
+%define CONFIG_DECODE_AUDIO_EXAMPLE 0
+%define CONFIG_ENCODE_VIDEO_EXAMPLE 0
+%define CONFIG_LIBX264 0
+%define CONFIG_LIBX265 0
+%define CONFIG_LIBXVID 0
+%define CONFIG_DECKLINK 0
+%define CONFIG_LIBFDK_AAC 0
+%define CONFIG_LIBOPENCORE_AMRNB 0
+%define CONFIG_LIBOPENCORE_AMRWB 0
+%define CONFIG_LIBSMBCLIENT 0
+%define CONFIG_GMP 0
+%define CONFIG_LIBASS 1
+%define CONFIG_LIBDAV1D 0
+%define CONFIG_LIBFREETYPE 1
+%define CONFIG_LIBMP3LAME 0
+%define CONFIG_LIBOPUS 0
+%define CONFIG_LIBVPX 0
+%define CONFIG_LIBXML2 0
+%define CONFIG_OPENSSL 0
+%define CONFIG_BZLIB 0
+%define CONFIG_ICONV 0
+%define CONFIG_LZMA 0
+%define CONFIG_SCHANNEL 0
+%define CONFIG_ZLIB 0
+%define CONFIG_LIBMFX 0
+%define CONFIG_OPENCL 0
+%define CONFIG_CUDA 0
+%define CONFIG_CUVID 0
+%define CONFIG_D3D11VA 0
+%define CONFIG_DXVA2 0
+%define CONFIG_FFNVCODEC 0
+%define CONFIG_NVDEC 0
+%define CONFIG_NVENC 0
+%define CONFIG_GRAY 0
+%define CONFIG_HARDCODED_TABLES 0
+%define CONFIG_OMX_RPI 0
+%define CONFIG_RUNTIME_CPUDETECT 1
+%define CONFIG_SAFE_BITSTREAM_READER 1
+%define CONFIG_SHARED 1
+%define CONFIG_SMALL 0
+%define CONFIG_STATIC 1
+%define CONFIG_SWSCALE_ALPHA 1
+%define CONFIG_GPL 0
+%define CONFIG_NONFREE 0
+%define CONFIG_VERSION3 0
+%define CONFIG_AVDEVICE 1
+%define CONFIG_AVFILTER 1
+%define CONFIG_SWSCALE 1
+%define CONFIG_POSTPROC 0
+%define CONFIG_AVFORMAT 1
+%define CONFIG_AVCODEC 1
+%define CONFIG_SWRESAMPLE 1
+%define CONFIG_AVUTIL 1
+%define CONFIG_FFPLAY 0
+%define CONFIG_FFPROBE 1
+%define CONFIG_FFMPEG 1
+%define CONFIG_DWT 1
+%define CONFIG_ERROR_RESILIENCE 1
+%define CONFIG_FAAN 1
+%define CONFIG_FAST_UNALIGNED 1
+%define CONFIG_IAMF 1
+%define CONFIG_LSP 1
+%define CONFIG_MDCT 1
+%define CONFIG_NETWORK 0
+%define CONFIG_PIXELUTILS 1
+%define CONFIG_RDFT 1
+%define CONFIG_FFT 1
+%define CONFIG_AUTODETECT 0
+%define CONFIG_FONTCONFIG 0
+%define CONFIG_MEMORY_POISONING 0
+%define CONFIG_PIC 0
+%define CONFIG_BSFS 1
+%define CONFIG_DECODERS 1
+%define CONFIG_ENCODERS 1
+%define CONFIG_HWACCELS 1
+%define CONFIG_PARSERS 1
+%define CONFIG_INDEVS 1
+%define CONFIG_OUTDEVS 1
+%define CONFIG_FILTERS 1
+%define CONFIG_DEMUXERS 1
+%define CONFIG_MUXERS 1
+%define CONFIG_PROTOCOLS 1
+%define CONFIG_ADTS_HEADER 1
+%define CONFIG_AFORMAT_FILTER 1
+%define CONFIG_ANULL_FILTER 1
+%define CONFIG_ATRIM_FILTER 1
+%define CONFIG_AUDIO_FRAME_QUEUE 1
+%define CONFIG_BMP_DECODER 1
+%define CONFIG_BSWAPDSP 1
+%define CONFIG_H263_DECODER 1
+%define CONFIG_H263_ENCODER 1
+%define CONFIG_H264QPEL 1
+%define CONFIG_HFLIP_FILTER 1
+%define CONFIG_IIRFILTER 1
+%define CONFIG_ISO_MEDIA 1
+%define CONFIG_LPC 1
+%define CONFIG_ME_CMP 1
+%define CONFIG_MPEGAUDIO_PARSER 1
+%define CONFIG_RIFFDEC 1
+%define CONFIG_RIFFENC 1
+%define CONFIG_RTPENC_CHAIN 1
+%define CONFIG_SINEWIN 1
+%define CONFIG_TRANSPOSE_FILTER 1
+%define CONFIG_TRIM_FILTER 1
+%define CONFIG_VFLIP_FILTER 1
+%define CONFIG_VP9_PARSER 1
+%define CONFIG_VP9_SUPERFRAME_BSF 1
+%define CONFIG_VP9_SUPERFRAME_SPLIT_BSF 1
+%define CONFIG_MPEGAUDIOHEADER 0
+%define CONFIG_ATSC_A53 0
+%define CONFIG_CROP_FILTER 0
+%define CONFIG_ROTATE_FILTER 0
+%define CONFIG_AANDCTTABLES 0
+%define CONFIG_BLOCKDSP 0
+%define CONFIG_CABAC 1
+%define CONFIG_GOLOMB 1
+%define CONFIG_H264CHROMA 1
+%define CONFIG_H264DSP 1
+%define CONFIG_H264PARSE 1
+%define CONFIG_H264PRED 1
+%define CONFIG_HEVCPARSE 1
+%define CONFIG_MPEG4AUDIO 1
+%define CONFIG_MPEGAUDIO 1
+%define CONFIG_MPEGVIDEO 0
+%define CONFIG_MPEGVIDEODEC 0
+%define CONFIG_MPEGVIDEOENC 1
+%define CONFIG_QSV 0
+%define CONFIG_QSVENC 0
+%define CONFIG_VIDEODSP 1
+%define CONFIG_VP9DSP 1
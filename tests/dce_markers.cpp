@@ -0,0 +1,194 @@
+/*
+ * copyright (c) 2017 Matthew Oliver
+ *
+ * This file is part of ShiftMediaProject.
+ *
+ * ShiftMediaProject is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * ShiftMediaProject is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with ShiftMediaProject; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+// The DCE scanning functions are internal to this file so it is included directly (and must not also be linked)
+#include "../source/projectGenerator_dce.cpp"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+/**
+ * Finds every DCE condition within a file by searching for each tag and type of condition in turn (as done before
+ * findDCEConditions).
+ * @param       file       The file to search.
+ * @param [out] conditions The position of each found condition grouped in the same way as findDCEConditions.
+ */
+static void oldFindDCEConditions(const string& file, vector<vector<size_t>>& conditions)
+{
+    const string tags2[] = {"if (", "if(", "if ((", "if(("};
+    conditions.assign(g_numTagsDCE * g_numConditionsDCE, vector<size_t>());
+    for (size_t i = 0; i < g_numTagsDCE; ++i) {
+        for (size_t j = 0; j < g_numConditionsDCE; j++) {
+            const string search = tags2[j] + g_tagsDCE[i];
+            size_t findPos = file.find(search);
+            while (findPos != string::npos) {
+                conditions[i * g_numConditionsDCE + j].push_back(findPos);
+                findPos = file.find(search, findPos + 1);
+            }
+        }
+    }
+}
+
+/**
+ * Inserts DCE markers using a search and replace pass for each tag (as done before insertDCEMarkers).
+ * @param [in,out] file The file to update.
+ */
+static void oldInsertDCEMarkers(string& file)
+{
+    const string tags2[] = {"if (", "if(", "& ", "&", "| ", "|"};
+    for (const auto& j : g_tagsDCE) {
+        for (const auto& k : tags2) {
+            const string search = k + j;
+            size_t findPos = 0;
+            const string replace = k + "XXX" + j;
+            while ((findPos = file.find(search, findPos)) != string::npos) {
+                file.replace(findPos, search.length(), replace);
+                findPos += replace.length() + 1;
+            }
+        }
+    }
+}
+
+/**
+ * Removes DCE markers using a search and replace pass for each tag (as done before removeDCEMarkers).
+ * @param [in,out] file The file to update.
+ */
+static void oldRemoveDCEMarkers(string& file)
+{
+    const string tags2[] = {"if (", "if(", "& ", "&", "| ", "|"};
+    for (const auto& j : g_tagsDCE) {
+        for (const auto& k : tags2) {
+            const string search = k + j;
+            size_t findPos = 0;
+            const string find = k + "XXX" + j;
+            while ((findPos = file.find(find, findPos)) != string::npos) {
+                file.replace(findPos, find.length(), search);
+                findPos += search.length() + 1;
+            }
+        }
+    }
+}
+
+/**
+ * Builds a random file from fragments of DCE conditions.
+ * @param          length    The approximate length of the file.
+ * @param          markers   True to also include existing markers.
+ * @param [in,out] generator The random number generator.
+ * @return The file.
+ */
+static string buildRandomFile(const size_t length, const bool markers, mt19937& generator)
+{
+    // Tags are always followed by a name as they are in real source files
+    const string fragments[] = {"if", " ", "(", "((", ")", "&", "&&", "|", "||", "!", "i", "f", "\n", "_", "ONFIG_",
+        "CONFIG_A", "HAVE_B1", "ARCH_X86", "EXTERNAL_SSE", "INTERNAL_AVX", "INLINE_MMX", "XXX"};
+    const size_t numFragments = sizeof(fragments) / sizeof(string) - ((markers) ? 0 : 1);
+    uniform_int_distribution<size_t> distribution(0, numFragments - 1);
+    string file;
+    while (file.length() < length) {
+        file += fragments[distribution(generator)];
+    }
+    return file;
+}
+
+/**
+ * Checks a test condition and outputs an error if it fails.
+ * @param condition The condition.
+ * @param test      The name of the test.
+ * @param file      The file that was tested.
+ * @return The value of the condition.
+ */
+static bool check(const bool condition, const string& test, const string& file)
+{
+    if (!condition) {
+        outputError(test + " failed for input (" + file + ")");
+    }
+    return condition;
+}
+
+/**
+ * Compares the single pass DCE scanning against the previous search and replace passes.
+ * @remark Usage: dce_markers [number of random files].
+ */
+int main(const int argc, char** argv)
+{
+    const size_t numFiles = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 20000;
+    bool ret = true;
+    mt19937 generator(12345);
+    for (size_t i = 0; (i < numFiles) && ret; ++i) {
+        const string file = buildRandomFile(1 + (i % 200), true, generator);
+        vector<vector<size_t>> conditions, oldConditions;
+        findDCEConditions(file, conditions);
+        oldFindDCEConditions(file, oldConditions);
+        ret = check(conditions == oldConditions, "Finding conditions", file) && ret;
+
+        string inserted = file, oldInserted = file;
+        insertDCEMarkers(inserted);
+        oldInsertDCEMarkers(oldInserted);
+        ret = check(inserted == oldInserted, "Inserting markers", file) && ret;
+
+        string removed = file, oldRemoved = file;
+        removeDCEMarkers(removed);
+        oldRemoveDCEMarkers(oldRemoved);
+        ret = check(removed == oldRemoved, "Removing markers", file) && ret;
+
+        // Any file without existing markers must be unchanged once its inserted markers are removed
+        string roundTrip = buildRandomFile(1 + (i % 200), false, generator);
+        const string original = roundTrip;
+        insertDCEMarkers(roundTrip);
+        removeDCEMarkers(roundTrip);
+        ret = check(roundTrip == original, "Restoring markers", original) && ret;
+    }
+
+    // The previous passes skipped a tag that starts directly after a replaced tag. This can only happen when a tag is
+    // not followed by a name but both are now marked.
+    string adjacent = "a &CONFIG_&CONFIG_B";
+    insertDCEMarkers(adjacent);
+    ret = check(adjacent == "a &XXXCONFIG_&XXXCONFIG_B", "Inserting adjacent markers", "a &CONFIG_&CONFIG_B") && ret;
+    string oldAdjacent = "a &CONFIG_&CONFIG_B";
+    oldInsertDCEMarkers(oldAdjacent);
+    ret = check(oldAdjacent == "a &XXXCONFIG_&CONFIG_B", "Previous adjacent markers", "a &CONFIG_&CONFIG_B") && ret;
+    removeDCEMarkers(adjacent);
+    ret = check(adjacent == "a &CONFIG_&CONFIG_B", "Removing adjacent markers", "a &XXXCONFIG_&XXXCONFIG_B") && ret;
+    if (!ret) {
+        return 1;
+    }
+    printf("Compared %zu random files\n", numFiles);
+
+    // Time both versions on a single large file
+    const string large = buildRandomFile(1024 * 1024, false, generator);
+    const auto start = chrono::steady_clock::now();
+    vector<vector<size_t>> conditions;
+    findDCEConditions(large, conditions);
+    string file = large;
+    insertDCEMarkers(file);
+    removeDCEMarkers(file);
+    const auto end = chrono::steady_clock::now();
+    oldFindDCEConditions(large, conditions);
+    file = large;
+    oldInsertDCEMarkers(file);
+    oldRemoveDCEMarkers(file);
+    const auto oldEnd = chrono::steady_clock::now();
+    printf("Scanning 1MiB (single pass):     %lld ms\n",
+        static_cast<long long>(chrono::duration_cast<chrono::milliseconds>(end - start).count()));
+    printf("Scanning 1MiB (previous passes): %lld ms\n",
+        static_cast<long long>(chrono::duration_cast<chrono::milliseconds>(oldEnd - end).count()));
+    return 0;
+}
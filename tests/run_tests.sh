@@ -0,0 +1,99 @@
+#!/bin/sh
+#
+# Builds the generator sources with the host compiler and runs each test against the reduced configure found in
+# tests/data. Usage: tests/run_tests.sh [build directory]
+#
+
+set -e
+
+TESTDIR=$(cd "$(dirname "$0")" && pwd)
+ROOTDIR=$(dirname "$TESTDIR")
+BUILDDIR=${1:-"$ROOTDIR/_test_build"}
+CXX=${CXX:-g++}
+CXXFLAGS=${CXXFLAGS:-"-std=c++17 -O2 -Wall"}
+
+mkdir -p "$BUILDDIR/templates"
+
+# Embed the templates in the same way as the Windows resource file
+embed_template(){
+    cp "$ROOTDIR/templates/$1" "$BUILDDIR/templates/$2"
+    (cd "$BUILDDIR/templates" && ld -r -b binary -o "$2.o" "$2")
+}
+embed_template template_with_latest_sdk.bat template_bat
+embed_template template_files.props template_file_props
+embed_template templateprogram_in.vcxproj template_program_vcxproj
+embed_template templateprogram_in.vcxproj.filters template_program_vcxproj_filters
+embed_template smp_deps.props template_props
+embed_template smp_winrt_deps.props template_props_winrt
+embed_template template_in.sln template_sln_nowinrt
+embed_template template_in_winrt.sln template_sln_winrt
+embed_template template_in.vcxproj template_vcxproj
+embed_template template_in.vcxproj.filters template_vcxproj_filters
+embed_template template_in_winrt.vcxproj template_vcxproj_winrt
+
+# Build every source file except the one containing main
+OBJECTS=""
+for SOURCE in "$ROOTDIR"/source/*.cpp; do
+    NAME=$(basename "$SOURCE" .cpp)
+    if [ "$NAME" != "project_generate" ]; then
+        $CXX $CXXFLAGS -I"$ROOTDIR/include" -c "$SOURCE" -o "$BUILDDIR/$NAME.o"
+        OBJECTS="$OBJECTS $BUILDDIR/$NAME.o"
+    fi
+done
+OBJECTS="$OBJECTS $BUILDDIR/templates/*.o"
+
+build_test(){
+    $CXX $CXXFLAGS -I"$ROOTDIR/include" "$TESTDIR/$1.cpp" $OBJECTS -lpthread -o "$BUILDDIR/$1"
+}
+
+# Tests that include a source file directly (to reach its internal functions) must not also link its object
+build_test_including(){
+    TEST_OBJECTS=""
+    for OBJECT in $OBJECTS; do
+        if [ "$OBJECT" != "$BUILDDIR/$2.o" ]; then
+            TEST_OBJECTS="$TEST_OBJECTS $OBJECT"
+        fi
+    done
+    $CXX $CXXFLAGS -I"$ROOTDIR/include" "$TESTDIR/$1.cpp" $TEST_OBJECTS -lpthread -o "$BUILDDIR/$1"
+}
+
+FAILED=0
+
+# Allocations made while resolving config values
+build_test config_allocations
+rm -rf "$BUILDDIR/config_allocations_out"
+if ! "$BUILDDIR/config_allocations" --rootdir="$TESTDIR/data/ffmpeg" --projdir="$BUILDDIR/config_allocations_out" \
+    --enable-gpl --enable-nonfree --quiet; then
+    echo "config_allocations: FAILED"
+    FAILED=1
+fi
+
+# Generated config files compared against those output by the original generator. Each set is run twice so that the
+# second run resolves its values from the config snapshot written by the first.
+build_test config_outputs
+check_config_outputs(){
+    NAME=$1
+    shift
+    rm -rf "$BUILDDIR/config_outputs_out/$NAME"
+    for RUN in 1 2; do
+        if ! (cd "$BUILDDIR" && ./config_outputs "$TESTDIR/data/expected/$NAME" --rootdir="$TESTDIR/data/ffmpeg" \
+            --projdir="config_outputs_out/$NAME" "$@" --quiet); then
+            echo "config_outputs $NAME (run $RUN): FAILED"
+            FAILED=1
+        fi
+    done
+}
+check_config_outputs gpl_nonfree --enable-gpl --enable-nonfree
+check_config_outputs decoder_h264 --enable-gpl --enable-version3 --disable-decoders --enable-decoder=h264
+check_config_outputs libx264_yasm --disable-everything --enable-libx264 --enable-gpl --use-yasm
+check_config_outputs small_no_network --disable-autodetect --enable-libass --enable-libfreetype --disable-network \
+    --enable-small
+
+# Single pass DCE condition and marker scanning compared against the previous search and replace passes
+build_test_including dce_markers projectGenerator_dce
+if ! "$BUILDDIR/dce_markers"; then
+    echo "dce_markers: FAILED"
+    FAILED=1
+fi
+
+exit $FAILED